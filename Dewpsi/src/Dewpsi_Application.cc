@@ -6,6 +6,7 @@
 #include "Dewpsi_Except.h"
 #include "Dewpsi_String.h"
 #include "Dewpsi_Renderer.h"
+#include "Dewpsi_RenderThread.h"
 #include "Dewpsi_Vector.h"
 
 // These includes are just to get make to update them
@@ -28,7 +29,7 @@ static WindowProps _WindowProperties;
 Application* Application::s_instance = nullptr;
 
 Application::Application(const std::string& sName)
-    : m_bRunning(true), m_window(), m_guiLayer(), m_fLastFrameTime(0.0f),
+    : m_bRunning(true), m_bRenderThread(false), m_window(), m_guiLayer(), m_fLastFrameTime(0.0f),
       m_UserData(nullptr)
 {
     if (! Log::IsInit())
@@ -46,13 +47,18 @@ Application::Application(const std::string& sName)
     // set the clear color
     RenderCommand::SetClearColor(DefineColor(127, 127, 127));
 
-    // push ImGui layer
-    m_guiLayer = new ImGuiLayer(m_UserData);
-    PushOverlay(m_guiLayer);
+    // push ImGui layer; only OpenGL has a context for ImGui to render with
+    if (Renderer::GetAPI() == RendererAPI::API::OpenGL)
+    {
+        m_guiLayer = new ImGuiLayer(m_UserData);
+        PushOverlay(m_guiLayer);
+    }
 }
 
 Application::~Application()
 {
+    RenderThread::Stop();
+    Renderer::Shutdown();
     SDL_Quit();
 }
 
@@ -83,6 +89,9 @@ void Application::PushOverlay(Layer* overlay)
 
 void Application::Run()
 {
+    if (m_bRenderThread)
+        RenderThread::Start(m_window->GetContext());
+
     while (m_bRunning)
     {
         float fTime = Platform::GetTime();
@@ -90,6 +99,7 @@ void Application::Run()
         m_fLastFrameTime = fTime;
 
         // clear buffers
+        RenderCommand::BeginFrame();
         RenderCommand::Clear();
 
         // update each layer
@@ -97,14 +107,27 @@ void Application::Run()
             (*itr)->OnUpdate(delta);
 
         // render ImGui on all the layers
-        m_guiLayer->Begin();
-        for (auto itr = m_layerStack.begin(); itr != m_layerStack.end(); ++itr)
-            (*itr)->OnImGuiRender();
-        m_guiLayer->End();
+        if (m_guiLayer)
+        {
+            m_guiLayer->Begin();
+            for (auto itr = m_layerStack.begin(); itr != m_layerStack.end(); ++itr)
+                (*itr)->OnImGuiRender();
+            m_guiLayer->End();
+        }
 
         // update the window
-        m_window->OnUpdate();
+        if (RenderThread::IsRunning())
+        {
+            // The render thread presents this frame while events are polled for the next one
+            RenderThread::Enqueue([&context = m_window->GetContext()]{ context.SwapBuffers(); });
+            RenderThread::EndFrame();
+            m_window->PollEvents();
+        }
+        else
+            m_window->OnUpdate();
     }
+
+    RenderThread::Stop();
 }
 
 bool Application::OnWindowClosed(WindowCloseEvent& e)
@@ -154,6 +154,21 @@ namespace Dewpsi {
         Window& GetWindow()
         { return *m_window; }
 
+        /// Returns the ImGui layer, or NULL if the rendering API cannot draw ImGui.
+        ImGuiLayer* GetImGuiLayer()
+        { return m_guiLayer; }
+
+        /** Renders each frame on a dedicated thread while the next one is simulated.
+        *   Takes effect when the main loop starts, so it is meant to be called from the
+        *   constructor of the derived class. See RenderThread for what layers may do in this mode.
+        */
+        void SetRenderThread(bool bEnable)
+        { m_bRenderThread = bEnable; }
+
+        /// Returns true if frames are rendered on a dedicated thread.
+        bool IsRenderThreadEnabled() const
+        { return m_bRenderThread; }
+
         /// Returns a pointer to the application.
         static Application& Get()
         { return *s_instance; }
@@ -161,6 +176,7 @@ namespace Dewpsi {
     private:
         static Application* s_instance;
         bool m_bRunning;
+        bool m_bRenderThread;
         LayerStack m_layerStack;
         float m_fLastFrameTime;
 
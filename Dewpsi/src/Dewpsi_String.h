@@ -108,6 +108,24 @@ namespace Dewpsi {
             return ::std::strlen(str);
         }
 
+        /** Computes the 32-bit FNV-1a hash of a string.
+        *   The function is @c constexpr, so the hash of a literal can be computed at compile time.
+        *   @param  str A string, must not be @c NULL
+        *   @param  len The number of characters of @a str to hash
+        *   @return     The hash of the first @a len characters of @a str
+        *   @ingroup    strings
+        */
+        constexpr PDuint32 Hash(const char* str, size_t len)
+        {
+            PDuint32 hash = 2166136261u;
+            for (size_t i = 0; i < len; ++i)
+            {
+                hash ^= static_cast<PDuchar>(str[i]);
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
         /** Parses the C-string @a str, interpreting it as an integer.
         *   @param  str A C-string with the characters to be interpreted as digits. Depending
         *               on the first two characters, the string can be interpreted in one of three
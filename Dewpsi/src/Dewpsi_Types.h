@@ -67,6 +67,9 @@ typedef unsigned short PDushort;
 /// An unsigned character
 typedef unsigned char PDuchar;
 
+/// An unsigned 64 bit integer
+typedef uint64_t PDuint64;
+
 /// An unsigned 32 bit integer
 typedef uint32_t PDuint32;
 
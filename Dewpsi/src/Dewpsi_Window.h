@@ -37,6 +37,8 @@
 //extern void (PD_APIENTRY * SetViewport)(int, int, int, int);
 
 namespace Dewpsi {
+    class RenderContext;
+
     /**
     *   @addtogroup windows
     *   @{
@@ -166,9 +168,15 @@ namespace Dewpsi {
         // Destroys the window.
         virtual ~Window() = default;
 
-        /// Update the window.
+        /// Update the window: polls events, then presents the frame.
         virtual void OnUpdate() = 0;
 
+        /// Polls and dispatches pending events; must be called on the thread that created the window.
+        virtual void PollEvents() = 0;
+
+        /// Returns the rendering context of the window.
+        virtual RenderContext& GetContext() = 0;
+
         /// Returns true if the window is valid, false otherwise.
         virtual bool IsValid() const = 0;
 
@@ -7,13 +7,46 @@
 #include "Dewpsi_Platform.h"
 #include "Dewpsi_Except.h"
 #include "Dewpsi_Input.h"
+#include "Dewpsi_Renderer.h"
+#include "Dewpsi_RenderThread.h"
+#include <vector>
 #define _PD_DEBUG_BREAKS
 #include "Dewpsi_Debug.h" // TODO: delete
 
 namespace Dewpsi {
 
+// Copy of the draw data of a frame; the render thread draws it while the next frame is built
+struct DrawDataCopy {
+    ImDrawData data;
+    std::vector<ImDrawList*> lists;
+
+    explicit DrawDataCopy(const ImDrawData* source) : data(*source)
+    {
+        lists.reserve((PDsizei) source->CmdListsCount);
+        for (int i = 0; i < source->CmdListsCount; ++i)
+            lists.push_back(source->CmdLists[i]->CloneOutput());
+        data.CmdLists = lists.data();
+    }
+
+    ~DrawDataCopy()
+    {
+        for (ImDrawList* list : lists)
+            IM_DELETE(list);
+    }
+
+    DrawDataCopy(const DrawDataCopy&) = delete;
+    DrawDataCopy& operator=(const DrawDataCopy&) = delete;
+};
+
+static void RenderDrawData(ImDrawData* data)
+{
+    RenderCommand::BeginPass("ImGui");
+    ImGui_ImplOpenGL3_RenderDrawData(data);
+    RenderCommand::EndPass();
+}
+
 ImGuiLayer::ImGuiLayer(const void* data) : Layer("ImGuiLayer"), m_vpData(data),
-    m_Window(nullptr), m_Context(nullptr), m_Init(false)
+    m_Window(nullptr), m_Context(nullptr), m_Init(false), m_ShowStats(false)
 {
     if (! data)
         PD_CORE_WARN("ImGuiLayer: user data is NULL");
@@ -75,7 +108,10 @@ void ImGuiLayer::OnAttach()
     else
         ImGui_ImplOpenGL3_Init(nullptr);
 
-        m_Init = true;
+    // Built while the context is current here, so the font atlas is ready before a render thread starts
+    ImGui_ImplOpenGL3_CreateDeviceObjects();
+
+    m_Init = true;
 }
 
 void ImGuiLayer::OnDetach()
@@ -88,8 +124,12 @@ void ImGuiLayer::OnDetach()
 
 void ImGuiLayer::Begin()
 {
+    // Platform windows would each need the context on this thread
+    if (RenderThread::IsRecording())
+        ImGui::GetIO().ConfigFlags &= ~ImGuiConfigFlags_ViewportsEnable;
+
     // Start the Dear ImGui frame
-    ImGui_ImplOpenGL3_NewFrame();
+    RenderThread::Enqueue([]{ ImGui_ImplOpenGL3_NewFrame(); });
     ImGui_ImplSDL2_NewFrame(m_Window);
     ImGui::NewFrame();
 }
@@ -104,9 +144,20 @@ void ImGuiLayer::End()
         io.DisplaySize = ImVec2((float) win.GetWidth(), (float) win.GetHeight());
     }
 
+    if (m_ShowStats)
+        DrawStats(&m_ShowStats);
+
     // Rendering
     ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    if (RenderThread::IsRecording())
+    {
+        // The draw lists are rebuilt by the next frame before the render thread gets to them
+        RenderThread::Enqueue([frame = CreateScope<DrawDataCopy>(ImGui::GetDrawData())]{
+            RenderDrawData(&frame->data);
+        });
+    }
+    else
+        RenderDrawData(ImGui::GetDrawData());
 
     // Update and Render additional Platform Windows
     // (Platform functions may change the current OpenGL context, so we save/restore it to make it easier to paste this code elsewhere.
@@ -121,4 +172,24 @@ void ImGuiLayer::End()
     }
 }
 
+void ImGuiLayer::DrawStats(bool* open)
+{
+    const Renderer::Stats& stats = Renderer::GetStats();
+    if (ImGui::Begin("Renderer", open))
+    {
+        ImGui::Text("Draw calls:    %u", stats.drawCalls);
+        ImGui::Text("Instances:     %u", stats.instances);
+        ImGui::Text("Indices:       %llu", (PDullong) stats.indices);
+        ImGui::Text("Triangles:     %llu", (PDullong) stats.triangles);
+        ImGui::Text("Lines:         %llu", (PDullong) stats.lines);
+        ImGui::Text("State changes: %u (%u elided)", stats.stateChanges, stats.stateChangesElided);
+
+        ImGui::Separator();
+        ImGui::Text("GPU time:      %.3f ms", stats.gpuMilliseconds);
+        for (const RendererAPI::PassTiming& pass : stats.passes)
+            ImGui::BulletText("%s: %.3f ms", pass.name.c_str(), pass.milliseconds);
+    }
+    ImGui::End();
+}
+
 }
@@ -41,11 +41,24 @@ namespace Dewpsi {
         /// End an ImGui frame.
         void End();
 
+        /// Shows or hides the panel with the statistics of Renderer::GetStats().
+        void ShowStats(bool show) {m_ShowStats = show;}
+
+        /// Returns true if the statistics panel is shown.
+        bool IsShowingStats() const {return m_ShowStats;}
+
+        /** Draws the renderer statistics into a window titled "Renderer".
+        *   End() draws it when it is shown; it can also be called from any OnImGuiRender().
+        *   @param open  Set to false when the window is closed, may be NULL
+        */
+        static void DrawStats(bool* open = nullptr);
+
     private:
         const void* m_vpData;
         SDL_Window* m_Window;
         SDL_GLContext m_Context;
         bool m_Init;
+        bool m_ShowStats;
     };
 }
 
@@ -0,0 +1,175 @@
+#include "Dewpsi_AssetRegistry.h"
+#include "Dewpsi_Log.h"
+#include "Dewpsi_RenderThread.h"
+
+#include <algorithm>
+#include <filesystem>
+
+namespace Dewpsi {
+
+// Textures with other properties are different textures, so the properties are part of the key
+static PDstring MakeTextureKey(const PDstring& path, const TextureProperties& props)
+{
+    PDstring key = path;
+    key += '|';
+    key += (char) ('0' + (int) props.mipmaps);
+    key += (char) ('0' + (int) props.minFilter);
+    key += (char) ('0' + (int) props.magFilter);
+    return key;
+}
+
+AssetRegistry::AssetRegistry(PDsizei textureBudget)
+    : m_TextureBudget(textureBudget), m_Clock(0), m_Hits(0), m_Misses(0), m_Evictions(0)
+{
+}
+
+AssetRegistry::~AssetRegistry()
+{
+    Clear();
+}
+
+PDstring AssetRegistry::NormalizePath(const PDstring& file)
+{
+    // Resolves symbolic links and relative paths of files that exist; the rest is only cleaned up
+    std::error_code error;
+    std::filesystem::path path = std::filesystem::weakly_canonical(file, error);
+    if (error)
+        path = std::filesystem::path(file).lexically_normal();
+    return path.generic_string();
+}
+
+Ref<Texture2D> AssetRegistry::FindTexture(const PDstring& key)
+{
+    auto found = m_Textures.find(key);
+    if (found == m_Textures.end())
+        return nullptr;
+
+    // A failed asynchronous load is forgotten, so the file is read again
+    if (found->second.texture->IsError())
+    {
+        RenderThread::Release(found->second.texture);
+        m_Textures.erase(found);
+        return nullptr;
+    }
+
+    found->second.lastUse = ++m_Clock;
+    ++m_Hits;
+    return found->second.texture;
+}
+
+Ref<Texture2D> AssetRegistry::LoadTexture(const PDstring& file, const TextureProperties& props)
+{
+    const PDstring key = MakeTextureKey(NormalizePath(file), props);
+    if (Ref<Texture2D> texture = FindTexture(key))
+        return texture;
+
+    ++m_Misses;
+    Ref<Texture2D> texture = Texture2D::Create(file, props);
+    if (texture->IsError())
+        return texture;
+
+    m_Textures[key] = {texture, ++m_Clock};
+    Trim();
+    return texture;
+}
+
+Ref<Texture2D> AssetRegistry::LoadTextureAsync(const PDstring& file, const TextureProperties& props)
+{
+    const PDstring key = MakeTextureKey(NormalizePath(file), props);
+    if (Ref<Texture2D> texture = FindTexture(key))
+        return texture;
+
+    ++m_Misses;
+    Ref<Texture2D> texture = Texture2D::CreateAsync(file, props);
+    m_Textures[key] = {texture, ++m_Clock};
+    Trim();
+    return texture;
+}
+
+Ref<Shader> AssetRegistry::LoadShader(const PDstring& file, bool deferred)
+{
+    const PDstring key = NormalizePath(file);
+    auto found = m_Shaders.find(key);
+    if (found != m_Shaders.end())
+    {
+        ++m_Hits;
+        return found->second;
+    }
+
+    ++m_Misses;
+    Ref<Shader> shader = Shader::Create(file, deferred);
+    m_Shaders[key] = shader;
+    return shader;
+}
+
+void AssetRegistry::SetTextureBudget(PDsizei bytes)
+{
+    m_TextureBudget = bytes;
+    Trim();
+}
+
+PDsizei AssetRegistry::GetTextureMemory() const
+{
+    // Asynchronously loaded textures grow once loaded, so sizes are not cached
+    PDsizei szTotal = 0;
+    for (const auto& pair : m_Textures)
+        szTotal += pair.second.texture->GetMemorySize();
+    return szTotal;
+}
+
+void AssetRegistry::Trim()
+{
+    PDsizei szTotal = GetTextureMemory();
+    if (szTotal <= m_TextureBudget)
+        return;
+
+    // Only the registry holds these
+    std::vector<decltype(m_Textures)::iterator> candidates;
+    for (auto it = m_Textures.begin(); it != m_Textures.end(); ++it)
+    {
+        if (it->second.texture.use_count() == 1)
+            candidates.push_back(it);
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+        return a->second.lastUse < b->second.lastUse;
+    });
+
+    for (auto it : candidates)
+    {
+        if (szTotal <= m_TextureBudget)
+            break;
+
+        szTotal -= it->second.texture->GetMemorySize();
+        RenderThread::Release(it->second.texture);
+        m_Textures.erase(it);
+        ++m_Evictions;
+    }
+
+    if (szTotal > m_TextureBudget)
+        PD_CORE_TRACE("Textures in use take {0} bytes, over the budget of {1}", szTotal, m_TextureBudget);
+}
+
+void AssetRegistry::Clear()
+{
+    for (auto& pair : m_Textures)
+        RenderThread::Release(pair.second.texture);
+    for (auto& pair : m_Shaders)
+        RenderThread::Release(pair.second);
+    m_Textures.clear();
+    m_Shaders.clear();
+}
+
+AssetRegistry::Statistics AssetRegistry::GetStats() const
+{
+    Statistics stats;
+    stats.textures = m_Textures.size();
+    stats.shaders = m_Shaders.size();
+    stats.textureBytes = GetTextureMemory();
+    stats.hits = m_Hits;
+    stats.misses = m_Misses;
+    stats.evictions = m_Evictions;
+    return stats;
+}
+
+}
@@ -0,0 +1,108 @@
+#ifndef DEWPSI_ASSETREGISTRY_H
+#define DEWPSI_ASSETREGISTRY_H
+
+/** @file Dewpsi_AssetRegistry.h
+*   @ref core_renderer
+*/
+
+#include <Dewpsi_Texture.h>
+#include <Dewpsi_Shader.h>
+#include <unordered_map>
+
+namespace Dewpsi {
+    /** Loads every file at most once.
+    *   Assets are keyed by their normalized path, so "assets/./a.png" and "assets/a.png"
+    *   share a single texture. Loading an asset that is already registered returns the
+    *   existing handle.
+    *
+    *   The registry keeps its own reference to every asset, so an asset stays cached after
+    *   the application drops its handles. Once the textures take more memory than the
+    *   budget, the registry forgets the least recently requested textures that nobody else
+    *   references until it is within budget again. Textures in use are never evicted, so
+    *   the budget can be exceeded. Shaders are small and are not counted or evicted.
+    *
+    *   @code{.cpp}
+        Dewpsi::AssetRegistry assets(64 * 1024 * 1024);
+        auto grass = assets.LoadTexture("assets/images/grass.png");
+        auto same = assets.LoadTexture("./assets/images/grass.png"); // same == grass
+    *   @endcode
+    *   @ingroup core_renderer
+    */
+    class AssetRegistry {
+    public:
+        /// Counters of the registry.
+        struct Statistics {
+            PDsizei textures;       ///< Number of registered textures
+            PDsizei shaders;        ///< Number of registered shaders
+            PDsizei textureBytes;   ///< Estimated memory of the registered textures
+            PDuint32 hits;          ///< Loads served from the registry
+            PDuint32 misses;        ///< Loads that read a file
+            PDuint32 evictions;     ///< Textures evicted to stay within the budget
+        };
+
+        /// Creates an empty registry with the given texture memory budget in bytes.
+        explicit AssetRegistry(PDsizei textureBudget = 256 * 1024 * 1024);
+
+        /// Forgets every asset, like Clear().
+        ~AssetRegistry();
+
+        /** Returns the texture in @a file, loading it if it is not registered yet.
+        *   The same file loaded with different properties is a different texture.
+        *   Files that fail to load are not registered.
+        */
+        Ref<Texture2D> LoadTexture(const PDstring& file, const TextureProperties& props = {});
+
+        /** Returns the texture in @a file, loading it with Texture2D::CreateAsync() if it is not
+        *   registered yet. The texture is only counted at its full size once it is loaded.
+        *   If the load fails, the texture stays registered until the file is requested again;
+        *   that request loads it anew, so a file that appears later is picked up.
+        */
+        Ref<Texture2D> LoadTextureAsync(const PDstring& file, const TextureProperties& props = {});
+
+        /// Returns the shader in @a file, loading it if it is not registered yet.
+        Ref<Shader> LoadShader(const PDstring& file, bool deferred = false);
+
+        /// Sets the texture memory budget in bytes and evicts textures if it is exceeded.
+        void SetTextureBudget(PDsizei bytes);
+
+        /// Returns the texture memory budget in bytes.
+        PDsizei GetTextureBudget() const {return m_TextureBudget;}
+
+        /// Returns the estimated memory taken by the registered textures.
+        PDsizei GetTextureMemory() const;
+
+        /** Evicts unreferenced textures, least recently requested first, until the textures fit
+        *   into the budget. Called after every texture load.
+        */
+        void Trim();
+
+        /** Forgets every asset; handles held by the application stay valid.
+        *   Assets that are no longer held are destroyed on the render thread.
+        */
+        void Clear();
+
+        /// Returns the counters of the registry.
+        Statistics GetStats() const;
+
+        /// Returns the key @a file is registered under.
+        static PDstring NormalizePath(const PDstring& file);
+
+    private:
+        struct TextureEntry {
+            Ref<Texture2D> texture;
+            PDuint64 lastUse;
+        };
+
+        Ref<Texture2D> FindTexture(const PDstring& key);
+
+        std::unordered_map<PDstring, TextureEntry> m_Textures;
+        std::unordered_map<PDstring, Ref<Shader>> m_Shaders;
+        PDsizei m_TextureBudget;
+        PDuint64 m_Clock;
+        PDuint32 m_Hits;
+        PDuint32 m_Misses;
+        PDuint32 m_Evictions;
+    };
+}
+
+#endif /* DEWPSI_ASSETREGISTRY_H */
@@ -37,6 +37,13 @@ uint32_t ShaderDataTypeSize(ShaderDataType type)
             return INT_DATA(4);
         case ShaderDataType::Bool:
             return 1;
+        case ShaderDataType::UByte4Norm:
+        case ShaderDataType::Short2Norm:
+        case ShaderDataType::Half2:
+        case ShaderDataType::UInt10_10_10_2:
+            return 4;
+        case ShaderDataType::Half4:
+            return 8;
         default:
             break;
     }
@@ -71,6 +78,13 @@ PDuint32 BufferElement::GetComponentCount() const
             return 4;
         case ShaderDataType::Bool:
             return 1;
+        case ShaderDataType::Short2Norm:
+        case ShaderDataType::Half2:
+            return 2;
+        case ShaderDataType::UByte4Norm:
+        case ShaderDataType::Half4:
+        case ShaderDataType::UInt10_10_10_2:
+            return 4;
         default:
             break;
     }
@@ -79,7 +93,8 @@ PDuint32 BufferElement::GetComponentCount() const
     return 0;
 }
 
-BufferLayout::BufferLayout(const std::initializer_list<BufferElement>& elms)
+BufferLayout::BufferLayout(const std::initializer_list<BufferElement>& elms, PDuint32 divisor)
+    : m_Divisor(divisor)
 {
     for (auto& elm : elms)
     {
@@ -107,13 +122,17 @@ Ref<VertexBuffer> VertexBuffer::Create(PDsizei size, const PDfloat* data)
     switch (Renderer::GetAPI())
     {
         case RendererAPI::API::None:
-            throw DewpsiError(_ERROR("Renderer API is set to none"));
+            return CreateRef<NullVertexBuffer>(size);
             break;
 
         case RendererAPI::API::OpenGL:
             return CreateRef<OpenGLVertexBuffer>(size, data);
             break;
 
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareVertexBuffer>(size, data);
+            break;
+
         default: break;
     }
 
@@ -124,18 +143,80 @@ Ref<VertexBuffer> VertexBuffer::Create(PDsizei size, const PDfloat* data)
     #undef _ERROR
 }
 
-Ref<IndexBuffer> IndexBuffer::Create(PDsizei size, const PDuint32* data)
+Ref<VertexBuffer> VertexBuffer::Create(PDsizei size)
+{
+    #define _ERROR(msg) "VertexBuffer::Create: " msg
+
+    switch (Renderer::GetAPI())
+    {
+        case RendererAPI::API::None:
+            return CreateRef<NullVertexBuffer>(size);
+            break;
+
+        case RendererAPI::API::OpenGL:
+            return CreateRef<OpenGLVertexBuffer>(size);
+            break;
+
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareVertexBuffer>(size);
+            break;
+
+        default: break;
+    }
+
+    throw DewpsiError(_ERROR("unrecognized API"));
+
+    return nullptr;
+
+    #undef _ERROR
+}
+
+Ref<StreamBuffer> StreamBuffer::Create(PDsizei regionSize, PDuint regionCount, Usage usage)
+{
+    #define _ERROR(msg) "StreamBuffer::Create: " msg
+
+    switch (Renderer::GetAPI())
+    {
+        case RendererAPI::API::None:
+            return CreateRef<NullStreamBuffer>(regionSize, regionCount);
+            break;
+
+        case RendererAPI::API::OpenGL:
+            return CreateRef<OpenGLStreamBuffer>(regionSize, regionCount,
+                (usage == Usage::Index) ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER);
+            break;
+
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareStreamBuffer>(regionSize, regionCount);
+            break;
+
+        default: break;
+    }
+
+    throw DewpsiError(_ERROR("unrecognized API"));
+
+    return nullptr;
+
+    #undef _ERROR
+}
+
+// Both index widths are created the same way
+static Ref<IndexBuffer> CreateIndexBuffer(PDsizei count, const void* data, IndexType type)
 {
     #define _ERROR(msg) "IndexBuffer::Create: " msg
 
     switch (Renderer::GetAPI())
     {
         case RendererAPI::API::None:
-            throw DewpsiError(_ERROR("Renderer API is set to none"));
+            return CreateRef<NullIndexBuffer>(count, type);
             break;
 
         case RendererAPI::API::OpenGL:
-            return CreateRef<OpenGLIndexBuffer>(size, data);
+            return CreateRef<OpenGLIndexBuffer>(count, data, type);
+            break;
+
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareIndexBuffer>(count, data, type);
             break;
 
         default: break;
@@ -148,4 +229,14 @@ Ref<IndexBuffer> IndexBuffer::Create(PDsizei size, const PDuint32* data)
     #undef _ERROR
 }
 
+Ref<IndexBuffer> IndexBuffer::Create(PDsizei size, const PDuint32* data)
+{
+    return CreateIndexBuffer(size, data, IndexType::UInt32);
+}
+
+Ref<IndexBuffer> IndexBuffer::Create16(PDsizei size, const PDuint16* data)
+{
+    return CreateIndexBuffer(size, data, IndexType::UInt16);
+}
+
 }
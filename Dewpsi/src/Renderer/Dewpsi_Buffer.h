@@ -20,6 +20,12 @@ namespace Dewpsi {
     *   @code{.cpp}
         Dewpsi::ShaderDataType type = Dewpsi::ShaderDataType::float3;
     *   @endcode
+    *   The packed types take a fraction of the space of their float counterparts and are
+    *   turned into floats when the shader reads them, so the shader still declares a @c vec2
+    *   or @c vec4. Integer types that are not normalized are read as integers (@c int,
+    *   @c ivec2, ...); normalized ones as floats, from -1 to 1 if they are signed (such as
+    *   Short2Norm) and from 0 to 1 if they are unsigned (UByte4Norm, UInt10_10_10_2).
+    *
     *   Valid constants of this type are as follows:
     */
     enum class ShaderDataType : PDuint8 {
@@ -33,11 +39,22 @@ namespace Dewpsi {
         Int2,	  ///< Two-component tnteger
         Int3,	  ///< Three-component tnteger
         Int4,	  ///< Four-component tnteger
-        Bool	  ///< Boolean
+        Bool,	  ///< Boolean
+        UByte4Norm,     ///< Four unsigned bytes read as 0 to 1, such as an RGBA8 color; always normalized
+        Short2Norm,     ///< Two signed 16-bit integers read as -1 to 1; always normalized
+        Half2,          ///< Two-component 16-bit float
+        Half4,          ///< Four-component 16-bit float
+        UInt10_10_10_2  ///< x, y and z in 10 bits each and w in the top 2 of 32; read as 0 to 1 if normalized
 	};
 
     PD_CALL uint32_t ShaderDataTypeSize(ShaderDataType type);
 
+    /// Returns true if @a type is always normalized, whatever the BufferElement says.
+    inline bool ShaderDataTypeIsNormalized(ShaderDataType type)
+    {
+        return type == ShaderDataType::UByte4Norm || type == ShaderDataType::Short2Norm;
+    }
+
     /** An element of the array held by BufferLayout.
     *   It represents a vertex attribute. A vertec attribute
     *   has a name, a type, a size of that type, and its relative
@@ -56,7 +73,7 @@ namespace Dewpsi {
         /// Initialize the type, name and normalization flag of the shader data.
         BufferElement(ShaderDataType _type, const PDstring& _name, bool nml = false)
             : name(_name), type(_type), size(ShaderDataTypeSize(type)),
-              offset(0), normalized(nml) {}
+              offset(0), normalized(nml || ShaderDataTypeIsNormalized(_type)) {}
 
         /// Copy constructor.
         BufferElement(const BufferElement& src)
@@ -76,11 +93,28 @@ namespace Dewpsi {
 
         /// Returns the component count.
         PDuint32 GetComponentCount() const;
+
+        /// Returns true if the shader reads the element as integers: an Int type that is not normalized.
+        bool IsInteger() const
+        {
+            return ! normalized && (type == ShaderDataType::Int || type == ShaderDataType::Int2
+                || type == ShaderDataType::Int3 || type == ShaderDataType::Int4);
+        }
     };
 
     /** Buffer layout description.
     *   This is passed to the @doxtype{VertexBuffer} to format its data.
     *   For an example on how to use this class, see the main page.
+    *
+    *   A layout with a non-zero divisor is instanced: its attributes advance once every
+    *   @a divisor instances instead of once per vertex. This is how per-instance data,
+    *   such as a transform or a color, is fed to RenderCommand::DrawIndexedInstanced().
+    *   @code{.cpp}
+        instanceBuffer->SetLayout(Dewpsi::BufferLayout({
+            {Dewpsi::ShaderDataType::Float3, "in_Offset"},
+            {Dewpsi::ShaderDataType::Float4, "in_Color"}
+        }, 1));
+    *   @endcode
     */
     class BufferLayout {
         /// Vector type
@@ -88,18 +122,23 @@ namespace Dewpsi {
     public:
         BufferLayout() = default;
 
-        /// Initialize a list of elements in the layout.
-        BufferLayout(const std::initializer_list<BufferElement>& elms);
+        /** Initialize a list of elements in the layout.
+        *   @param elms     The elements of the layout
+        *   @param divisor  The number of instances drawn before the attributes advance,
+        *                   or zero to advance them per vertex
+        */
+        BufferLayout(const std::initializer_list<BufferElement>& elms, PDuint32 divisor = 0);
 
         /// Copy constructor.
         BufferLayout(const BufferLayout& src)
-            : m_Elements(src.m_Elements), m_Stride(src.m_Stride) {}
+            : m_Elements(src.m_Elements), m_Stride(src.m_Stride), m_Divisor(src.m_Divisor) {}
 
         /// Copy assignment.
         BufferLayout& operator=(const BufferLayout& rhs)
         {
             m_Elements = rhs.m_Elements;
             m_Stride = rhs.m_Stride;
+            m_Divisor = rhs.m_Divisor;
             return *this;
         }
 
@@ -112,6 +151,15 @@ namespace Dewpsi {
         /// Returns the stride of the layout.
         PDuint32 GetStride() const {return m_Stride;}
 
+        /// Returns the instance divisor of the layout.
+        PDuint32 GetDivisor() const {return m_Divisor;}
+
+        /// Sets the instance divisor of the layout.
+        void SetDivisor(PDuint32 divisor) {m_Divisor = divisor;}
+
+        /// Returns true if the attributes of the layout advance per instance.
+        bool IsInstanced() const {return m_Divisor != 0;}
+
         /// Returns an iterator to the beginning of the element array.
         BufferVector::iterator begin() { return m_Elements.begin(); }
 
@@ -129,6 +177,7 @@ namespace Dewpsi {
 
         BufferVector m_Elements;
         PDuint32 m_Stride;
+        PDuint32 m_Divisor = 0;
     };
 
     /// Vertex buffer.
@@ -149,6 +198,13 @@ namespace Dewpsi {
         /// Set the layout of the vertex buffer.
         virtual void SetLayout(const BufferLayout& layout) = 0;
 
+        /** Replaces the contents of the buffer.
+        *   @param data  A pointer to the new data
+        *   @param size  The size of @a data in bytes; must not exceed the size
+        *                the buffer was created with
+        */
+        virtual void SetData(const void* data, PDsizei size) = 0;
+
         /** Creates a vertex buffer.
         *   The API-specific vertex buffer is bound (according to the method of the API)
         *   when this is created. Depending on the API, this is neccessary to supply that
@@ -159,8 +215,90 @@ namespace Dewpsi {
         *	@return      A pointer to the API and platform-specific vertex buffer
         */
         static Ref<VertexBuffer> Create(PDsizei size, const PDfloat* data);
+
+        /** Creates a dynamic vertex buffer.
+        *   The buffer is allocated with @a size bytes of uninitialized storage
+        *   and is meant to be updated frequently with SetData().
+        *
+        *	@param size  The size of the buffer in bytes
+        *	@return      A pointer to the API and platform-specific vertex buffer
+        */
+        static Ref<VertexBuffer> Create(PDsizei size);
+    };
+
+    /** Streaming vertex buffer for geometry that changes every frame.
+    *   The buffer is split into @a regionCount regions of @a regionSize bytes each. Every
+    *   frame writes into its own region while the GPU may still be reading the regions of
+    *   previous frames; NextFrame() fences the current region and moves on to the next,
+    *   waiting only if the GPU has not finished with it yet.
+    *
+    *   @code{.cpp}
+        void* dst = stream->Map(bytes);
+        std::memcpy(dst, vertices, bytes);
+        stream->Unmap();
+        PDsizei offset = stream->GetMappedOffset(); // where the data landed in the buffer
+        // ... draw ...
+        stream->NextFrame(); // once per frame
+    *   @endcode
+    *
+    *   Where the API supports it, the buffer is mapped once for its whole lifetime, so
+    *   Map() and Unmap() cost no allocation and no driver copy.
+    */
+    class StreamBuffer : public VertexBuffer {
+    public:
+        /// What the stream holds; decides which target the buffer is bound to.
+        enum class Usage {
+            Vertex, ///< Vertex attributes
+            Index   ///< 32-bit indices
+        };
+
+        virtual ~StreamBuffer() {}
+
+        /** Reserves @a size bytes in the region of the current frame.
+        *   @param size       The number of bytes to write
+        *   @param alignment  The byte alignment of the returned pointer's offset
+        *   @return           A write-only pointer to the reserved bytes, or @c NULL if the
+        *                     region of this frame does not have enough space left
+        */
+        virtual void* Map(PDsizei size, PDsizei alignment = 1) = 0;
+
+        /// Finishes the writes started by Map(); must be called before drawing.
+        virtual void Unmap() = 0;
+
+        /// Returns the byte offset of the last Map() from the start of the buffer.
+        virtual PDsizei GetMappedOffset() const = 0;
+
+        /// Fences the current region and advances to the next one.
+        virtual void NextFrame() = 0;
+
+        /// Returns the size of one region in bytes.
+        virtual PDsizei GetRegionSize() const = 0;
+
+        /// Returns the number of regions.
+        virtual PDuint GetRegionCount() const = 0;
+
+        /** Creates a stream buffer.
+        *	@param regionSize   The number of bytes that can be written per frame
+        *	@param regionCount  The number of frames the buffer rotates through
+        *	@param usage        Whether the buffer holds vertices or indices
+        *	@return             A pointer to the API and platform-specific stream buffer
+        */
+        static Ref<StreamBuffer> Create(PDsizei regionSize, PDuint regionCount = 3,
+            Usage usage = Usage::Vertex);
+    };
+
+    /// Width of the indices held by an IndexBuffer.
+    enum class IndexType : PDuint8 {
+        UInt16,   ///< Unsigned 16-bit indices, for meshes of at most 65536 vertices
+        UInt32    ///< Unsigned 32-bit indices
     };
 
+    /// Returns the size in bytes of an index of @a type.
+    inline PDuint32 IndexTypeSize(IndexType type)
+    {
+        return (type == IndexType::UInt16) ? sizeof(PDuint16) : sizeof(PDuint32);
+    }
+
     /// Index array buffer.
     class IndexBuffer {
     public:
@@ -175,6 +313,9 @@ namespace Dewpsi {
         /// Returns the number of indices.
         virtual PDuint32 GetCount() const = 0;
 
+        /// Returns the width of the indices.
+        virtual IndexType GetIndexType() const = 0;
+
         /** Creates an index buffer.
         *   The API-specific index buffer is bound (according to the method of the API)
         *   when this is created. Depending on the API, this is neccessary to supply that
@@ -186,6 +327,16 @@ namespace Dewpsi {
         *	@return       A pointer to the API and platform-specific vertex buffer
         */
         static Ref<IndexBuffer> Create(PDsizei count, const PDuint32* data);
+
+        /** Creates an index buffer of unsigned 16-bit integers.
+        *   Half the size of 32-bit indices, for meshes of at most 65536 vertices. Named apart
+        *   from Create() so that <tt>Create(count, nullptr)</tt> stays unambiguous.
+        *
+        *	@param count  The number of elements in the array at @a data
+        *	@param data   A pointer to an array of unsigned 16-bit integers
+        *	@return       A pointer to the API and platform-specific index buffer
+        */
+        static Ref<IndexBuffer> Create16(PDsizei count, const PDuint16* data);
     };
 
     /// @}
@@ -0,0 +1,39 @@
+#include "Dewpsi_CommandList.h"
+#include "Dewpsi_Shader.h"
+#include "Dewpsi_Texture.h"
+
+namespace Dewpsi {
+
+void CommandList::Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray,
+    const glm::mat4& transform)
+{
+    m_Keys.push_back(RenderQueue::MakeKey(m_Layer, shader->GetRendererID(), 0, vertexArray->GetRendererID()));
+    m_Commands.push_back({shader, vertexArray, nullptr, 0, transform, 0});
+}
+
+void CommandList::Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray,
+    const Ref<Texture>& texture, PDuint slot, const glm::mat4& transform)
+{
+    m_Keys.push_back(RenderQueue::MakeKey(m_Layer, shader->GetRendererID(), texture->GetRendererID(),
+        vertexArray->GetRendererID()));
+    m_Commands.push_back({shader, vertexArray, texture, slot, transform, 0});
+}
+
+void CommandList::SubmitInstanced(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray,
+    PDuint32 instanceCount, const glm::mat4& transform)
+{
+    if (! instanceCount)
+        return;
+
+    m_Keys.push_back(RenderQueue::MakeKey(m_Layer, shader->GetRendererID(), 0, vertexArray->GetRendererID()));
+    m_Commands.push_back({shader, vertexArray, nullptr, 0, transform, instanceCount});
+}
+
+void CommandList::Clear()
+{
+    m_Keys.clear();
+    m_Commands.clear();
+    m_Layer = 0;
+}
+
+}
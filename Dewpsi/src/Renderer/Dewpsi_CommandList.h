@@ -0,0 +1,78 @@
+#ifndef DEWPSI_COMMANDLIST_H
+#define DEWPSI_COMMANDLIST_H
+
+/** @file Dewpsi_CommandList.h
+*   @ref core_renderer
+*/
+
+#include <Dewpsi_RenderQueue.h>
+
+namespace Dewpsi {
+    /** Draws recorded on any thread, for Renderer::Submit(CommandList&).
+    *   A list records the same draws as Renderer::Submit(), with their sort keys, but makes no
+    *   calls to the rendering API, so a layer can fill it on a worker thread. A list is not
+    *   synchronized: each list must be filled by one thread at a time.
+    *
+    *   When the scene ends, the commands of every submitted list are moved into the render
+    *   queue and the list is left empty, keeping its memory for the next frame. Lists are
+    *   merged by their order and the queue sort is stable, so as long as lists submitted from
+    *   different threads have different orders, the result does not depend on which thread
+    *   finished first.
+    *
+    *   @code{.cpp}
+        // In OnUpdate(), between Renderer::BeginScene() and Renderer::EndScene()
+        std::thread worker([this]{
+            for (const Sprite& sprite : m_Sprites)
+                m_List.Submit(m_Shader, m_Quad, sprite.texture, 0, sprite.transform);
+        });
+        worker.join();
+        Dewpsi::Renderer::Submit(m_List);
+    *   @endcode
+    *   @ingroup core_renderer
+    */
+    class CommandList {
+    public:
+        /** Creates an empty list.
+        *   @param order  Lists with a lower order are merged first; lists with the same
+        *                 order are merged in the order they were submitted
+        */
+        explicit CommandList(PDuint32 order = 0) : m_Order(order) {}
+
+        /// Sets the layer of subsequent draws; see Renderer::SetLayer().
+        void SetLayer(PDuint8 layer) {m_Layer = layer;}
+
+        /// Records a draw; see Renderer::Submit().
+        void Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray,
+            const glm::mat4& transform = glm::mat4(1.0f));
+
+        /// Records a textured draw; see Renderer::Submit().
+        void Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray,
+            const Ref<Texture>& texture, PDuint slot, const glm::mat4& transform = glm::mat4(1.0f));
+
+        /// Records an instanced draw; see Renderer::SubmitInstanced().
+        void SubmitInstanced(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray,
+            PDuint32 instanceCount, const glm::mat4& transform = glm::mat4(1.0f));
+
+        /// Removes every command and resets the layer to 0.
+        void Clear();
+
+        /// Returns the number of recorded commands.
+        PDsizei GetSize() const {return m_Commands.size();}
+
+        /// Returns the merge order of the list.
+        PDuint32 GetOrder() const {return m_Order;}
+
+        /// Sets the merge order of the list.
+        void SetOrder(PDuint32 order) {m_Order = order;}
+
+    private:
+        friend class RenderQueue;
+
+        std::vector<PDuint64> m_Keys;
+        std::vector<RenderQueueCommand> m_Commands;
+        PDuint32 m_Order;
+        PDuint8 m_Layer = 0;
+    };
+}
+
+#endif /* DEWPSI_COMMANDLIST_H */
@@ -0,0 +1,245 @@
+#include "Dewpsi_DebugDraw.h"
+#include "Dewpsi_Renderer.h"
+#include "Dewpsi_RenderCommand.h"
+#include "Dewpsi_RenderThread.h"
+#include "Dewpsi_Shader.h"
+#include "Dewpsi_VertexArray.h"
+#include "Dewpsi_Log.h"
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Dewpsi {
+
+static const char* _VertexShaderSource = R"(
+    layout(location = 0) in vec3 in_Position;
+    layout(location = 1) in vec4 in_Color;
+
+    out vec4 v_Color;
+
+    void main() {
+        v_Color = in_Color;
+        gl_Position = u_ViewProjection * vec4(in_Position, 1.0);
+    }
+)";
+
+static const char* _FragmentShaderSource = R"(
+    in vec4 v_Color;
+    out vec4 FragColor;
+
+    void main() {
+        FragColor = v_Color;
+    }
+)";
+
+// The color is packed to RGBA8, 16 bytes instead of 28
+struct DebugVertex {
+    glm::vec3 position;
+    PDuint32 color;
+};
+
+// GPU side of a batch
+struct DebugBatch {
+    Ref<VertexArray> vertexArray;
+    Ref<VertexBuffer> vertexBuffer;
+    PDsizei capacity = 0;   // vertices the buffer has room for
+};
+
+struct DebugDrawData {
+    static constexpr PDsizei InitialVertices = 4096;
+
+    Ref<Shader> shader;     // created by the first flush
+    DebugBatch lineBatch;
+    DebugBatch triangleBatch;
+
+    std::vector<DebugVertex> lineVertices;
+    std::vector<DebugVertex> triangleVertices;
+    bool enabled = true;
+
+    DebugDraw::Statistics stats = {0, 0, 0};
+};
+
+static DebugDrawData* _Data = nullptr;
+
+void DebugDraw::Init()
+{
+    PD_CORE_ASSERT(! _Data, "DebugDraw already initialized");
+    _Data = new DebugDrawData;
+
+    _Data->lineVertices.reserve(DebugDrawData::InitialVertices);
+    _Data->triangleVertices.reserve(DebugDrawData::InitialVertices);
+
+    PD_CORE_TRACE("Initialized DebugDraw");
+}
+
+void DebugDraw::Shutdown()
+{
+    delete _Data;
+    _Data = nullptr;
+}
+
+void DebugDraw::Line(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color)
+{
+    PD_CORE_ASSERT(_Data, "DebugDraw used before Renderer::Init()");
+    if (! _Data->enabled)
+        return;
+    const PDuint32 uiColor = glm::packUnorm4x8(color);
+    _Data->lineVertices.push_back({from, uiColor});
+    _Data->lineVertices.push_back({to, uiColor});
+}
+
+void DebugDraw::Rect(const Rectf& rect, const glm::vec4& color, bool filled)
+{
+    PD_CORE_ASSERT(_Data, "DebugDraw used before Renderer::Init()");
+    const glm::vec2 corners[4] = {
+        {rect.x, rect.y}, {rect.x + rect.w, rect.y}, {rect.x + rect.w, rect.y + rect.h}, {rect.x, rect.y + rect.h}
+    };
+    Polygon(corners, 4, color, filled);
+}
+
+void DebugDraw::Circle(const glm::vec2& center, float radius, const glm::vec4& color, bool filled, PDuint segments)
+{
+    PD_CORE_ASSERT(_Data, "DebugDraw used before Renderer::Init()");
+    if (! _Data->enabled)
+        return;
+
+    segments = std::max(segments, 3u);
+    glm::vec2 points[256];
+    segments = std::min<PDuint>(segments, sizeof(points) / sizeof(points[0]));
+
+    const float fStep = 6.28318530718f / (float) segments;
+    for (PDuint i = 0; i < segments; ++i)
+        points[i] = center + glm::vec2(std::cos(fStep * (float) i), std::sin(fStep * (float) i)) * radius;
+    Polygon(points, segments, color, filled);
+}
+
+void DebugDraw::Polygon(const glm::vec2* points, PDsizei count, const glm::vec4& color, bool filled)
+{
+    PD_CORE_ASSERT(_Data, "DebugDraw used before Renderer::Init()");
+    if (! _Data->enabled || count < 2)
+        return;
+    const PDuint32 uiColor = glm::packUnorm4x8(color);
+
+    if (! filled)
+    {
+        std::vector<DebugVertex>& vertices = _Data->lineVertices;
+        for (PDsizei i = 0; i < count; ++i)
+        {
+            const glm::vec2& next = points[(i + 1) % count];
+            vertices.push_back({glm::vec3(points[i], 0.0f), uiColor});
+            vertices.push_back({glm::vec3(next, 0.0f), uiColor});
+        }
+        return;
+    }
+
+    std::vector<DebugVertex>& vertices = _Data->triangleVertices;
+    for (PDsizei i = 1; i + 1 < count; ++i)
+    {
+        vertices.push_back({glm::vec3(points[0], 0.0f), uiColor});
+        vertices.push_back({glm::vec3(points[i], 0.0f), uiColor});
+        vertices.push_back({glm::vec3(points[i + 1], 0.0f), uiColor});
+    }
+}
+
+// Uploads @a vertices into @a batch, growing it if needed, and draws them
+static void DrawBatch(DebugBatch& batch, const std::vector<DebugVertex>& vertices, RendererAPI::PrimitiveType type)
+{
+    if (vertices.empty())
+        return;
+
+    if (vertices.size() > batch.capacity)
+    {
+        batch.capacity = std::max(batch.capacity * 2, std::max(vertices.size(), DebugDrawData::InitialVertices));
+        batch.vertexArray = VertexArray::Create();
+        batch.vertexArray->Bind();
+        batch.vertexBuffer = VertexBuffer::Create(batch.capacity * sizeof(DebugVertex));
+        batch.vertexBuffer->SetLayout({
+            {ShaderDataType::Float3, "in_Position"},
+            {ShaderDataType::UByte4Norm, "in_Color"}
+        });
+        batch.vertexArray->AddVertexBuffer(batch.vertexBuffer);
+        batch.vertexArray->UnBind();
+    }
+
+    batch.vertexBuffer->SetData(vertices.data(), vertices.size() * sizeof(DebugVertex));
+    batch.vertexArray->Bind();
+    RenderCommand::DrawArrays(batch.vertexArray, (PDuint32) vertices.size(), type);
+}
+
+static void DrawBatches(const std::vector<DebugVertex>& lines, const std::vector<DebugVertex>& triangles,
+    const glm::mat4& viewProjection)
+{
+    Renderer::SetCamera(viewProjection);
+    if (! _Data->shader)
+        _Data->shader = Renderer::CreateShader(_VertexShaderSource, _FragmentShaderSource);
+    if (! _Data->shader->Bind())
+        return;
+
+    // Filled shapes first, so outlines stay visible on top of them
+    DrawBatch(_Data->triangleBatch, triangles, RendererAPI::PrimitiveType::Triangles);
+    DrawBatch(_Data->lineBatch, lines, RendererAPI::PrimitiveType::Lines);
+}
+
+void DebugDraw::Flush(const OrthoCamera& camera)
+{
+    PD_CORE_ASSERT(_Data, "DebugDraw used before Renderer::Init()");
+    std::vector<DebugVertex>& lines = _Data->lineVertices;
+    std::vector<DebugVertex>& triangles = _Data->triangleVertices;
+
+    _Data->stats.drawCalls = (PDuint32) (! lines.empty()) + (PDuint32) (! triangles.empty());
+    _Data->stats.lines = (PDuint32) (lines.size() / 2);
+    _Data->stats.triangles = (PDuint32) (triangles.size() / 3);
+    if (! _Data->stats.drawCalls)
+        return;
+
+    RenderCommand::BeginPass("Debug");
+    if (RenderThread::IsRecording())
+    {
+        // The batches are handed over whole; recording goes on into fresh ones
+        RenderThread::Enqueue([lines = PD_MOVE(lines), triangles = PD_MOVE(triangles),
+            viewProjection = camera.GetViewProjectionMatrix()]{
+            DrawBatches(lines, triangles, viewProjection);
+        });
+        lines = std::vector<DebugVertex>();
+        triangles = std::vector<DebugVertex>();
+        lines.reserve(_Data->stats.lines * 2);
+        triangles.reserve(_Data->stats.triangles * 3);
+    }
+    else
+    {
+        DrawBatches(lines, triangles, camera.GetViewProjectionMatrix());
+        lines.clear();
+        triangles.clear();
+    }
+    RenderCommand::EndPass();
+}
+
+void DebugDraw::Clear()
+{
+    PD_CORE_ASSERT(_Data, "DebugDraw used before Renderer::Init()");
+    _Data->lineVertices.clear();
+    _Data->triangleVertices.clear();
+}
+
+void DebugDraw::SetEnabled(bool enabled)
+{
+    PD_CORE_ASSERT(_Data, "DebugDraw used before Renderer::Init()");
+    _Data->enabled = enabled;
+    if (! enabled)
+        Clear();
+}
+
+bool DebugDraw::IsEnabled()
+{
+    PD_CORE_ASSERT(_Data, "DebugDraw used before Renderer::Init()");
+    return _Data->enabled;
+}
+
+DebugDraw::Statistics DebugDraw::GetStats()
+{
+    PD_CORE_ASSERT(_Data, "DebugDraw used before Renderer::Init()");
+    return _Data->stats;
+}
+
+}
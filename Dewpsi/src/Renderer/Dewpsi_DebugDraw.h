@@ -0,0 +1,81 @@
+#ifndef DEWPSI_DEBUGDRAW_H
+#define DEWPSI_DEBUGDRAW_H
+
+/** @file Dewpsi_DebugDraw.h
+*   @ref core_renderer
+*/
+
+#include <Dewpsi_Core.h>
+#include <Dewpsi_Rect.h>
+#include <Dewpsi_OrthoCamera.h>
+#include <glm/glm.hpp>
+
+namespace Dewpsi {
+    /** Immediate-mode lines and shapes for debug views.
+    *   Shapes can be added from anywhere on the main thread during a frame; they are appended
+    *   to one batch of lines and one of triangles, which Flush() draws with a draw call each and
+    *   empties. Nothing is kept from one frame to the next, so a shape is added every frame it
+    *   should be seen. While disabled, shapes are dropped as soon as they are added.
+    *
+    *   @code{.cpp}
+        for (const Body& body : m_World.GetBodies())
+            Dewpsi::DebugDraw::Rect(body.bounds, {0.0f, 1.0f, 0.0f, 1.0f});
+        Dewpsi::DebugDraw::Circle(m_Enemy.position, m_Enemy.sightRadius, {1.0f, 0.0f, 0.0f, 0.25f}, true);
+
+        // Once per frame, after the scene
+        Dewpsi::DebugDraw::Flush(m_CameraController.GetCamera());
+    *   @endcode
+    *   @ingroup core_renderer
+    */
+    class DebugDraw {
+    public:
+        /// What the last Flush() drew.
+        struct Statistics {
+            PDuint32 drawCalls; ///< Draw calls issued, at most 2
+            PDuint32 lines;     ///< Lines drawn
+            PDuint32 triangles; ///< Filled triangles drawn
+        };
+
+        /// Creates the batches; called by Renderer::Init(). The shader is created by the first Flush().
+        static void Init();
+
+        /// Destroys the shader and buffers; called by Renderer::Shutdown().
+        static void Shutdown();
+
+        /// Adds a line from @a from to @a to.
+        static void Line(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color);
+
+        /// Adds a line from @a from to @a to.
+        static void Line(const glm::vec2& from, const glm::vec2& to, const glm::vec4& color)
+        { Line(glm::vec3(from, 0.0f), glm::vec3(to, 0.0f), color); }
+
+        /// Adds the outline of @a rect, or fills it; @c x and @c y are its bottom-left corner.
+        static void Rect(const Rectf& rect, const glm::vec4& color, bool filled = false);
+
+        /// Adds the outline of a circle, or fills it, as a polygon of @a segments sides (3 to 256).
+        static void Circle(const glm::vec2& center, float radius, const glm::vec4& color, bool filled = false,
+            PDuint segments = 32);
+
+        /** Adds the closed outline through @a count points, or fills it.
+        *   Filled polygons are split into a fan from the first point, so they must be convex.
+        */
+        static void Polygon(const glm::vec2* points, PDsizei count, const glm::vec4& color, bool filled = false);
+
+        /// Draws every shape added since the last flush, seen from @a camera, and empties the batches.
+        static void Flush(const OrthoCamera& camera);
+
+        /// Drops every shape added since the last flush.
+        static void Clear();
+
+        /// Enables or disables debug drawing; it is enabled by default.
+        static void SetEnabled(bool enabled);
+
+        /// Returns true if shapes are being drawn.
+        static bool IsEnabled();
+
+        /// Returns what the last Flush() drew.
+        static Statistics GetStats();
+    };
+}
+
+#endif /* DEWPSI_DEBUGDRAW_H */
@@ -0,0 +1,321 @@
+#include "Dewpsi_Font.h"
+#include "Dewpsi_RenderThread.h"
+#include "Dewpsi_Log.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace Dewpsi {
+
+// Size of a new atlas; most fonts at HUD sizes fit in it
+static constexpr PDuint _InitialAtlasSize = 256;
+
+// Empty texels between glyphs, so filtering does not bleed neighbors into each other
+static constexpr PDuint _Padding = 1;
+
+// Decodes the code point at @a i and moves past it; malformed sequences decode to U+FFFD
+static PDuint32 NextCodepoint(const PDstring& text, PDsizei& i)
+{
+    const PDuchar ucLead = (PDuchar) text[i++];
+    if (ucLead < 0x80)
+        return ucLead;
+
+    PDuint uLength;
+    PDuint32 uiCodepoint;
+    if ((ucLead & 0xE0) == 0xC0)
+    {
+        uLength = 1;
+        uiCodepoint = ucLead & 0x1F;
+    }
+    else if ((ucLead & 0xF0) == 0xE0)
+    {
+        uLength = 2;
+        uiCodepoint = ucLead & 0x0F;
+    }
+    else if ((ucLead & 0xF8) == 0xF0)
+    {
+        uLength = 3;
+        uiCodepoint = ucLead & 0x07;
+    }
+    else
+        return 0xFFFD;
+
+    for (PDuint k = 0; k < uLength; ++k)
+    {
+        if (i >= text.size() || ((PDuchar) text[i] & 0xC0) != 0x80)
+            return 0xFFFD;
+        uiCodepoint = (uiCodepoint << 6) | ((PDuchar) text[i++] & 0x3F);
+    }
+    return uiCodepoint;
+}
+
+Ref<Font> Font::Create(const PDstring& file, float pixelHeight)
+{
+    std::ifstream in(file, std::ios::binary);
+    if (! in)
+    {
+        PD_CORE_ERROR("Could not open font {0}", file);
+        SetError("Could not open %s", file.c_str());
+        return nullptr;
+    }
+
+    in.seekg(0, in.end);
+    const std::streamoff szLength = in.tellg();
+    in.seekg(0, in.beg);
+    std::vector<char> data(szLength > 0 ? (PDsizei) szLength : 0);
+    in.read(data.data(), (std::streamsize) data.size());
+
+    Ref<Font> font = Create(data.data(), data.size(), pixelHeight);
+    if (! font)
+        PD_CORE_ERROR("Failed to load font {0}: {1}", file, GetError());
+    return font;
+}
+
+Ref<Font> Font::Create(const void* data, PDsizei size, float pixelHeight)
+{
+    PD_CORE_ASSERT(pixelHeight > 0.0f, "Fonts must be rasterized at a positive size");
+
+    TrueTypeFont font;
+    if (! font.Load(data, size))
+        return nullptr;
+    return CreateRef<Font>(PD_MOVE(font), pixelHeight);
+}
+
+Font::Font(TrueTypeFont&& font, float pixelHeight)
+    : m_Font(PD_MOVE(font)), m_PixelHeight(pixelHeight)
+{
+    PDint iAscent, iDescent, iLineGap;
+    m_Font.GetVerticalMetrics(iAscent, iDescent, iLineGap);
+    m_Scale = m_Font.GetScaleForPixelHeight(pixelHeight);
+    m_Ascent = (float) iAscent * m_Scale;
+    m_LineHeight = (float) (iAscent - iDescent + iLineGap) * m_Scale;
+
+    m_AtlasWidth = m_AtlasHeight = _InitialAtlasSize;
+    m_Pixels.assign((PDsizei) m_AtlasWidth * m_AtlasHeight * 4, 0);
+    m_Recreate = true;
+}
+
+const Font::TextRun& Font::Shape(const PDstring& text)
+{
+    auto itr = m_Runs.find(text);
+    if (itr != m_Runs.end() && itr->second.generation == m_Generation)
+        return itr->second;
+
+    // If the cache was emptied midway, the glyphs laid out before that are gone
+    TextRun run;
+    Layout(text, run);
+    if (run.generation != m_Generation)
+        Layout(text, run);
+
+    if (m_Runs.size() >= MaxCachedRuns)
+        m_Runs.clear();
+    TextRun& cached = m_Runs[text];
+    cached = PD_MOVE(run);
+    return cached;
+}
+
+void Font::Layout(const PDstring& text, TextRun& run)
+{
+    run.quads.clear();
+    run.generation = m_Generation;
+
+    float fPenX = 0.0f, fPenY = 0.0f, fWidth = 0.0f;
+    PDuint uLines = 1;
+    PDuint uPrevious = 0;
+    for (PDsizei i = 0; i < text.size(); )
+    {
+        const PDuint32 uiCodepoint = NextCodepoint(text, i);
+        if (uiCodepoint == '\n')
+        {
+            fWidth = std::max(fWidth, fPenX);
+            fPenX = 0.0f;
+            fPenY -= m_LineHeight;
+            ++uLines;
+            uPrevious = 0;
+            continue;
+        }
+        if (uiCodepoint == '\r')
+            continue;
+
+        const PDuint uIndex = m_Font.FindGlyph(uiCodepoint);
+        if (uPrevious)
+            fPenX += (float) m_Font.GetKerning(uPrevious, uIndex) * m_Scale;
+
+        // Copied, as rasterizing the next glyph may empty the cache
+        const Glyph glyph = GetGlyph(uIndex);
+        if (glyph.size.x > 0.0f)
+        {
+            run.quads.push_back({glm::vec2(fPenX, fPenY) + glyph.offset, glyph.size,
+                glyph.texMin, glyph.texMin + glyph.size});
+        }
+
+        fPenX += glyph.advance;
+        uPrevious = uIndex;
+    }
+
+    run.size = glm::vec2(std::max(fWidth, fPenX), (float) uLines * m_LineHeight);
+}
+
+const Font::Glyph& Font::GetGlyph(PDuint index)
+{
+    auto itr = m_Glyphs.find(index);
+    if (itr != m_Glyphs.end())
+        return itr->second;
+
+    Glyph glyph = {};
+    glyph.advance = (float) m_Font.GetAdvance(index) * m_Scale;
+
+    // Glyphs that could never fit into the atlas are not drawn
+    TrueTypeFont::Bitmap bitmap;
+    if (m_Font.Rasterize(index, m_Scale, (PDint) MaxAtlasSize, bitmap))
+    {
+        const PDuint uWidth = (PDuint) bitmap.width, uHeight = (PDuint) bitmap.height;
+        PDuint uX, uY;
+        while (! Pack(uWidth, uHeight, uX, uY))
+        {
+            if (! Grow())
+            {
+                PD_CORE_WARN("Glyph cache of {0}px font is full; emptying it", m_PixelHeight);
+                Reset();
+                if (! Pack(uWidth, uHeight, uX, uY))
+                    return m_Glyphs[index] = glyph;
+                break;
+            }
+        }
+
+        // The bitmap is top row first, the atlas bottom row first
+        for (PDuint r = 0; r < uHeight; ++r)
+        {
+            const PDuchar* source = &bitmap.coverage[(PDsizei) r * uWidth];
+            PDuchar* dest = &m_Pixels[(((PDsizei) (uY + uHeight - 1 - r)) * m_AtlasWidth + uX) * 4];
+            for (PDuint c = 0; c < uWidth; ++c)
+            {
+                dest[c * 4 + 0] = dest[c * 4 + 1] = dest[c * 4 + 2] = 255;
+                dest[c * 4 + 3] = source[c];
+            }
+        }
+
+        if (m_DirtyBegin >= m_DirtyEnd)
+        {
+            m_DirtyBegin = uY;
+            m_DirtyEnd = uY + uHeight;
+        }
+        else
+        {
+            m_DirtyBegin = std::min(m_DirtyBegin, uY);
+            m_DirtyEnd = std::max(m_DirtyEnd, uY + uHeight);
+        }
+
+        glyph.offset = glm::vec2((float) bitmap.left, (float) bitmap.bottom);
+        glyph.size = glm::vec2((float) uWidth, (float) uHeight);
+        glyph.texMin = glm::vec2((float) uX, (float) uY);
+    }
+
+    return m_Glyphs[index] = glyph;
+}
+
+bool Font::Pack(PDuint width, PDuint height, PDuint& x, PDuint& y)
+{
+    const PDuint uWidth = width + _Padding, uHeight = height + _Padding;
+
+    // The shortest shelf the glyph fits on, as long as not too much of it would be wasted
+    Shelf* best = nullptr;
+    for (Shelf& shelf : m_Shelves)
+    {
+        if (shelf.height < uHeight || shelf.height > uHeight + uHeight / 2 + 2)
+            continue;
+        if (shelf.x + uWidth > m_AtlasWidth)
+            continue;
+        if (! best || shelf.height < best->height)
+            best = &shelf;
+    }
+
+    if (! best)
+    {
+        const PDuint uTop = m_Shelves.empty() ? 0 : m_Shelves.back().y + m_Shelves.back().height;
+        if (uTop + uHeight > m_AtlasHeight || uWidth > m_AtlasWidth)
+            return false;
+        m_Shelves.push_back({uTop, uHeight, 0});
+        best = &m_Shelves.back();
+    }
+
+    x = best->x;
+    y = best->y;
+    best->x += uWidth;
+    return true;
+}
+
+bool Font::Grow()
+{
+    if (m_AtlasWidth >= MaxAtlasSize && m_AtlasHeight >= MaxAtlasSize)
+        return false;
+
+    // Texels keep their coordinates, so laid out strings stay valid
+    const PDuint uOldWidth = m_AtlasWidth, uOldHeight = m_AtlasHeight;
+    if (m_AtlasWidth <= m_AtlasHeight)
+        m_AtlasWidth *= 2;
+    else
+        m_AtlasHeight *= 2;
+
+    std::vector<PDuchar> pixels((PDsizei) m_AtlasWidth * m_AtlasHeight * 4, 0);
+    for (PDuint r = 0; r < uOldHeight; ++r)
+    {
+        std::memcpy(&pixels[(PDsizei) r * m_AtlasWidth * 4], &m_Pixels[(PDsizei) r * uOldWidth * 4],
+            (PDsizei) uOldWidth * 4);
+    }
+    m_Pixels = PD_MOVE(pixels);
+    m_Recreate = true;
+    return true;
+}
+
+void Font::Reset()
+{
+    m_Glyphs.clear();
+    m_Runs.clear();
+    m_Shelves.clear();
+    std::fill(m_Pixels.begin(), m_Pixels.end(), (PDuchar) 0);
+    m_DirtyBegin = 0;
+    m_DirtyEnd = m_AtlasHeight;
+    ++m_Generation;
+}
+
+const Ref<Texture2D>& Font::GetTexture()
+{
+    if (m_Recreate)
+    {
+        TextureProperties props;
+        props.mipmaps = MipmapFilter::None;
+        props.minFilter = props.magFilter = TextureFilter::Linear;
+
+        // The old texture may still be referenced by a batch; it goes when the batch does
+        RenderThread::Release(m_Texture);
+        RenderThread::Call([this, props]{
+            m_Texture = Texture2D::Create(m_AtlasWidth, m_AtlasHeight, props);
+        });
+        m_Recreate = false;
+        m_DirtyBegin = 0;
+        m_DirtyEnd = m_AtlasHeight;
+    }
+
+    if (m_DirtyBegin < m_DirtyEnd)
+    {
+        const PDuint uRows = m_DirtyEnd - m_DirtyBegin;
+        const PDuchar* rows = &m_Pixels[(PDsizei) m_DirtyBegin * m_AtlasWidth * 4];
+        if (RenderThread::IsRecording())
+        {
+            // The rows may change again before the render thread gets to them
+            RenderThread::Enqueue([texture = m_Texture, data = std::vector<PDuchar>(rows,
+                rows + (PDsizei) uRows * m_AtlasWidth * 4), y = m_DirtyBegin, width = m_AtlasWidth, uRows]{
+                texture->SetSubData(data.data(), 0, y, width, uRows);
+            });
+        }
+        else
+            m_Texture->SetSubData(rows, 0, m_DirtyBegin, m_AtlasWidth, uRows);
+
+        m_DirtyBegin = m_DirtyEnd = 0;
+    }
+
+    return m_Texture;
+}
+
+}
@@ -0,0 +1,139 @@
+#ifndef DEWPSI_FONT_H
+#define DEWPSI_FONT_H
+
+/** @file Dewpsi_Font.h
+*   @ref core_renderer
+*/
+
+#include <Dewpsi_Core.h>
+#include <Dewpsi_Memory.h>
+#include <Dewpsi_Texture.h>
+#include <Dewpsi_TrueType.h>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace Dewpsi {
+    /** A TrueType font rasterized at one size into a glyph cache, for Renderer2D::DrawString().
+    *   Glyphs are rasterized the first time they are drawn and packed into an atlas texture,
+    *   white with the coverage in alpha, so a string is tinted by the color it is drawn with.
+    *   The atlas starts small and doubles when it is full; at its largest size the cache is
+    *   emptied and refilled with the glyphs in use. Only the rows that changed are uploaded.
+    *
+    *   Laying out a string (glyph lookup, kerning, line breaks) is cached by its text, so a
+    *   label that does not change costs a hash lookup per frame.
+    *
+    *   @code{.cpp}
+        // In OnAttach()
+        m_Font = Dewpsi::Font::Create("assets/fonts/DejaVuSans.ttf", 32.0f);
+
+        // In OnUpdate(), between Renderer2D::BeginScene() and Renderer2D::EndScene()
+        Dewpsi::Renderer2D::DrawString("Score: " + std::to_string(m_Score), m_Font,
+            {-0.9f, 0.8f}, 0.1f, {1.0f, 1.0f, 0.0f, 1.0f});
+    *   @endcode
+    *   @ingroup core_renderer
+    */
+    class Font {
+    public:
+        /// A glyph of a laid out string; positions and sizes are in pixels, y up.
+        struct GlyphQuad {
+            glm::vec2 position; ///< Bottom-left corner relative to the pen position of the first line
+            glm::vec2 size;     ///< Size of the quad
+            glm::vec2 texMin;   ///< Bottom-left corner in the atlas, in texels
+            glm::vec2 texMax;   ///< Top-right corner in the atlas, in texels
+        };
+
+        /// A laid out string.
+        struct TextRun {
+            std::vector<GlyphQuad> quads;   ///< Glyphs with something to draw, in order
+            glm::vec2 size;                 ///< Width of the longest line and height of all lines, in pixels
+            PDuint32 generation;            ///< Cache generation the quads were laid out in
+        };
+
+        /// Rasterized size of the largest atlas; the cache is emptied when it fills up.
+        static constexpr PDuint MaxAtlasSize = 4096;
+
+        /// Maximum number of laid out strings kept; the cache is emptied when it is exceeded.
+        static constexpr PDsizei MaxCachedRuns = 4096;
+
+        /** Loads the font in @a file.
+        *   @param pixelHeight  The size glyphs are rasterized at: the distance from the
+        *                       descender to the ascender, in pixels
+        *   @return             The font, or @c NULL if the file is not a supported font
+        */
+        static Ref<Font> Create(const PDstring& file, float pixelHeight);
+
+        /// Loads a font from memory; the data is copied.
+        static Ref<Font> Create(const void* data, PDsizei size, float pixelHeight);
+
+        /// Wraps a loaded font; use Create() instead.
+        Font(TrueTypeFont&& font, float pixelHeight);
+
+        /// Returns the size glyphs are rasterized at.
+        float GetPixelHeight() const {return m_PixelHeight;}
+
+        /// Returns the distance between the baselines of two lines, in pixels.
+        float GetLineHeight() const {return m_LineHeight;}
+
+        /// Returns the distance from the baseline to the ascender, in pixels.
+        float GetAscent() const {return m_Ascent;}
+
+        /** Lays out @a text, a UTF-8 string; '\\n' starts a new line.
+        *   The result stays valid until the next call that lays out or draws text.
+        */
+        const TextRun& Shape(const PDstring& text);
+
+        /// Returns the size of @a text in pixels, see TextRun::size.
+        glm::vec2 Measure(const PDstring& text) {return Shape(text).size;}
+
+        /// Uploads the glyphs rasterized since the last call and returns the atlas texture.
+        const Ref<Texture2D>& GetTexture();
+
+        /// Returns the size of the atlas in texels.
+        glm::vec2 GetAtlasSize() const {return glm::vec2((float) m_AtlasWidth, (float) m_AtlasHeight);}
+
+        /// Returns a counter that changes whenever the cache is emptied and glyphs move.
+        PDuint32 GetGeneration() const {return m_Generation;}
+
+    private:
+        struct Glyph {
+            glm::vec2 offset;   // bottom-left corner relative to the pen, in pixels
+            glm::vec2 size;     // 0 for glyphs with nothing to draw
+            glm::vec2 texMin;
+            float advance;
+        };
+
+        // A row of the atlas that glyphs are packed into from left to right
+        struct Shelf {
+            PDuint y, height, x;
+        };
+
+        const Glyph& GetGlyph(PDuint index);
+        bool Pack(PDuint width, PDuint height, PDuint& x, PDuint& y);
+        bool Grow();
+        void Reset();
+        void Layout(const PDstring& text, TextRun& run);
+
+        TrueTypeFont m_Font;
+        float m_PixelHeight;
+        float m_Scale;
+        float m_Ascent;
+        float m_LineHeight;
+
+        std::unordered_map<PDuint, Glyph> m_Glyphs;
+        std::unordered_map<PDstring, TextRun> m_Runs;
+        PDuint32 m_Generation = 0;
+
+        // RGBA texels, bottom row first
+        std::vector<PDuchar> m_Pixels;
+        std::vector<Shelf> m_Shelves;
+        PDuint m_AtlasWidth = 0;
+        PDuint m_AtlasHeight = 0;
+        PDuint m_DirtyBegin = 0;    // rows to upload: [m_DirtyBegin, m_DirtyEnd)
+        PDuint m_DirtyEnd = 0;
+        bool m_Recreate = false;    // the texture is missing or too small
+        Ref<Texture2D> m_Texture;
+    };
+}
+
+#endif /* DEWPSI_FONT_H */
@@ -0,0 +1,224 @@
+#include "Dewpsi_FrameCapture.h"
+#include "Dewpsi_ImageWriter.h"
+#include "Dewpsi_Renderer.h"
+#include "Dewpsi_Log.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Dewpsi {
+
+// Frames waiting for a worker before Submit() blocks; bounds the memory when encoding falls behind
+static constexpr PDsizei _MaxQueued = 8;
+
+struct EncodeJob {
+    std::vector<FrameCapture::Target> targets;
+    std::vector<PDuchar> pixels;
+    PDuint width;
+    PDuint height;
+};
+
+static std::mutex _Mutex;
+static std::condition_variable _Wake;     // workers wait for jobs
+static std::condition_variable _Progress; // Submit() and Flush() wait for workers
+static std::deque<EncodeJob> _Jobs;
+static std::vector<std::thread> _Workers;
+static bool _Stop = false;
+static PDsizei _Encoding = 0; // jobs taken by a worker
+static PDsizei _Pending = 0;  // frames taken by the rendering API and not written yet
+
+// Requests for the next presented frame and the recording
+static std::vector<FrameCapture::Target> _Requests;
+static PDstring _RecordPrefix;
+static CaptureFormat _RecordFormat = CaptureFormat::PNG;
+static PDuint _RecordFrame = 0;
+static bool _Recording = false;
+
+static void WriteFrame(EncodeJob& job)
+{
+    if (job.pixels.empty())
+    {
+        for (const FrameCapture::Target& target : job.targets)
+            PD_CORE_ERROR("Failed to capture {0}", target.file);
+        return;
+    }
+
+    // Top row first, and opaque like the window
+    const PDsizei szRowSize = (PDsizei) job.width * 4;
+    std::vector<PDuchar> row(szRowSize);
+    for (PDuint y = 0; y < job.height / 2; ++y)
+    {
+        PDuchar* ucpTop = job.pixels.data() + y * szRowSize;
+        PDuchar* ucpBottom = job.pixels.data() + (job.height - 1 - y) * szRowSize;
+        std::memcpy(row.data(), ucpTop, szRowSize);
+        std::memcpy(ucpTop, ucpBottom, szRowSize);
+        std::memcpy(ucpBottom, row.data(), szRowSize);
+    }
+    for (PDsizei i = 3; i < job.pixels.size(); i += 4)
+        job.pixels[i] = 0xFF;
+
+    for (const FrameCapture::Target& target : job.targets)
+    {
+        const bool bWritten = (target.format == CaptureFormat::PNG)
+            ? ImageWriter::WritePNG(target.file, job.pixels.data(), job.width, job.height)
+            : ImageWriter::WriteRaw(target.file, job.pixels.data(), job.width, job.height);
+        if (! bWritten)
+            PD_CORE_ERROR("Failed to write {0}", target.file);
+    }
+}
+
+static void EncodeThread()
+{
+    for (;;)
+    {
+        EncodeJob job;
+        {
+            std::unique_lock<std::mutex> lock(_Mutex);
+            _Wake.wait(lock, []{return _Stop || ! _Jobs.empty();});
+            if (_Jobs.empty())
+                return; // stopped, with nothing left to write
+            job = PD_MOVE(_Jobs.front());
+            _Jobs.pop_front();
+            ++_Encoding;
+        }
+        _Progress.notify_all();
+
+        WriteFrame(job);
+
+        {
+            std::lock_guard<std::mutex> lock(_Mutex);
+            --_Encoding;
+            --_Pending;
+        }
+        _Progress.notify_all();
+    }
+}
+
+static void StartWorkers()
+{
+    const PDuint uCores = std::thread::hardware_concurrency();
+    const PDuint uCount = std::min(std::max(uCores, 2u) - 1, 4u);
+
+    _Stop = false;
+    for (PDuint i = 0; i < uCount; ++i)
+        _Workers.emplace_back(EncodeThread);
+    PD_CORE_TRACE("Started {0} frame capture threads", uCount);
+}
+
+static const char* GetExtension(CaptureFormat format)
+{
+    return (format == CaptureFormat::PNG) ? ".png" : ".raw";
+}
+
+static bool CanCapture()
+{
+    if (Renderer::GetAPI() == RendererAPI::API::None)
+    {
+        PD_CORE_WARN("The null rendering API has no frames to capture");
+        return false;
+    }
+    return true;
+}
+
+void FrameCapture::Capture(const PDstring& file, CaptureFormat format)
+{
+    if (! CanCapture())
+        return;
+
+    std::lock_guard<std::mutex> lock(_Mutex);
+    _Requests.push_back({file, format});
+}
+
+void FrameCapture::StartRecording(const PDstring& prefix, CaptureFormat format)
+{
+    if (! CanCapture())
+        return;
+
+    std::lock_guard<std::mutex> lock(_Mutex);
+    _RecordPrefix = prefix;
+    _RecordFormat = format;
+    _RecordFrame = 0;
+    _Recording = true;
+}
+
+void FrameCapture::StopRecording()
+{
+    std::lock_guard<std::mutex> lock(_Mutex);
+    _Recording = false;
+}
+
+bool FrameCapture::IsRecording()
+{
+    std::lock_guard<std::mutex> lock(_Mutex);
+    return _Recording;
+}
+
+void FrameCapture::Flush()
+{
+    std::unique_lock<std::mutex> lock(_Mutex);
+    _Progress.wait(lock, []{return _Jobs.empty() && ! _Encoding;});
+}
+
+PDsizei FrameCapture::GetPendingCount()
+{
+    std::lock_guard<std::mutex> lock(_Mutex);
+    return _Pending;
+}
+
+void FrameCapture::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(_Mutex);
+        _Stop = true;
+        _Requests.clear();
+        _Recording = false;
+    }
+    _Wake.notify_all();
+
+    // The workers write every queued frame before they return
+    for (std::thread& worker : _Workers)
+        worker.join();
+    _Workers.clear();
+    _Jobs.clear();
+    _Encoding = 0;
+    _Pending = 0;
+}
+
+bool FrameCapture::TakeTargets(std::vector<Target>& targets)
+{
+    std::lock_guard<std::mutex> lock(_Mutex);
+    targets = PD_MOVE(_Requests);
+    _Requests.clear();
+
+    if (_Recording)
+    {
+        char cpNumber[16];
+        std::snprintf(cpNumber, sizeof(cpNumber), "%06u", _RecordFrame++);
+        targets.push_back({_RecordPrefix + cpNumber + GetExtension(_RecordFormat), _RecordFormat});
+    }
+
+    if (targets.empty())
+        return false;
+    ++_Pending;
+    return true;
+}
+
+void FrameCapture::Submit(std::vector<Target>&& targets, PDuint width, PDuint height,
+    std::vector<PDuchar>&& pixels)
+{
+    std::unique_lock<std::mutex> lock(_Mutex);
+    if (_Workers.empty())
+        StartWorkers();
+
+    // Wait rather than drop frames when the workers fall behind
+    _Progress.wait(lock, []{return _Jobs.size() < _MaxQueued;});
+    _Jobs.push_back({PD_MOVE(targets), PD_MOVE(pixels), width, height});
+    lock.unlock();
+    _Wake.notify_one();
+}
+
+}
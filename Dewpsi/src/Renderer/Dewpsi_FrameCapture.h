@@ -0,0 +1,84 @@
+#ifndef DEWPSI_FRAMECAPTURE_H
+#define DEWPSI_FRAMECAPTURE_H
+
+/** @file Dewpsi_FrameCapture.h
+*   @ref core_renderer
+*/
+
+#include <Dewpsi_Core.h>
+#include <vector>
+
+namespace Dewpsi {
+    /// File format of captured frames.
+    /// @ingroup core_renderer
+    enum class CaptureFormat {
+        PNG,    ///< PNG image
+        Raw     ///< RGBA8 pixels, top row first, without a header
+    };
+
+    /** Writes frames to files without stalling the renderer.
+    *   A capture reads back the back buffer just before it is presented, so it shows
+    *   everything drawn in the frame, ImGui included. The OpenGL API reads into a ring of
+    *   pixel pack buffers and maps each one a few frames later, once its fence is signaled.
+    *   The images are encoded and written by worker threads. The alpha channel of captured
+    *   frames is always opaque, as it is on screen.
+    *
+    *   @code{.cpp}
+        Dewpsi::FrameCapture::Capture("golden/menu.png");
+        Dewpsi::FrameCapture::StartRecording("capture/frame_");  // capture/frame_000000.png, ...
+    *   @endcode
+    *   @ingroup core_renderer
+    */
+    class FrameCapture {
+    public:
+        /// Where a captured frame is written.
+        struct Target {
+            PDstring file;
+            CaptureFormat format;
+        };
+
+        /// Captures the frame being rendered into @a file once it is presented.
+        static void Capture(const PDstring& file, CaptureFormat format = CaptureFormat::PNG);
+
+        /** Captures every presented frame until StopRecording() is called.
+        *   Frames are written to @a prefix followed by a six digit frame number and the
+        *   extension of @a format.
+        */
+        static void StartRecording(const PDstring& prefix, CaptureFormat format = CaptureFormat::PNG);
+
+        /// Stops capturing every frame; frames already captured are still written.
+        static void StopRecording();
+
+        /// Returns true between StartRecording() and StopRecording().
+        static bool IsRecording();
+
+        /** Blocks until every frame handed to the workers is written.
+        *   Frames still being read back by the rendering API are not waited for.
+        */
+        static void Flush();
+
+        /// Returns the number of captured frames that are not written yet.
+        static PDsizei GetPendingCount();
+
+        /** Writes the remaining frames and stops the worker threads.
+        *   Called by Renderer::Shutdown() after the rendering API has handed over its frames.
+        */
+        static void Shutdown();
+
+        /** Takes the targets of the frame about to be presented.
+        *   Called by the rendering contexts once per frame.
+        *   @return False if the frame is not captured
+        */
+        static bool TakeTargets(std::vector<Target>& targets);
+
+        /** Hands a frame that was read back to the workers.
+        *   @param targets  The targets returned by TakeTargets()
+        *   @param pixels   RGBA8 pixels of the frame, bottom row first like @c glReadPixels,
+        *                   or empty if it could not be read
+        */
+        static void Submit(std::vector<Target>&& targets, PDuint width, PDuint height,
+            std::vector<PDuchar>&& pixels);
+    };
+}
+
+#endif /* DEWPSI_FRAMECAPTURE_H */
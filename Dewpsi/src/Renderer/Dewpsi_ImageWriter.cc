@@ -0,0 +1,348 @@
+#include "Dewpsi_ImageWriter.h"
+#include "Dewpsi_Log.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace Dewpsi {
+
+// Deflate limits
+static constexpr PDuint _WindowSize = 32768;
+static constexpr PDuint _MaxMatch = 258;
+
+// Matches are found through a hash of their first four bytes, one RGBA pixel
+static constexpr PDuint _MinMatch = 4;
+static constexpr PDuint _HashBits = 15;
+
+// Candidates tried per position; more finds longer matches, slower
+static constexpr PDuint _MaxChain = 8;
+
+static const PDuint16 _LengthBase[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const PDuchar _LengthExtra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const PDuint16 _DistanceBase[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const PDuchar _DistanceExtra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+// Writes bit fields, least significant bit first, as deflate packs them
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<PDuchar>& out)
+        : m_Out(out), m_Bits(0), m_Count(0)
+    {}
+
+    void Write(PDuint32 bits, PDuint count)
+    {
+        m_Bits |= bits << m_Count;
+        m_Count += count;
+        while (m_Count >= 8)
+        {
+            m_Out.push_back((PDuchar) m_Bits);
+            m_Bits >>= 8;
+            m_Count -= 8;
+        }
+    }
+
+    // Huffman codes are packed starting with their most significant bit
+    void WriteCode(PDuint32 code, PDuint length)
+    {
+        PDuint32 uReversed = 0;
+        for (PDuint i = 0; i < length; ++i)
+            uReversed |= ((code >> i) & 1) << (length - 1 - i);
+        Write(uReversed, length);
+    }
+
+    void Flush()
+    {
+        if (m_Count)
+            m_Out.push_back((PDuchar) m_Bits);
+        m_Bits = 0;
+        m_Count = 0;
+    }
+
+private:
+    std::vector<PDuchar>& m_Out;
+    PDuint32 m_Bits;
+    PDuint m_Count;
+};
+
+// Writes a symbol of the literal/length alphabet with the fixed Huffman codes
+static void WriteSymbol(BitWriter& writer, PDuint symbol)
+{
+    if (symbol < 144)
+        writer.WriteCode(0x30 + symbol, 8);
+    else if (symbol < 256)
+        writer.WriteCode(0x190 + symbol - 144, 9);
+    else if (symbol < 280)
+        writer.WriteCode(symbol - 256, 7);
+    else
+        writer.WriteCode(0xC0 + symbol - 280, 8);
+}
+
+static void WriteMatch(BitWriter& writer, PDuint length, PDuint distance)
+{
+    const PDuint uLength = (PDuint) (std::upper_bound(_LengthBase, _LengthBase + 29, length) - _LengthBase) - 1;
+    WriteSymbol(writer, 257 + uLength);
+    writer.Write(length - _LengthBase[uLength], _LengthExtra[uLength]);
+
+    const PDuint uDistance = (PDuint) (std::upper_bound(_DistanceBase, _DistanceBase + 30, distance) - _DistanceBase) - 1;
+    writer.WriteCode(uDistance, 5);
+    writer.Write(distance - _DistanceBase[uDistance], _DistanceExtra[uDistance]);
+}
+
+static inline PDuint32 HashBytes(const PDuchar* bytes)
+{
+    PDuint32 uValue;
+    std::memcpy(&uValue, bytes, sizeof(uValue));
+    return (uValue * 2654435761u) >> (32 - _HashBits);
+}
+
+// Compresses @a data into a single deflate block with fixed Huffman codes
+static void Deflate(const PDuchar* data, PDsizei size, std::vector<PDuchar>& out)
+{
+    BitWriter writer(out);
+    writer.Write(1, 1); // last block
+    writer.Write(1, 2); // fixed Huffman codes
+
+    // Most recent position of each hash, and the previous position with the same hash
+    std::vector<PDint32> head((PDsizei) 1 << _HashBits, -1);
+    std::vector<PDint32> prev(_WindowSize, -1);
+    auto insert = [&](PDsizei pos) {
+        const PDuint32 uHash = HashBytes(data + pos);
+        prev[pos & (_WindowSize - 1)] = head[uHash];
+        head[uHash] = (PDint32) pos;
+    };
+
+    PDsizei szPos = 0;
+    while (szPos < size)
+    {
+        PDuint uBestLength = 0, uBestDistance = 0;
+        if (szPos + _MinMatch <= size)
+        {
+            const PDuint uLimit = (PDuint) std::min<PDsizei>(_MaxMatch, size - szPos);
+            PDint32 iCandidate = head[HashBytes(data + szPos)];
+            for (PDuint uChain = 0; uChain < _MaxChain && iCandidate >= 0; ++uChain)
+            {
+                const PDsizei szDistance = szPos - (PDsizei) iCandidate;
+                if (szDistance > _WindowSize)
+                    break;
+
+                const PDuchar* ucpCandidate = data + iCandidate;
+                PDuint uLength = 0;
+                while (uLength < uLimit && ucpCandidate[uLength] == data[szPos + uLength])
+                    ++uLength;
+                if (uLength > uBestLength)
+                {
+                    uBestLength = uLength;
+                    uBestDistance = (PDuint) szDistance;
+                    if (uLength == uLimit)
+                        break;
+                }
+                iCandidate = prev[iCandidate & (_WindowSize - 1)];
+            }
+        }
+
+        if (uBestLength >= _MinMatch)
+        {
+            WriteMatch(writer, uBestLength, uBestDistance);
+            const PDsizei szEnd = szPos + uBestLength;
+            for (; szPos < szEnd; ++szPos)
+            {
+                if (szPos + _MinMatch <= size)
+                    insert(szPos);
+            }
+        }
+        else
+        {
+            WriteSymbol(writer, data[szPos]);
+            if (szPos + _MinMatch <= size)
+                insert(szPos);
+            ++szPos;
+        }
+    }
+
+    WriteSymbol(writer, 256); // end of block
+    writer.Flush();
+}
+
+static PDuint32 Crc32(const PDuchar* data, PDsizei size, PDuint32 crc = 0)
+{
+    static const std::array<PDuint32, 256> _Table = []{
+        std::array<PDuint32, 256> table;
+        for (PDuint32 n = 0; n < 256; ++n)
+        {
+            PDuint32 c = n;
+            for (PDuint k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[n] = c;
+        }
+        return table;
+    }();
+
+    crc = ~crc;
+    for (PDsizei i = 0; i < size; ++i)
+        crc = _Table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static PDuint32 Adler32(const PDuchar* data, PDsizei size)
+{
+    PDuint32 a = 1, b = 0;
+    while (size)
+    {
+        // The largest run that cannot overflow before the modulo
+        const PDsizei szRun = std::min<PDsizei>(size, 5552);
+        for (PDsizei i = 0; i < szRun; ++i)
+        {
+            a += data[i];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+        data += szRun;
+        size -= szRun;
+    }
+    return (b << 16) | a;
+}
+
+static void PutBigEndian(std::vector<PDuchar>& out, PDuint32 value)
+{
+    out.push_back((PDuchar) (value >> 24));
+    out.push_back((PDuchar) (value >> 16));
+    out.push_back((PDuchar) (value >> 8));
+    out.push_back((PDuchar) value);
+}
+
+static void PutChunk(std::vector<PDuchar>& out, const char* type, const PDuchar* data, PDsizei size)
+{
+    PutBigEndian(out, (PDuint32) size);
+    const PDsizei szStart = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data, data + size);
+    PutBigEndian(out, Crc32(out.data() + szStart, size + 4));
+}
+
+static inline PDuchar Paeth(PDint a, PDint b, PDint c)
+{
+    const PDint p = a + b - c;
+    const PDint pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc)
+        return (PDuchar) a;
+    return (PDuchar) ((pb <= pc) ? b : c);
+}
+
+// Filters every row with the filter that leaves the smallest values, a common PNG heuristic
+static void FilterRows(const PDuchar* pixels, PDuint width, PDuint height, std::vector<PDuchar>& filtered)
+{
+    const PDsizei szRowSize = (PDsizei) width * 4;
+    filtered.resize((szRowSize + 1) * height);
+
+    std::vector<PDuchar> candidate(szRowSize);
+    for (PDuint y = 0; y < height; ++y)
+    {
+        const PDuchar* ucpRow = pixels + y * szRowSize;
+        const PDuchar* ucpAbove = y ? ucpRow - szRowSize : nullptr;
+        PDuchar* ucpOut = filtered.data() + y * (szRowSize + 1);
+
+        PDuint64 uBestCost = ~0ull;
+        for (PDuchar ucFilter = 0; ucFilter < 5; ++ucFilter)
+        {
+            PDuint64 uCost = 0;
+            for (PDsizei i = 0; i < szRowSize; ++i)
+            {
+                const PDint a = (i >= 4) ? ucpRow[i - 4] : 0;
+                const PDint b = ucpAbove ? ucpAbove[i] : 0;
+                const PDint c = (i >= 4 && ucpAbove) ? ucpAbove[i - 4] : 0;
+                PDuchar ucPredicted = 0;
+                switch (ucFilter)
+                {
+                    case 1: ucPredicted = (PDuchar) a; break;
+                    case 2: ucPredicted = (PDuchar) b; break;
+                    case 3: ucPredicted = (PDuchar) ((a + b) / 2); break;
+                    case 4: ucPredicted = Paeth(a, b, c); break;
+                    default: break;
+                }
+                candidate[i] = (PDuchar) (ucpRow[i] - ucPredicted);
+                uCost += (PDuint) std::abs((PDint) (PDint8) candidate[i]);
+            }
+
+            if (uCost < uBestCost)
+            {
+                uBestCost = uCost;
+                ucpOut[0] = ucFilter;
+                std::memcpy(ucpOut + 1, candidate.data(), szRowSize);
+            }
+        }
+    }
+}
+
+static bool WriteFile(const PDstring& file, const PDuchar* data, PDsizei size)
+{
+    std::ofstream out(file, std::ios::binary);
+    if (out)
+        out.write(reinterpret_cast<const char*>(data), (std::streamsize) size);
+    if (! out)
+    {
+        SetError("Failed to write %s", file.c_str());
+        return false;
+    }
+    return true;
+}
+
+void ImageWriter::EncodePNG(const PDuchar* pixels, PDuint width, PDuint height, std::vector<PDuchar>& png)
+{
+    static const PDuchar _Signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    png.assign(_Signature, _Signature + 8);
+
+    // 8 bits per channel, RGBA, default compression, filtering and no interlacing
+    PDuchar ucHeader[13];
+    const PDuint32 uSize[2] = {width, height};
+    for (PDuint i = 0; i < 2; ++i)
+    {
+        for (PDuint k = 0; k < 4; ++k)
+            ucHeader[i * 4 + k] = (PDuchar) (uSize[i] >> (24 - 8 * k));
+    }
+    ucHeader[8] = 8;
+    ucHeader[9] = 6;
+    ucHeader[10] = ucHeader[11] = ucHeader[12] = 0;
+    PutChunk(png, "IHDR", ucHeader, sizeof(ucHeader));
+
+    std::vector<PDuchar> filtered;
+    FilterRows(pixels, width, height, filtered);
+
+    // zlib stream: header for a 32K window, the deflate data and the checksum
+    std::vector<PDuchar> compressed = {0x78, 0x01};
+    compressed.reserve(filtered.size() / 2);
+    Deflate(filtered.data(), filtered.size(), compressed);
+    PutBigEndian(compressed, Adler32(filtered.data(), filtered.size()));
+
+    PutChunk(png, "IDAT", compressed.data(), compressed.size());
+    PutChunk(png, "IEND", nullptr, 0);
+}
+
+bool ImageWriter::WritePNG(const PDstring& file, const PDuchar* pixels, PDuint width, PDuint height)
+{
+    std::vector<PDuchar> png;
+    EncodePNG(pixels, width, height, png);
+    return WriteFile(file, png.data(), png.size());
+}
+
+bool ImageWriter::WriteRaw(const PDstring& file, const PDuchar* pixels, PDuint width, PDuint height)
+{
+    return WriteFile(file, pixels, (PDsizei) width * height * 4);
+}
+
+}
@@ -0,0 +1,35 @@
+#ifndef DEWPSI_IMAGEWRITER_H
+#define DEWPSI_IMAGEWRITER_H
+
+/** @file Dewpsi_ImageWriter.h
+*   @ref core_renderer
+*/
+
+#include <Dewpsi_Core.h>
+#include <vector>
+
+namespace Dewpsi {
+    /** Writes RGBA8 images to files.
+    *   Pixels are tightly packed, four 8-bit channels each, with the top row first.
+    *   @ingroup core_renderer
+    */
+    namespace ImageWriter {
+        /** Encodes an image as a PNG file in memory.
+        *   Rows are filtered like other PNG encoders do, but the data is compressed with the
+        *   fixed Huffman codes of deflate, which trades some size for speed.
+        *   @param pixels  The pixels of the image
+        *   @param width   The width of the image
+        *   @param height  The height of the image
+        *   @param png     Receives the contents of the file
+        */
+        PD_CALL void EncodePNG(const PDuchar* pixels, PDuint width, PDuint height, std::vector<PDuchar>& png);
+
+        /// Writes an image to a PNG file; returns false and sets the error if it cannot be written.
+        PD_CALL bool WritePNG(const PDstring& file, const PDuchar* pixels, PDuint width, PDuint height);
+
+        /// Writes the pixels of an image to a file as they are, without a header.
+        PD_CALL bool WriteRaw(const PDstring& file, const PDuchar* pixels, PDuint width, PDuint height);
+    }
+}
+
+#endif /* DEWPSI_IMAGEWRITER_H */
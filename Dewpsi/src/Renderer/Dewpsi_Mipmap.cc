@@ -0,0 +1,192 @@
+#include "Dewpsi_Mipmap.h"
+#include "Dewpsi_Log.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Dewpsi {
+
+// Shape of the Kaiser window; higher values trade sharpness for less ringing
+static constexpr float _KaiserAlpha = 4.0f;
+
+// Half-width of the windowed sinc in destination texels
+static constexpr float _KaiserRadius = 3.0f;
+
+static constexpr float _Pi = 3.14159265358979f;
+
+// One source texel contributing to a destination texel
+struct FilterTap {
+    PDuint index;
+    float weight;
+};
+
+// Modified Bessel function of the first kind, order zero
+static float BesselI0(float x)
+{
+    float fSum = 1.0f, fTerm = 1.0f;
+    const float fHalf = x * 0.5f;
+    for (PDuint k = 1; k < 32; ++k)
+    {
+        fTerm *= (fHalf / k) * (fHalf / k);
+        fSum += fTerm;
+        if (fTerm < fSum * 1e-7f)
+            break;
+    }
+    return fSum;
+}
+
+static float Sinc(float x)
+{
+    if (std::fabs(x) < 1e-5f)
+        return 1.0f;
+    x *= _Pi;
+    return std::sin(x) / x;
+}
+
+static float Kaiser(float x)
+{
+    if (x <= -1.0f || x >= 1.0f)
+        return 0.0f;
+    return BesselI0(_KaiserAlpha * std::sqrt(1.0f - x * x)) / BesselI0(_KaiserAlpha);
+}
+
+/* Computes the taps of every destination texel along one axis. taps[offsets[i]..offsets[i+1]]
+   are the taps of destination texel i; their weights add up to one. */
+static void BuildTaps(PDuint srcSize, PDuint dstSize, MipmapFilter filter,
+    std::vector<FilterTap>& taps, std::vector<PDuint>& offsets)
+{
+    const float fScale = (float) srcSize / dstSize;
+    taps.clear();
+    offsets.assign(1, 0);
+
+    for (PDuint x = 0; x < dstSize; ++x)
+    {
+        const PDsizei szFirst = taps.size();
+        float fTotal = 0.0f;
+
+        if (filter == MipmapFilter::Kaiser)
+        {
+            const float fCenter = (x + 0.5f) * fScale;
+            const float fSupport = _KaiserRadius * fScale;
+            const int iStart = (int) std::floor(fCenter - fSupport);
+            const int iEnd = (int) std::ceil(fCenter + fSupport);
+            for (int i = iStart; i < iEnd; ++i)
+            {
+                const float fDist = (i + 0.5f - fCenter) / fScale;
+                const float fWeight = Sinc(fDist) * Kaiser(fDist / _KaiserRadius);
+                if (fWeight == 0.0f)
+                    continue;
+
+                // Clamp to the edge
+                const PDuint uIndex = (PDuint) std::min(std::max(i, 0), (int) srcSize - 1);
+                taps.push_back({uIndex, fWeight});
+                fTotal += fWeight;
+            }
+        }
+        else
+        {
+            // Every source texel is weighted by how much of it the destination texel covers
+            const float fStart = x * fScale;
+            const float fEnd = fStart + fScale;
+            for (PDuint i = (PDuint) fStart; i < srcSize && i < fEnd; ++i)
+            {
+                const float fWeight = std::min(fEnd, i + 1.0f) - std::max(fStart, (float) i);
+                if (fWeight <= 0.0f)
+                    continue;
+                taps.push_back({i, fWeight});
+                fTotal += fWeight;
+            }
+        }
+
+        for (PDsizei i = szFirst; i < taps.size(); ++i)
+            taps[i].weight /= fTotal;
+        offsets.push_back((PDuint) taps.size());
+    }
+}
+
+PDuint Mipmap::GetLevelCount(PDuint width, PDuint height)
+{
+    PDuint uSize = std::max(width, height);
+    PDuint uLevels = 1;
+    while (uSize > 1)
+    {
+        uSize >>= 1;
+        ++uLevels;
+    }
+    return uLevels;
+}
+
+void Mipmap::Downsample(const PDuchar* src, PDuint width, PDuint height, PDuint channels,
+    PDuchar* dst, MipmapFilter filter)
+{
+    PD_CORE_ASSERT(filter == MipmapFilter::Box || filter == MipmapFilter::Kaiser,
+        "Only box and Kaiser filters run on the CPU");
+
+    const PDuint uDstWidth = GetLevelSize(width, 1);
+    const PDuint uDstHeight = GetLevelSize(height, 1);
+
+    std::vector<FilterTap> xTaps, yTaps;
+    std::vector<PDuint> xOffsets, yOffsets;
+    BuildTaps(width, uDstWidth, filter, xTaps, xOffsets);
+    BuildTaps(height, uDstHeight, filter, yTaps, yOffsets);
+
+    // Horizontal pass into a float image of uDstWidth by height
+    std::vector<float> rows((PDsizei) uDstWidth * height * channels);
+    for (PDuint y = 0; y < height; ++y)
+    {
+        const PDuchar* ucpRow = src + (PDsizei) y * width * channels;
+        float* fpOut = rows.data() + (PDsizei) y * uDstWidth * channels;
+        for (PDuint x = 0; x < uDstWidth; ++x)
+        {
+            for (PDuint c = 0; c < channels; ++c)
+            {
+                float fSum = 0.0f;
+                for (PDuint t = xOffsets[x]; t < xOffsets[x + 1]; ++t)
+                    fSum += ucpRow[xTaps[t].index * channels + c] * xTaps[t].weight;
+                fpOut[x * channels + c] = fSum;
+            }
+        }
+    }
+
+    // Vertical pass; the sinc can overshoot, so the result is clamped
+    const PDsizei szStride = (PDsizei) uDstWidth * channels;
+    for (PDuint y = 0; y < uDstHeight; ++y)
+    {
+        PDuchar* ucpOut = dst + y * szStride;
+        for (PDsizei i = 0; i < szStride; ++i)
+        {
+            float fSum = 0.0f;
+            for (PDuint t = yOffsets[y]; t < yOffsets[y + 1]; ++t)
+                fSum += rows[yTaps[t].index * szStride + i] * yTaps[t].weight;
+            ucpOut[i] = (PDuchar) std::min(std::max(fSum + 0.5f, 0.0f), 255.0f);
+        }
+    }
+}
+
+PDuint Mipmap::BuildChain(const PDuchar* base, PDuint width, PDuint height, PDuint channels,
+    MipmapFilter filter, std::vector<PDuchar>& chain)
+{
+    const PDuint uLevels = GetLevelCount(width, height);
+
+    PDsizei szTotal = 0;
+    for (PDuint i = 1; i < uLevels; ++i)
+        szTotal += (PDsizei) GetLevelSize(width, i) * GetLevelSize(height, i) * channels;
+    chain.resize(szTotal);
+
+    // Each level is filtered from the one above it
+    const PDuchar* ucpSource = base;
+    PDuchar* ucpDest = chain.data();
+    for (PDuint i = 1; i < uLevels; ++i)
+    {
+        const PDuint uWidth = GetLevelSize(width, i - 1);
+        const PDuint uHeight = GetLevelSize(height, i - 1);
+        Downsample(ucpSource, uWidth, uHeight, channels, ucpDest, filter);
+
+        ucpSource = ucpDest;
+        ucpDest += (PDsizei) GetLevelSize(width, i) * GetLevelSize(height, i) * channels;
+    }
+
+    return uLevels;
+}
+
+}
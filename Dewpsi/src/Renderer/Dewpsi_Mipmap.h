@@ -0,0 +1,54 @@
+#ifndef DEWPSI_MIPMAP_H
+#define DEWPSI_MIPMAP_H
+
+/** @file Dewpsi_Mipmap.h
+*   @ref core_renderer_textures
+*/
+
+#include <Dewpsi_Core.h>
+#include <vector>
+
+namespace Dewpsi {
+    /// How the smaller levels of a texture's mip chain are built.
+    /// @ingroup core_renderer_textures
+    enum class MipmapFilter {
+        None,   ///< No mip chain; the texture has a single level
+        GPU,    ///< Generated by the rendering API
+        Box,    ///< Box filter on the CPU
+        Kaiser  ///< Kaiser-windowed sinc on the CPU; keeps more detail than a box filter
+    };
+
+    /// CPU generation of mip chains.
+    /// @ingroup core_renderer_textures
+    namespace Mipmap {
+        /// Returns the number of levels in a full mip chain of a @a width by @a height image.
+        PD_CALL PDuint GetLevelCount(PDuint width, PDuint height);
+
+        /// Returns the size of a dimension of size @a size at the given level.
+        inline PDuint GetLevelSize(PDuint size, PDuint level)
+        {
+            size >>= level;
+            return size ? size : 1;
+        }
+
+        /** Halves an image with the given filter.
+        *   @param src       Tightly packed pixels with @a channels 8-bit channels
+        *   @param width     The width of @a src
+        *   @param height    The height of @a src
+        *   @param channels  The number of channels per pixel
+        *   @param dst       Receives the result, GetLevelSize(width, 1) by GetLevelSize(height, 1)
+        *   @param filter    MipmapFilter::Box or MipmapFilter::Kaiser
+        */
+        PD_CALL void Downsample(const PDuchar* src, PDuint width, PDuint height, PDuint channels,
+            PDuchar* dst, MipmapFilter filter);
+
+        /** Builds every level of the mip chain below @a base.
+        *   The levels are stored back to back in @a chain, starting with level 1.
+        *   @return The number of levels, including the base level
+        */
+        PD_CALL PDuint BuildChain(const PDuchar* base, PDuint width, PDuint height, PDuint channels,
+            MipmapFilter filter, std::vector<PDuchar>& chain);
+    }
+}
+
+#endif /* DEWPSI_MIPMAP_H */
@@ -0,0 +1,403 @@
+#include "Dewpsi_ParticleSystem.h"
+#include "Dewpsi_Renderer.h"
+#include "Dewpsi_RenderCommand.h"
+#include "Dewpsi_RenderThread.h"
+#include "Dewpsi_Shader.h"
+#include "Dewpsi_VertexArray.h"
+#include "Dewpsi_Log.h"
+#include <algorithm>
+
+#ifdef __SSE2__
+    #include <emmintrin.h>
+    #define PD_PARTICLES_SSE2
+#endif
+
+// GCC and Clang can compile AVX functions without enabling AVX for the whole library
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+    #define PD_PARTICLES_AVX
+#endif
+
+namespace Dewpsi {
+
+static const char* _VertexShaderSource = R"(
+    layout(location = 0) in vec3 in_Position;
+    layout(location = 1) in vec3 in_Offset;
+    layout(location = 2) in float in_Scale;
+    layout(location = 3) in vec4 in_Color;
+
+    out vec4 v_Color;
+
+    void main() {
+        v_Color = in_Color;
+        gl_Position = u_ViewProjection * vec4(in_Position * in_Scale + in_Offset, 1.0);
+    }
+)";
+
+static const char* _FragmentShaderSource = R"(
+    in vec4 v_Color;
+    out vec4 FragColor;
+
+    void main() {
+        FragColor = v_Color;
+    }
+)";
+
+// Widest register of the kernels, in floats; streams are padded to it so the last block needs no tail loop
+static constexpr PDuint32 _Lanes = 8;
+
+struct ParticleData {
+    Ref<Shader> shader;
+    Ref<VertexBuffer> quadVertices;
+};
+
+// Created by the first draw
+static ParticleData* _Data = nullptr;
+
+static ParticleData& GetData()
+{
+    if (_Data)
+        return *_Data;
+    _Data = new ParticleData;
+
+    const float faQuad[] = {
+        -0.5f, -0.5f, 0.0f,
+         0.5f, -0.5f, 0.0f,
+         0.5f,  0.5f, 0.0f,
+        -0.5f,  0.5f, 0.0f
+    };
+    _Data->quadVertices = VertexBuffer::Create(sizeof(faQuad));
+    _Data->quadVertices->SetData(faQuad, sizeof(faQuad));
+    _Data->quadVertices->SetLayout({
+        {ShaderDataType::Float3, "in_Position"}
+    });
+
+    _Data->shader = Renderer::CreateShader(_VertexShaderSource, _FragmentShaderSource);
+
+    // Logged here rather than by the constructor, which may run before the logger is initialized
+    PD_CORE_TRACE("ParticleSystem updates with {0}", ParticleSystem::GetInstructionSet());
+    return *_Data;
+}
+
+/* Applies gravity to the velocity, then the velocity to the position, and ages particles [0, count).
+   Lanes up to count rounded up to the register width are updated as well; they are padding. */
+typedef void (*IntegrateFunction)(float* x, float* y, float* vx, float* vy, float* age, const float* rate,
+    PDuint32 count, float dt, float gx, float gy);
+
+// Returns the first particle in [begin, count) whose age reached 1, or count if there is none
+typedef PDuint32 (*FindDeadFunction)(const float* age, PDuint32 begin, PDuint32 count);
+
+static void IntegrateScalar(float* x, float* y, float* vx, float* vy, float* age, const float* rate,
+    PDuint32 count, float dt, float gx, float gy)
+{
+    for (PDuint32 i = 0; i < count; ++i)
+    {
+        vx[i] += gx * dt;
+        vy[i] += gy * dt;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        age[i] += rate[i] * dt;
+    }
+}
+
+static PDuint32 FindDeadScalar(const float* age, PDuint32 begin, PDuint32 count)
+{
+    for (PDuint32 i = begin; i < count; ++i)
+    {
+        if (age[i] >= 1.0f)
+            return i;
+    }
+    return count;
+}
+
+#ifdef PD_PARTICLES_SSE2
+static void IntegrateSSE2(float* x, float* y, float* vx, float* vy, float* age, const float* rate,
+    PDuint32 count, float dt, float gx, float gy)
+{
+    const __m128 vDt = _mm_set1_ps(dt);
+    const __m128 vGx = _mm_set1_ps(gx * dt), vGy = _mm_set1_ps(gy * dt);
+    for (PDuint32 i = 0; i < count; i += 4)
+    {
+        const __m128 vVx = _mm_add_ps(_mm_loadu_ps(vx + i), vGx);
+        const __m128 vVy = _mm_add_ps(_mm_loadu_ps(vy + i), vGy);
+        _mm_storeu_ps(vx + i, vVx);
+        _mm_storeu_ps(vy + i, vVy);
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(vVx, vDt)));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(vVy, vDt)));
+        _mm_storeu_ps(age + i, _mm_add_ps(_mm_loadu_ps(age + i), _mm_mul_ps(_mm_loadu_ps(rate + i), vDt)));
+    }
+}
+
+static PDuint32 FindDeadSSE2(const float* age, PDuint32 begin, PDuint32 count)
+{
+    // Whole registers from the one holding begin, so no load runs past the padding
+    const __m128 vOne = _mm_set1_ps(1.0f);
+    PDuint uSkip = begin % 4;
+    for (PDuint32 i = begin - uSkip; i < count; i += 4)
+    {
+        const PDuint uMask = (PDuint) _mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(age + i), vOne)) >> uSkip << uSkip;
+        if (uMask)
+            return std::min(i + (PDuint32) __builtin_ctz(uMask), count);
+        uSkip = 0;
+    }
+    return count;
+}
+#endif
+
+#ifdef PD_PARTICLES_AVX
+__attribute__((target("avx")))
+static void IntegrateAVX(float* x, float* y, float* vx, float* vy, float* age, const float* rate,
+    PDuint32 count, float dt, float gx, float gy)
+{
+    const __m256 vDt = _mm256_set1_ps(dt);
+    const __m256 vGx = _mm256_set1_ps(gx * dt), vGy = _mm256_set1_ps(gy * dt);
+    for (PDuint32 i = 0; i < count; i += 8)
+    {
+        const __m256 vVx = _mm256_add_ps(_mm256_loadu_ps(vx + i), vGx);
+        const __m256 vVy = _mm256_add_ps(_mm256_loadu_ps(vy + i), vGy);
+        _mm256_storeu_ps(vx + i, vVx);
+        _mm256_storeu_ps(vy + i, vVy);
+        _mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(vVx, vDt)));
+        _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(vVy, vDt)));
+        _mm256_storeu_ps(age + i,
+            _mm256_add_ps(_mm256_loadu_ps(age + i), _mm256_mul_ps(_mm256_loadu_ps(rate + i), vDt)));
+    }
+    _mm256_zeroupper();
+}
+
+__attribute__((target("avx")))
+static PDuint32 FindDeadAVX(const float* age, PDuint32 begin, PDuint32 count)
+{
+    const __m256 vOne = _mm256_set1_ps(1.0f);
+    PDuint32 uiDead = count;
+    PDuint uSkip = begin % 8;
+    for (PDuint32 i = begin - uSkip; i < count; i += 8)
+    {
+        const PDuint uMask = (PDuint) _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(age + i), vOne, _CMP_GE_OQ))
+            >> uSkip << uSkip;
+        if (uMask)
+        {
+            uiDead = std::min(i + (PDuint32) __builtin_ctz(uMask), count);
+            break;
+        }
+        uSkip = 0;
+    }
+    _mm256_zeroupper();
+    return uiDead;
+}
+#endif
+
+static IntegrateFunction _Integrate = nullptr;
+static FindDeadFunction _FindDead = nullptr;
+static const char* _InstructionSet = "scalar";
+
+static void SelectKernels()
+{
+    if (_Integrate)
+        return;
+
+    _Integrate = IntegrateScalar;
+    _FindDead = FindDeadScalar;
+#ifdef PD_PARTICLES_SSE2
+    _Integrate = IntegrateSSE2;
+    _FindDead = FindDeadSSE2;
+    _InstructionSet = "SSE2";
+#endif
+#ifdef PD_PARTICLES_AVX
+    if (__builtin_cpu_supports("avx"))
+    {
+        _Integrate = IntegrateAVX;
+        _FindDead = FindDeadAVX;
+        _InstructionSet = "AVX";
+    }
+#endif
+}
+
+const char* ParticleSystem::GetInstructionSet()
+{
+    SelectKernels();
+    return _InstructionSet;
+}
+
+void ParticleSystem::Shutdown()
+{
+    delete _Data;
+    _Data = nullptr;
+}
+
+ParticleSystem::ParticleSystem(PDuint32 maxParticles)
+    : m_MaxParticles(maxParticles), m_Stride((maxParticles + _Lanes - 1) / _Lanes * _Lanes),
+      m_Data((PDsizei) m_Stride * StreamCount, 0.0f)
+{
+    SelectKernels();
+}
+
+ParticleSystem::~ParticleSystem()
+{
+    // A recorded frame may still draw from the buffers
+    RenderThread::Release(m_VertexArray);
+    RenderThread::Release(m_InstanceBuffer);
+}
+
+float ParticleSystem::Random()
+{
+    // xorshift32; the top 24 bits become a float in [0, 1)
+    m_Seed ^= m_Seed << 13;
+    m_Seed ^= m_Seed >> 17;
+    m_Seed ^= m_Seed << 5;
+    return (float) (m_Seed >> 8) * (1.0f / 16777216.0f);
+}
+
+void ParticleSystem::Emit(const ParticleProps& props, PDuint32 count)
+{
+    PD_CORE_ASSERT(props.lifeTime > 0.0f, "Particles must live for some time");
+    count = std::min(count, m_MaxParticles - m_Count);
+
+    float* x = GetStream(PositionX);
+    float* y = GetStream(PositionY);
+    float* vx = GetStream(VelocityX);
+    float* vy = GetStream(VelocityY);
+    float* age = GetStream(Age);
+    float* rate = GetStream(AgeRate);
+    float* sizeBegin = GetStream(SizeBegin);
+    float* sizeEnd = GetStream(SizeEnd);
+    for (PDuint32 n = 0; n < count; ++n)
+    {
+        const PDuint32 i = m_Count++;
+        x[i] = props.position.x;
+        y[i] = props.position.y;
+        vx[i] = props.velocity.x + props.velocityVariation.x * (Random() - 0.5f);
+        vy[i] = props.velocity.y + props.velocityVariation.y * (Random() - 0.5f);
+        age[i] = 0.0f;
+        rate[i] = 1.0f / props.lifeTime;
+        sizeBegin[i] = props.sizeBegin + props.sizeVariation * (Random() - 0.5f);
+        sizeEnd[i] = props.sizeEnd;
+        for (PDuint c = 0; c < 4; ++c)
+        {
+            GetStream((Stream) (ColorBegin + c))[i] = props.colorBegin[c];
+            GetStream((Stream) (ColorEnd + c))[i] = props.colorEnd[c];
+        }
+    }
+}
+
+void ParticleSystem::OnUpdate(Timestep ts)
+{
+    if (! m_Count)
+        return;
+
+    float* age = GetStream(Age);
+    _Integrate(GetStream(PositionX), GetStream(PositionY), GetStream(VelocityX), GetStream(VelocityY),
+        age, GetStream(AgeRate), m_Count, ts.GetSeconds(), m_Gravity.x, m_Gravity.y);
+
+    // Swap-remove: the last particle moves into the hole, and is checked in turn
+    PDuint32 i = 0;
+    while ((i = _FindDead(age, i, m_Count)) < m_Count)
+    {
+        const PDuint32 uiLast = --m_Count;
+        for (PDuint s = 0; s < StreamCount; ++s)
+        {
+            float* stream = &m_Data[(PDsizei) s * m_Stride];
+            stream[i] = stream[uiLast];
+        }
+    }
+}
+
+void ParticleSystem::WriteInstances(Instance* instances) const
+{
+    const float* x = GetStream(PositionX);
+    const float* y = GetStream(PositionY);
+    const float* age = GetStream(Age);
+    const float* sizeBegin = GetStream(SizeBegin);
+    const float* sizeEnd = GetStream(SizeEnd);
+    const float* colorBegin[4], *colorEnd[4];
+    for (PDuint c = 0; c < 4; ++c)
+    {
+        colorBegin[c] = GetStream((Stream) (ColorBegin + c));
+        colorEnd[c] = GetStream((Stream) (ColorEnd + c));
+    }
+
+    for (PDuint32 i = 0; i < m_Count; ++i)
+    {
+        const float t = age[i];
+        Instance& instance = instances[i];
+        instance.offset = glm::vec3(x[i], y[i], 0.0f);
+        instance.scale = sizeBegin[i] + (sizeEnd[i] - sizeBegin[i]) * t;
+        for (PDuint c = 0; c < 4; ++c)
+            instance.color[c] = colorBegin[c][i] + (colorEnd[c][i] - colorBegin[c][i]) * t;
+    }
+}
+
+// Uploads @a count instances written by @a write and draws them
+template<typename F>
+static void DrawInstances(StreamBuffer& buffer, const Ref<VertexArray>& vertexArray, PDuint32 count,
+    const glm::mat4& viewProjection, F&& write)
+{
+    const PDsizei szSize = (PDsizei) count * sizeof(ParticleSystem::Instance);
+    void* instances = buffer.Map(szSize, sizeof(ParticleSystem::Instance));
+    if (! instances)
+    {
+        PD_CORE_WARN("Particle instances do not fit the stream buffer");
+        return;
+    }
+    write((ParticleSystem::Instance*) instances);
+    buffer.Unmap();
+
+    Renderer::SetCamera(viewProjection);
+    if (! GetData().shader->Bind())
+        return;
+    vertexArray->Bind();
+    // Each instance is the first quad of the shared indices; an index count of 0 would draw all of them
+    RenderCommand::DrawIndexedInstanced(vertexArray, count, 6,
+        (PDuint32) (buffer.GetMappedOffset() / sizeof(ParticleSystem::Instance)));
+
+    // Every draw gets a region of its own, so the GPU never reads what the next one writes
+    buffer.NextFrame();
+}
+
+void ParticleSystem::Draw(const OrthoCamera& camera)
+{
+    if (! m_Count)
+        return;
+
+    if (! m_VertexArray)
+    {
+        RenderThread::Call([this]{
+            m_InstanceBuffer = StreamBuffer::Create((PDsizei) m_MaxParticles * sizeof(Instance));
+            m_InstanceBuffer->SetLayout(BufferLayout({
+                {ShaderDataType::Float3, "in_Offset"},
+                {ShaderDataType::Float,  "in_Scale"},
+                {ShaderDataType::Float4, "in_Color"}
+            }, 1));
+
+            m_VertexArray = VertexArray::Create();
+            m_VertexArray->Bind();
+            m_VertexArray->AddVertexBuffer(GetData().quadVertices);
+            m_VertexArray->AddVertexBuffer(m_InstanceBuffer);
+            m_VertexArray->SetIndexBuffer(Renderer::GetQuadIndexBuffer());
+            m_VertexArray->UnBind();
+        });
+    }
+
+    RenderCommand::BeginPass("Particles");
+    if (RenderThread::IsRecording())
+    {
+        // The particles move on before the render thread gets to them
+        std::vector<Instance> instances(m_Count);
+        WriteInstances(instances.data());
+        RenderThread::Enqueue([buffer = m_InstanceBuffer, vertexArray = m_VertexArray,
+            viewProjection = camera.GetViewProjectionMatrix(), instances = PD_MOVE(instances)]{
+            DrawInstances(*buffer, vertexArray, (PDuint32) instances.size(), viewProjection,
+                [&instances](Instance* dest) {
+                    std::copy(instances.begin(), instances.end(), dest);
+                });
+        });
+    }
+    else
+    {
+        DrawInstances(*m_InstanceBuffer, m_VertexArray, m_Count, camera.GetViewProjectionMatrix(),
+            [this](Instance* dest) { WriteInstances(dest); });
+    }
+    RenderCommand::EndPass();
+}
+
+}
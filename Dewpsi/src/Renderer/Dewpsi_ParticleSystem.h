@@ -0,0 +1,132 @@
+#ifndef DEWPSI_PARTICLESYSTEM_H
+#define DEWPSI_PARTICLESYSTEM_H
+
+/** @file Dewpsi_ParticleSystem.h
+*   @ref core_renderer
+*/
+
+#include <Dewpsi_Core.h>
+#include <Dewpsi_Memory.h>
+#include <Dewpsi_Timestep.h>
+#include <Dewpsi_OrthoCamera.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Dewpsi {
+    class StreamBuffer;
+    class VertexArray;
+
+    /// How new particles are spawned by ParticleSystem::Emit().
+    struct ParticleProps {
+        glm::vec2 position = glm::vec2(0.0f);
+        glm::vec2 velocity = glm::vec2(0.0f);
+        glm::vec2 velocityVariation = glm::vec2(0.0f);  ///< Random spread added to the velocity, +/- half of it
+        glm::vec4 colorBegin = glm::vec4(1.0f);
+        glm::vec4 colorEnd = glm::vec4(1.0f, 1.0f, 1.0f, 0.0f);
+        float sizeBegin = 0.1f;
+        float sizeEnd = 0.0f;
+        float sizeVariation = 0.0f;     ///< Random spread added to the size at birth, +/- half of it
+        float lifeTime = 1.0f;          ///< Seconds a particle lives
+    };
+
+    /** An emitter of particles drawn as colored squares.
+    *   Particles are kept as a structure of arrays (all x positions, then all y positions, ...),
+    *   so OnUpdate() moves 4 or 8 of them per instruction with SSE2 or AVX, picked at run time.
+    *   A particle that dies is replaced by the last one, so the live particles are always the
+    *   first GetCount() and nothing has to be skipped. Draw() writes one instance per particle
+    *   into a StreamBuffer and draws them all with a single instanced draw call.
+    *
+    *   @code{.cpp}
+        // In OnAttach()
+        m_Particles = Dewpsi::CreateScope<Dewpsi::ParticleSystem>(20000);
+        m_Smoke.velocityVariation = {1.0f, 1.0f};
+
+        // In OnUpdate()
+        m_Smoke.position = m_EmitterPosition;
+        m_Particles->Emit(m_Smoke, 10);
+        m_Particles->OnUpdate(ts);
+        m_Particles->Draw(m_CameraController.GetCamera());
+    *   @endcode
+    *   @ingroup core_renderer
+    */
+    class ParticleSystem {
+    public:
+        /// What a particle is drawn with: a unit quad scaled by @c scale and moved to @c offset.
+        struct Instance {
+            glm::vec3 offset;
+            float scale;
+            glm::vec4 color;
+        };
+
+        /** Creates an emitter. Its buffers are created by the first Draw(), so a system that
+        *   is never drawn can be simulated without a renderer.
+        *   @param maxParticles  The most particles alive at once; Emit() drops the rest
+        */
+        explicit ParticleSystem(PDuint32 maxParticles = 10000);
+        ~ParticleSystem();
+
+        ParticleSystem(const ParticleSystem&) = delete;
+        ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+        /// Spawns @a count particles.
+        void Emit(const ParticleProps& props, PDuint32 count = 1);
+
+        /// Ages and moves every particle, and removes the ones that died.
+        void OnUpdate(Timestep ts);
+
+        /// Draws every particle; uses its own shader, so call it outside of Renderer2D scenes.
+        void Draw(const OrthoCamera& camera);
+
+        /** Writes the instance of every live particle to @a instances, which has room for
+        *   GetCount() of them; this is what Draw() uploads.
+        */
+        void WriteInstances(Instance* instances) const;
+
+        /// Sets the acceleration applied to every particle, in units per second squared.
+        void SetGravity(const glm::vec2& gravity) {m_Gravity = gravity;}
+
+        /// Removes every particle.
+        void Clear() {m_Count = 0;}
+
+        /// Returns the number of live particles.
+        PDuint32 GetCount() const {return m_Count;}
+
+        /// Returns the most particles alive at once.
+        PDuint32 GetMaxParticles() const {return m_MaxParticles;}
+
+        /// Returns the instruction set OnUpdate() uses: "AVX", "SSE2" or "scalar".
+        static const char* GetInstructionSet();
+
+        /// Destroys the quad and shader created by the first Draw(); called by Renderer::Shutdown().
+        static void Shutdown();
+
+    private:
+        // The arrays in m_Data, each m_Stride floats long
+        enum Stream {
+            PositionX, PositionY,
+            VelocityX, VelocityY,
+            Age,                    // 0 at birth, 1 at death
+            AgeRate,                // 1 / life time
+            SizeBegin, SizeEnd,
+            ColorBegin,             // 4 streams: r, g, b, a
+            ColorEnd = ColorBegin + 4,
+            StreamCount = ColorEnd + 4
+        };
+
+        float* GetStream(Stream stream) {return &m_Data[(PDsizei) stream * m_Stride];}
+        const float* GetStream(Stream stream) const {return &m_Data[(PDsizei) stream * m_Stride];}
+        float Random();
+
+        PDuint32 m_MaxParticles;
+        PDuint32 m_Stride;      // m_MaxParticles rounded up to whole SIMD registers
+        PDuint32 m_Count = 0;
+        std::vector<float> m_Data;
+        glm::vec2 m_Gravity = glm::vec2(0.0f);
+        PDuint32 m_Seed = 0x9E3779B9u;
+
+        Ref<StreamBuffer> m_InstanceBuffer;
+        Ref<VertexArray> m_VertexArray;
+    };
+}
+
+#endif /* DEWPSI_PARTICLESYSTEM_H */
@@ -1,10 +1,16 @@
 #include "Dewpsi_WhichOS.h"
 #include "Dewpsi_RenderCommand.h"
 #include "Dewpsi_Except.h"
+#include <mutex>
 
 namespace Dewpsi {
 
 RendererAPI* RenderCommand::s_RenderingAPI = nullptr;
+RendererAPI::Statistics RenderCommand::s_Frame = {};
+RendererAPI::Statistics RenderCommand::s_Stats = {};
+
+// Guards s_Stats, which the render thread writes while the main thread reads it
+static std::mutex _StatsMutex;
 
 void RenderCommand::Init()
 {
@@ -12,15 +18,58 @@ void RenderCommand::Init()
 
     switch (RendererAPI::GetAPI())
     {
+        case RendererAPI::API::None:
+            s_RenderingAPI = new NullRendererAPI;
+            break;
+
         case RendererAPI::API::OpenGL:
             s_RenderingAPI = new OpenGLRendererAPI;
             break;
 
+        case RendererAPI::API::Software:
+            s_RenderingAPI = new SoftwareRendererAPI;
+            break;
+
         default:
             throw DewpsiError("Unrecognized API");
     }
 
+    s_Frame = s_Stats = {};
     s_RenderingAPI->Init();
 }
 
+void RenderCommand::BeginFrame()
+{
+    if (RenderThread::IsRecording())
+    {
+        RenderThread::Enqueue([]{ BeginFrame(); });
+        return;
+    }
+
+    s_RenderingAPI->BeginFrame();
+
+    RendererAPI::Statistics stats = PD_MOVE(s_Frame);
+    s_Frame = {};
+    s_RenderingAPI->GetFrameStats(stats);
+
+    std::lock_guard<std::mutex> lock(_StatsMutex);
+    s_Stats = PD_MOVE(stats);
+}
+
+RendererAPI::Statistics RenderCommand::GetStats()
+{
+    std::lock_guard<std::mutex> lock(_StatsMutex);
+    return s_Stats;
+}
+
+void RenderCommand::Shutdown()
+{
+    if (s_RenderingAPI)
+    {
+        s_RenderingAPI->Shutdown();
+        delete s_RenderingAPI;
+        s_RenderingAPI = nullptr;
+    }
+}
+
 }
@@ -4,33 +4,132 @@
 #include <Dewpsi_Memory.h>
 #include <Dewpsi_Color.h>
 #include <Dewpsi_RendererAPI.h>
+#include <Dewpsi_RenderThread.h>
 
 namespace Dewpsi {
+    /*
+    Every call is recorded for the render thread when it is running (see RenderThread), and
+    reaches the rendering API right away otherwise.
+    */
     class RenderCommand {
     public:
         /// Initialize the rendering API.
         static void Init();
 
+        /// Shut down the rendering API.
+        static void Shutdown();
+
+        /// Prepares the rendering API for a new frame and completes the statistics of the last one.
+        static void BeginFrame();
+
         /// Sets the clear color.
         static void SetClearColor(const Color& color)
         {
-            s_RenderingAPI->SetClearColor(color);
+            if (RenderThread::IsRecording())
+                RenderThread::Enqueue([color]{ s_RenderingAPI->SetClearColor(color); });
+            else
+                s_RenderingAPI->SetClearColor(color);
         }
 
         /// Clears the buffers.
         static void Clear()
         {
-            s_RenderingAPI->Clear();
+            if (RenderThread::IsRecording())
+                RenderThread::Enqueue([]{ s_RenderingAPI->Clear(); });
+            else
+                s_RenderingAPI->Clear();
+        }
+
+        /// Draws the given vertex array, or only its first @a indexCount indices.
+        static void DrawIndexed(const Ref<VertexArray>& vertexArray, PDuint32 indexCount = 0)
+        {
+            if (RenderThread::IsRecording())
+            {
+                RenderThread::Enqueue([vertexArray, indexCount]{ DrawIndexed(vertexArray, indexCount); });
+                return;
+            }
+
+            CountDraw(vertexArray, 1, indexCount);
+            s_RenderingAPI->DrawIndexed(vertexArray, indexCount);
+        }
+
+        /// Draws @a instanceCount instances of the given vertex array; see RendererAPI::DrawIndexedInstanced().
+        static void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, PDuint32 instanceCount,
+            PDuint32 indexCount = 0, PDuint32 baseInstance = 0)
+        {
+            if (RenderThread::IsRecording())
+            {
+                RenderThread::Enqueue([vertexArray, instanceCount, indexCount, baseInstance]{
+                    DrawIndexedInstanced(vertexArray, instanceCount, indexCount, baseInstance);
+                });
+                return;
+            }
+
+            CountDraw(vertexArray, instanceCount, indexCount);
+            s_RenderingAPI->DrawIndexedInstanced(vertexArray, instanceCount, indexCount, baseInstance);
+        }
+
+        /// Draws the first @a vertexCount vertices of the given vertex array; see RendererAPI::DrawArrays().
+        static void DrawArrays(const Ref<VertexArray>& vertexArray, PDuint32 vertexCount,
+            RendererAPI::PrimitiveType type = RendererAPI::PrimitiveType::Triangles)
+        {
+            if (RenderThread::IsRecording())
+            {
+                RenderThread::Enqueue([vertexArray, vertexCount, type]{ DrawArrays(vertexArray, vertexCount, type); });
+                return;
+            }
+
+            CountDraw(1, vertexCount, type);
+            s_RenderingAPI->DrawArrays(vertexArray, vertexCount, type);
+        }
+
+        /** Starts timing a render pass on the GPU; see RendererAPI::BeginPass().
+        *   With the render thread running, @a name must stay valid until the frame is rendered,
+        *   which a string literal does.
+        */
+        static void BeginPass(const char* name)
+        {
+            if (RenderThread::IsRecording())
+                RenderThread::Enqueue([name]{ s_RenderingAPI->BeginPass(name); });
+            else
+                s_RenderingAPI->BeginPass(name);
         }
 
-        /// Draws the given vertex array.
-        static void DrawIndexed(const Ref<VertexArray>& vertexArray)
+        /// Ends the pass started by BeginPass().
+        static void EndPass()
         {
-            s_RenderingAPI->DrawIndexed(vertexArray);
+            if (RenderThread::IsRecording())
+                RenderThread::Enqueue([]{ s_RenderingAPI->EndPass(); });
+            else
+                s_RenderingAPI->EndPass();
         }
 
+        /// Returns the counters of the previous frame; safe to call while the render thread runs.
+        static RendererAPI::Statistics GetStats();
+
     private:
+        // Counts a draw of @a count vertices per instance, assembled into primitives of @a type
+        static void CountDraw(PDuint32 instanceCount, PDuint64 count, RendererAPI::PrimitiveType type)
+        {
+            ++s_Frame.drawCalls;
+            s_Frame.instances += instanceCount;
+            if (type == RendererAPI::PrimitiveType::Lines)
+                s_Frame.lines += (count / 2) * instanceCount;
+            else
+                s_Frame.triangles += (count / 3) * instanceCount;
+        }
+
+        // Indexed draws count their indices too; an @a indexCount of 0 is the whole index buffer
+        static void CountDraw(const Ref<VertexArray>& vertexArray, PDuint32 instanceCount, PDuint32 indexCount)
+        {
+            const PDuint64 uiCount = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+            s_Frame.indices += uiCount * instanceCount;
+            CountDraw(instanceCount, uiCount, RendererAPI::PrimitiveType::Triangles);
+        }
+
         static RendererAPI* s_RenderingAPI;
+        static RendererAPI::Statistics s_Frame; // counters of the frame in progress
+        static RendererAPI::Statistics s_Stats; // counters of the previous frame
     };
 }
 
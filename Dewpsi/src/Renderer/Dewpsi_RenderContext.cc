@@ -1,10 +1,18 @@
 #include "Dewpsi_RenderContext.h"
+#include "Dewpsi_RendererAPI.h"
 #include "Dewpsi_OpenGLContext.h"
+#include "Dewpsi_NullContext.h"
+#include "Dewpsi_SoftwareContext.h"
 
 namespace Dewpsi {
 
 Scope<RenderContext> RenderContext::Create(void* window)
 {
+    if (RendererAPI::GetAPI() == RendererAPI::API::None)
+        return CreateScope<NullContext>();
+    if (RendererAPI::GetAPI() == RendererAPI::API::Software)
+        return CreateScope<SoftwareContext>((SDL_Window*) window);
+
     return CreateScope<OpenGLContext>((SDL_Window*) window);
 }
 
@@ -30,6 +30,12 @@ namespace Dewpsi {
         /// Swap the frame buffers.
         virtual void SwapBuffers() = 0;
 
+        /// Makes the context current on the calling thread.
+        virtual void MakeCurrent() = 0;
+
+        /// Detaches the context from the calling thread, so another thread can make it current.
+        virtual void ReleaseCurrent() = 0;
+
         /// Create a new render context.
         static Scope<RenderContext> Create(void* window);
     };
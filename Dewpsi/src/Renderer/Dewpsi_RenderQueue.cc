@@ -0,0 +1,147 @@
+#include "Dewpsi_RenderQueue.h"
+#include "Dewpsi_CommandList.h"
+#include "Dewpsi_RenderCommand.h"
+#include "Dewpsi_Shader.h"
+#include "Dewpsi_Texture.h"
+
+namespace Dewpsi {
+
+static constexpr UniformId _TextureUniform("u_Texture");
+static constexpr UniformId _TransformUniform("u_Transform");
+
+PDuint64 RenderQueue::MakeKey(PDuint8 layer, PDuint shaderID, PDuint textureID, PDuint vertexArrayID)
+{
+    return (static_cast<PDuint64>(layer) << 56)
+        | (static_cast<PDuint64>(shaderID & 0xffff) << 40)
+        | (static_cast<PDuint64>(textureID & 0xfffff) << 20)
+        | static_cast<PDuint64>(vertexArrayID & 0xfffff);
+}
+
+void RenderQueue::Push(PDuint64 key, RenderQueueCommand&& command)
+{
+    m_Order.push_back(static_cast<PDuint32>(m_Commands.size()));
+    m_Keys.push_back(key);
+    m_Commands.push_back(PD_MOVE(command));
+}
+
+void RenderQueue::Merge(CommandList& list)
+{
+    const PDsizei szCount = list.m_Commands.size();
+    m_Keys.insert(m_Keys.end(), list.m_Keys.begin(), list.m_Keys.end());
+    m_Commands.reserve(m_Commands.size() + szCount);
+    for (RenderQueueCommand& command : list.m_Commands)
+    {
+        m_Order.push_back(static_cast<PDuint32>(m_Commands.size()));
+        m_Commands.push_back(PD_MOVE(command));
+    }
+    list.Clear();
+}
+
+void RenderQueue::Sort()
+{
+    const PDsizei szCount = m_Keys.size();
+    if (szCount < 2)
+        return;
+
+    m_KeyScratch.resize(szCount);
+    m_OrderScratch.resize(szCount);
+
+    // LSD radix sort, one byte per pass; stable, so equal keys keep their submission order
+    for (PDuint uShift = 0; uShift < 64; uShift += 8)
+    {
+        PDsizei counts[256] = {};
+        for (PDsizei i = 0; i < szCount; ++i)
+            ++counts[(m_Keys[i] >> uShift) & 0xff];
+
+        // Every key has the same byte here; the pass would not move anything
+        if (counts[(m_Keys[0] >> uShift) & 0xff] == szCount)
+            continue;
+
+        PDsizei szOffset = 0;
+        for (PDsizei& count : counts)
+        {
+            const PDsizei szTemp = count;
+            count = szOffset;
+            szOffset += szTemp;
+        }
+
+        for (PDsizei i = 0; i < szCount; ++i)
+        {
+            const PDsizei szDest = counts[(m_Keys[i] >> uShift) & 0xff]++;
+            m_KeyScratch[szDest] = m_Keys[i];
+            m_OrderScratch[szDest] = m_Order[i];
+        }
+
+        m_Keys.swap(m_KeyScratch);
+        m_Order.swap(m_OrderScratch);
+    }
+}
+
+void RenderQueue::Execute()
+{
+    const Shader* lastShader = nullptr;
+    const VertexArray* lastVertexArray = nullptr;
+    const Texture* lastTexture = nullptr;
+    PDuint lastSlot = 0;
+    PDuint32 uNaiveBinds = 0;
+    bool bShaderBound = false;
+
+    m_Stats = {};
+
+    for (PDuint32 index : m_Order)
+    {
+        RenderQueueCommand& cmd = m_Commands[index];
+
+        if (cmd.shader.get() != lastShader)
+        {
+            bShaderBound = cmd.shader->Bind();
+            lastShader = cmd.shader.get();
+            ++m_Stats.shaderBinds;
+        }
+
+        // A shader that failed to build has logged why; its draws are dropped
+        if (! bShaderBound)
+            continue;
+
+        if (cmd.texture)
+        {
+            if (cmd.texture.get() != lastTexture || cmd.slot != lastSlot)
+            {
+                cmd.texture->Bind(cmd.slot);
+                lastTexture = cmd.texture.get();
+                lastSlot = cmd.slot;
+                ++m_Stats.textureBinds;
+            }
+            cmd.shader->SetInt1(_TextureUniform, static_cast<PDint>(cmd.slot));
+            ++uNaiveBinds;
+        }
+
+        if (cmd.vertexArray.get() != lastVertexArray)
+        {
+            cmd.vertexArray->Bind();
+            lastVertexArray = cmd.vertexArray.get();
+            ++m_Stats.vertexArrayBinds;
+        }
+
+        cmd.shader->SetMat4(_TransformUniform, 1, &cmd.transform);
+        if (cmd.instanceCount)
+            RenderCommand::DrawIndexedInstanced(cmd.vertexArray, cmd.instanceCount);
+        else
+            RenderCommand::DrawIndexed(cmd.vertexArray);
+    }
+
+    m_Stats.commands = static_cast<PDuint32>(m_Order.size());
+
+    // Drawing in submission order binds the shader and vertex array of every draw
+    uNaiveBinds += m_Stats.commands * 2;
+    m_Stats.bindsSaved = uNaiveBinds - (m_Stats.shaderBinds + m_Stats.vertexArrayBinds + m_Stats.textureBinds);
+}
+
+void RenderQueue::Clear()
+{
+    m_Keys.clear();
+    m_Order.clear();
+    m_Commands.clear();
+}
+
+}
@@ -0,0 +1,95 @@
+#ifndef DEWPSI_RENDERQUEUE_H
+#define DEWPSI_RENDERQUEUE_H
+
+/** @file Dewpsi_RenderQueue.h
+*   @ref core_renderer
+*/
+
+#include <Dewpsi_Memory.h>
+#include <Dewpsi_VertexArray.h>
+#include <Dewpsi_OrthoCamera.h> // glm
+
+namespace Dewpsi {
+    class Shader;
+    class Texture;
+    class CommandList;
+
+    /// A draw recorded by Renderer::Submit().
+    struct RenderQueueCommand {
+        Ref<Shader> shader;             ///< Shader to draw with
+        Ref<VertexArray> vertexArray;   ///< Geometry to draw
+        Ref<Texture> texture;           ///< Optional texture, bound to @a slot
+        PDuint slot;                    ///< Texture unit of @a texture
+        glm::mat4 transform;            ///< Model transform
+        PDuint32 instanceCount;         ///< Number of instances, or zero for a plain draw
+    };
+
+    /** Per-frame queue of draw commands.
+    *   Every command is stored with a 64-bit sort key so that the queue can be
+    *   executed in an order that changes as little GPU state as possible:
+    *
+    *   Bits    | Field
+    *   ------- | -----------------------
+    *   63 - 56 | Layer
+    *   55 - 40 | Shader ID
+    *   39 - 20 | Texture ID
+    *   19 - 0  | Vertex array ID
+    *
+    *   The layer takes precedence over everything else, so draws on a higher layer
+    *   always come after draws on lower ones. Within a layer, the sort is stable, which
+    *   means draws with identical keys are executed in submission order.
+    *   @ingroup core_renderer
+    */
+    class RenderQueue {
+    public:
+        /// Statistics of the last call to Execute().
+        struct Statistics {
+            PDuint32 commands;          ///< Number of draws executed
+            PDuint32 shaderBinds;       ///< Number of shader binds issued
+            PDuint32 vertexArrayBinds;  ///< Number of vertex array binds issued
+            PDuint32 textureBinds;      ///< Number of texture binds issued
+            PDuint32 bindsSaved;        ///< Binds skipped compared to drawing in submission order
+        };
+
+        RenderQueue() = default;
+
+        /// Builds a sort key out of the given state.
+        static PDuint64 MakeKey(PDuint8 layer, PDuint shaderID, PDuint textureID, PDuint vertexArrayID);
+
+        /// Records a command with the sort key @a key.
+        void Push(PDuint64 key, RenderQueueCommand&& command);
+
+        /** Moves the commands of @a list behind the recorded ones and clears the list.
+        *   The keys were built when the list was recorded.
+        */
+        void Merge(CommandList& list);
+
+        /// Sorts the recorded commands by their keys.
+        void Sort();
+
+        /** Executes the commands in sorted order.
+        *   State that is already bound from the previous command is not bound again.
+        *   Sort() must be called beforehand.
+        */
+        void Execute();
+
+        /// Removes all commands; the memory is kept for the next frame.
+        void Clear();
+
+        /// Returns the number of recorded commands.
+        PDsizei GetSize() const {return m_Commands.size();}
+
+        /// Returns the statistics of the last execution.
+        const Statistics& GetStats() const {return m_Stats;}
+
+    private:
+        std::vector<PDuint64> m_Keys;
+        std::vector<PDuint64> m_KeyScratch;
+        std::vector<PDuint32> m_Order;
+        std::vector<PDuint32> m_OrderScratch;
+        std::vector<RenderQueueCommand> m_Commands;
+        Statistics m_Stats = {};
+    };
+}
+
+#endif /* DEWPSI_RENDERQUEUE_H */
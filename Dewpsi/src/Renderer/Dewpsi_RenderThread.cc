@@ -0,0 +1,197 @@
+#include "Dewpsi_RenderThread.h"
+#include "Dewpsi_RenderContext.h"
+#include "Dewpsi_Log.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace Dewpsi {
+
+// =================================================
+// RenderCommandStream
+
+void* RenderCommandStream::Allocate(PDsizei size, PDsizei alignment)
+{
+    for (;;)
+    {
+        if (m_Block < m_Blocks.size())
+        {
+            Block& block = m_Blocks[m_Block];
+            const std::uintptr_t uiBase = (std::uintptr_t) block.memory.get();
+            const std::uintptr_t uiAddress = (uiBase + m_Offset + alignment - 1) & ~(std::uintptr_t) (alignment - 1);
+            const PDsizei szOffset = (PDsizei) (uiAddress - uiBase);
+            if (szOffset + size <= block.size)
+            {
+                m_Offset = szOffset + size;
+                return (void*) uiAddress;
+            }
+
+            // A used block is left for the next one; an empty block is too small for this command
+            if (m_Offset)
+            {
+                ++m_Block;
+                m_Offset = 0;
+                continue;
+            }
+        }
+
+        const PDsizei szSize = (size + alignment > BlockSize) ? size + alignment : BlockSize;
+        Block block = {std::unique_ptr<PDuchar[]>(new PDuchar[szSize]), szSize};
+        if (m_Block < m_Blocks.size())
+            m_Blocks.insert(m_Blocks.begin() + (std::ptrdiff_t) m_Block, PD_MOVE(block));
+        else
+            m_Blocks.push_back(PD_MOVE(block));
+    }
+}
+
+void RenderCommandStream::Execute()
+{
+    // A command may record another one when it runs on the render thread; that one runs at once
+    for (Entry* entry = m_Head; entry; )
+    {
+        Entry* next = entry->next;
+        entry->Run();
+        entry->~Entry();
+        entry = next;
+    }
+    Reset();
+}
+
+void RenderCommandStream::Clear()
+{
+    for (Entry* entry = m_Head; entry; )
+    {
+        Entry* next = entry->next;
+        entry->~Entry();
+        entry = next;
+    }
+    Reset();
+}
+
+void RenderCommandStream::Reset()
+{
+    m_Head = m_Tail = nullptr;
+    m_Count = 0;
+    m_Block = 0;
+    m_Offset = 0;
+}
+
+// =================================================
+// RenderThread
+
+static RenderCommandStream _Streams[2];
+static PDuint _Recording = 0;           // stream of the main thread; the other one belongs to the render thread
+static bool _FrameReady = false;        // the render thread has a frame to render
+static bool _Stop = false;
+static std::atomic<bool> _Running(false);
+static std::thread _Thread;
+static std::thread::id _ThreadID;
+static RenderContext* _Context = nullptr;
+static std::mutex _Mutex;
+static std::condition_variable _Wake;   // a frame is ready, or the thread must stop
+static std::condition_variable _Done;   // a frame has been rendered
+
+static void ThreadMain()
+{
+    _Context->MakeCurrent();
+
+    std::unique_lock<std::mutex> lock(_Mutex);
+    for (;;)
+    {
+        _Wake.wait(lock, []{ return _FrameReady || _Stop; });
+        if (! _FrameReady)
+            break;
+
+        // The main thread does not touch this stream until the frame is marked as done
+        RenderCommandStream& stream = _Streams[_Recording ^ 1];
+        lock.unlock();
+        stream.Execute();
+        lock.lock();
+
+        _FrameReady = false;
+        _Done.notify_all();
+    }
+
+    _Context->ReleaseCurrent();
+}
+
+void RenderThread::Start(RenderContext& context)
+{
+    PD_CORE_ASSERT(! _Running, "Render thread already running");
+    if (_Running)
+        return;
+
+    context.ReleaseCurrent();
+    _Context = &context;
+    _Recording = 0;
+    _FrameReady = false;
+    _Stop = false;
+
+    _Thread = std::thread(ThreadMain);
+    _ThreadID = _Thread.get_id();
+    _Running = true;
+    PD_CORE_TRACE("Started the render thread");
+}
+
+void RenderThread::Stop()
+{
+    if (! _Running)
+        return;
+
+    EndFrame();
+    {
+        std::unique_lock<std::mutex> lock(_Mutex);
+        _Done.wait(lock, []{ return ! _FrameReady; });
+        _Stop = true;
+    }
+    _Wake.notify_one();
+    _Thread.join();
+
+    _Running = false;
+    _ThreadID = std::thread::id();
+    _Context->MakeCurrent();
+    _Context = nullptr;
+    PD_CORE_TRACE("Stopped the render thread");
+}
+
+bool RenderThread::IsRunning()
+{
+    return _Running;
+}
+
+bool RenderThread::IsRenderThread()
+{
+    return std::this_thread::get_id() == _ThreadID;
+}
+
+void RenderThread::EndFrame()
+{
+    if (! IsRecording())
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock(_Mutex);
+        _Done.wait(lock, []{ return ! _FrameReady; });
+        _Recording ^= 1;
+        _FrameReady = true;
+    }
+    _Wake.notify_one();
+}
+
+void RenderThread::Wait()
+{
+    if (! IsRecording())
+        return;
+
+    std::unique_lock<std::mutex> lock(_Mutex);
+    _Done.wait(lock, []{ return ! _FrameReady; });
+}
+
+RenderCommandStream& RenderThread::GetStream()
+{
+    return _Streams[_Recording];
+}
+
+}
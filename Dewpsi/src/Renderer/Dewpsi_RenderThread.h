@@ -0,0 +1,190 @@
+#ifndef DEWPSI_RENDERTHREAD_H
+#define DEWPSI_RENDERTHREAD_H
+
+/** @file Dewpsi_RenderThread.h
+*   @ref core_renderer
+*/
+
+#include <Dewpsi_Core.h>
+#include <Dewpsi_Memory.h>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Dewpsi {
+    class RenderContext;
+
+    /** Commands recorded for one frame of the render thread.
+    *   Commands are stored in large blocks so that recording one is a bump of a pointer and
+    *   a recorded command never moves. Clearing the stream keeps its blocks for the next frame.
+    *   A stream is not synchronized; RenderThread hands it from one thread to the other.
+    *   @ingroup core_renderer
+    */
+    class RenderCommandStream {
+    public:
+        /// Size of a block; larger commands get a block of their own.
+        static constexpr PDsizei BlockSize = 64 * 1024;
+
+        RenderCommandStream() = default;
+        RenderCommandStream(const RenderCommandStream&) = delete;
+        RenderCommandStream& operator=(const RenderCommandStream&) = delete;
+        ~RenderCommandStream() {Clear();}
+
+        /// Records @a command, a callable taking no arguments.
+        template<typename F>
+        void Push(F&& command)
+        {
+            using Command = Record<typename std::decay<F>::type>;
+            Entry* entry = new (Allocate(sizeof(Command), alignof(Command))) Command(std::forward<F>(command));
+            if (m_Tail)
+                m_Tail->next = entry;
+            else
+                m_Head = entry;
+            m_Tail = entry;
+            ++m_Count;
+        }
+
+        /// Runs every command in the order they were recorded, then clears the stream.
+        void Execute();
+
+        /// Destroys every command without running it.
+        void Clear();
+
+        /// Returns the number of recorded commands.
+        PDsizei GetSize() const {return m_Count;}
+
+    private:
+        struct Entry {
+            Entry* next = nullptr;
+            virtual ~Entry() = default;
+            virtual void Run() = 0;
+        };
+
+        template<typename C>
+        struct Record : Entry {
+            C command;
+
+            template<typename G>
+            explicit Record(G&& g) : command(std::forward<G>(g)) {}
+            virtual void Run() override {command();}
+        };
+
+        struct Block {
+            std::unique_ptr<PDuchar[]> memory;
+            PDsizei size;
+        };
+
+        void* Allocate(PDsizei size, PDsizei alignment);
+        void Reset();
+
+        std::vector<Block> m_Blocks;
+        PDsizei m_Block = 0;    // block being filled
+        PDsizei m_Offset = 0;   // first free byte in that block
+        Entry* m_Head = nullptr;
+        Entry* m_Tail = nullptr;
+        PDsizei m_Count = 0;
+    };
+
+    /** Optional thread that renders a frame while the main thread simulates the next one.
+    *   Once started, the render thread owns the rendering context. Calls to RenderCommand,
+    *   Renderer and Renderer2D made on the main thread are recorded into a command stream
+    *   instead of reaching the rendering API. EndFrame() hands the stream of frame N to the
+    *   render thread and the main thread goes on recording frame N+1 into the other one; it
+    *   only waits when the render thread has not finished frame N-1 yet. Start it with
+    *   Application::SetRenderThread().
+    *
+    *   Events are polled and dispatched on the main thread. The ImGui layer builds its frame
+    *   on the main thread as well, and hands a copy of the draw data to the render thread;
+    *   ImGui viewports are disabled in this mode.
+    *
+    *   Any other use of the rendering API must go through Enqueue(): resources such as
+    *   shaders, textures and vertex arrays are created before the thread starts (e.g. in
+    *   OnAttach()) or by an enqueued command, and uniforms are set by an enqueued command.
+    *   Resources captured by a command are kept alive until it has run; use Release() to drop
+    *   the last reference to a resource, so it is destroyed on the render thread.
+    *
+    *   @code{.cpp}
+        glm::vec4 color = m_Color;
+        Dewpsi::RenderThread::Enqueue([shader = m_Shader, color]{
+            shader->Bind();
+            shader->SetFloat4(Dewpsi::UniformId("u_Color"), color);
+        });
+    *   @endcode
+    *   @ingroup core_renderer
+    */
+    class RenderThread {
+    public:
+        /** Starts the render thread, which makes @a context current on itself.
+        *   Must be called on the thread the context is current on.
+        */
+        static void Start(RenderContext& context);
+
+        /** Runs the commands recorded so far, stops the thread and makes the context current
+        *   on the calling thread again. Does nothing if the thread is not running.
+        */
+        static void Stop();
+
+        /// Returns true if the render thread is running.
+        static bool IsRunning();
+
+        /// Returns true if the calling thread is the render thread.
+        static bool IsRenderThread();
+
+        /// Returns true if calls on this thread are recorded rather than executed.
+        static bool IsRecording() {return IsRunning() && ! IsRenderThread();}
+
+        /** Records @a command for the render thread, or runs it right away if the calling
+        *   thread may use the rendering API (the thread is not running, or this is the render
+        *   thread). Commands run in the order they were recorded.
+        */
+        template<typename F>
+        static void Enqueue(F&& command)
+        {
+            if (IsRecording())
+                GetStream().Push(std::forward<F>(command));
+            else
+                command();
+        }
+
+        /** Runs @a command on the render thread and waits until it has run.
+        *   The commands recorded before it run first. This stalls the pipeline, so it is meant
+        *   for rare work whose result is needed right away, such as creating a resource.
+        */
+        template<typename F>
+        static void Call(F&& command)
+        {
+            Enqueue(std::forward<F>(command));
+            if (IsRecording())
+            {
+                EndFrame();
+                Wait();
+            }
+        }
+
+        /// Drops @a resource on the render thread, where the last reference is released.
+        template<typename T>
+        static void Release(Ref<T>& resource)
+        {
+            if (resource)
+                Enqueue([dropped = PD_MOVE(resource)]{});
+            resource = nullptr;
+        }
+
+        /** Hands the commands of this frame to the render thread.
+        *   Waits until the previous frame has been rendered first, so the main thread is never
+        *   more than one frame ahead.
+        */
+        static void EndFrame();
+
+        /// Waits until every frame handed to the render thread has been rendered.
+        static void Wait();
+
+    private:
+        /// Returns the stream being recorded on the main thread.
+        static RenderCommandStream& GetStream();
+    };
+}
+
+#endif /* DEWPSI_RENDERTHREAD_H */
@@ -1,32 +1,169 @@
 #include "Dewpsi_Renderer.h"
+#include "Dewpsi_Renderer2D.h"
+#include "Dewpsi_Tilemap.h"
+#include "Dewpsi_ParticleSystem.h"
+#include "Dewpsi_DebugDraw.h"
 #include "Dewpsi_Shader.h"
 #include "Dewpsi_OpenGLShader.h"
 #include "Dewpsi_Texture.h"
+#include "Dewpsi_FrameCapture.h"
+#include "Dewpsi_CommandList.h"
+#include <algorithm>
+#include <mutex>
 
 namespace Dewpsi {
 
 Scope<Renderer::SceneData> Renderer::s_SceneData = CreateScope<Renderer::SceneData>();
 
+// Guards the submitted command lists, which may come from any thread
+static std::mutex _ListMutex;
+
+// Guards the queue statistics, written by the render thread when it is running
+static std::mutex _StatsMutex;
+
 void Renderer::Init()
 {
     RenderCommand::Init();
+    s_SceneData->cameraBuffer = UniformBuffer::Create(sizeof(CameraData), CameraBinding);
+
+    // Shared by every quad batcher; 16-bit indices are half the size of 32-bit ones
+    {
+        Scope<PDuint16[]> quadIndices = CreateScope<PDuint16[]>(MaxSharedQuads * 6);
+        for (PDuint32 i = 0; i < MaxSharedQuads; ++i)
+        {
+            PDuint16* indices = &quadIndices[i * 6];
+            indices[0] = (PDuint16) (i * 4 + 0);
+            indices[1] = (PDuint16) (i * 4 + 1);
+            indices[2] = (PDuint16) (i * 4 + 2);
+            indices[3] = (PDuint16) (i * 4 + 2);
+            indices[4] = (PDuint16) (i * 4 + 3);
+            indices[5] = (PDuint16) (i * 4 + 0);
+        }
+        s_SceneData->quadIndexBuffer = IndexBuffer::Create16(MaxSharedQuads * 6, quadIndices.get());
+    }
+
+    Renderer2D::Init();
+    DebugDraw::Init();
+}
+
+void Renderer::Shutdown()
+{
+    DebugDraw::Shutdown();
+    ParticleSystem::Shutdown();
+    Tilemap::Shutdown();
+    Renderer2D::Shutdown();
+    s_SceneData->quadIndexBuffer.reset();
+    s_SceneData->cameraBuffer.reset();
+    RenderCommand::Shutdown();
+    FrameCapture::Shutdown();
 }
 
 void Renderer::BeginScene(OrthoCamera& camera)
 {
-    s_SceneData->viewProjectionMatrix = camera.GetViewProjectionMatrix();
+    s_SceneData->camera.viewProjectionMatrix = camera.GetViewProjectionMatrix();
+    s_SceneData->queue.Clear();
+    s_SceneData->layer = 0;
+
+    std::lock_guard<std::mutex> lock(_ListMutex);
+    s_SceneData->lists.clear();
+}
+
+void Renderer::EndScene()
+{
+    RenderQueue& queue = s_SceneData->queue;
+    {
+        // Stable, so lists with the same order keep the order they were submitted in
+        std::lock_guard<std::mutex> lock(_ListMutex);
+        std::vector<CommandList*>& lists = s_SceneData->lists;
+        std::stable_sort(lists.begin(), lists.end(), [](const CommandList* a, const CommandList* b) {
+            return a->GetOrder() < b->GetOrder();
+        });
+        for (CommandList* list : lists)
+            queue.Merge(*list);
+        lists.clear();
+    }
+
+    // Sorting stays on this thread; the render thread gets the queue ready to execute
+    queue.Sort();
+    if (RenderThread::IsRecording())
+    {
+        RenderThread::Enqueue([scene = PD_MOVE(queue), camera = s_SceneData->camera]() mutable {
+            ExecuteScene(scene, camera);
+        });
+        s_SceneData->queue = RenderQueue();
+        return;
+    }
+
+    ExecuteScene(queue, s_SceneData->camera);
+    queue.Clear();
+}
+
+void Renderer::SetCamera(const glm::mat4& viewProjection)
+{
+    PD_CORE_ASSERT(! RenderThread::IsRecording(), "The camera is set on the render thread");
+    const CameraData camera = {viewProjection};
+    s_SceneData->cameraBuffer->SetData(&camera, sizeof(CameraData));
+    s_SceneData->cameraBuffer->Bind();
+}
+
+Ref<Shader> Renderer::CreateShader(const char* vertexSource, const char* fragmentSource)
+{
+    static const PDstring _Version = "#version 430 core\n";
+    static const PDstring _CameraBlock =
+        "layout(std140, binding = " + std::to_string(CameraBinding) + ") uniform Camera {\n"
+        "    mat4 u_ViewProjection;\n"
+        "};\n";
+    return Shader::Create(_Version + _CameraBlock + vertexSource, _Version + fragmentSource);
 }
 
-void Renderer::EndScene() {}
+void Renderer::ExecuteScene(RenderQueue& queue, const CameraData& camera)
+{
+    SetCamera(camera.viewProjectionMatrix);
+    RenderCommand::BeginPass("Scene");
+    queue.Execute();
+    RenderCommand::EndPass();
+
+    std::lock_guard<std::mutex> lock(_StatsMutex);
+    s_SceneData->queueStats = queue.GetStats();
+}
+
+RenderQueue::Statistics Renderer::GetQueueStats()
+{
+    std::lock_guard<std::mutex> lock(_StatsMutex);
+    return s_SceneData->queueStats;
+}
 
 void Renderer::Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray,
     const glm::mat4& transform)
 {
-    shader->Bind();
-    vertexArray->Bind();
-    shader->SetMat4("u_ViewProjection", 1, &s_SceneData->viewProjectionMatrix);
-    shader->SetMat4("u_Transform", 1, &transform);
-    RenderCommand::DrawIndexed(vertexArray);
+    const PDuint64 key = RenderQueue::MakeKey(s_SceneData->layer, shader->GetRendererID(), 0,
+        vertexArray->GetRendererID());
+    s_SceneData->queue.Push(key, {shader, vertexArray, nullptr, 0, transform, 0});
+}
+
+void Renderer::Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray,
+    const Ref<Texture>& texture, PDuint slot, const glm::mat4& transform)
+{
+    const PDuint64 key = RenderQueue::MakeKey(s_SceneData->layer, shader->GetRendererID(),
+        texture->GetRendererID(), vertexArray->GetRendererID());
+    s_SceneData->queue.Push(key, {shader, vertexArray, texture, slot, transform, 0});
+}
+
+void Renderer::Submit(CommandList& list)
+{
+    std::lock_guard<std::mutex> lock(_ListMutex);
+    s_SceneData->lists.push_back(&list);
+}
+
+void Renderer::SubmitInstanced(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray,
+    PDuint32 instanceCount, const glm::mat4& transform)
+{
+    if (! instanceCount)
+        return;
+
+    const PDuint64 key = RenderQueue::MakeKey(s_SceneData->layer, shader->GetRendererID(), 0,
+        vertexArray->GetRendererID());
+    s_SceneData->queue.Push(key, {shader, vertexArray, nullptr, 0, transform, instanceCount});
 }
 
 }
@@ -8,11 +8,14 @@
 
 #include <Dewpsi_Memory.h>
 #include <Dewpsi_RenderCommand.h>
+#include <Dewpsi_RenderQueue.h>
+#include <Dewpsi_UniformBuffer.h>
 #include <Dewpsi_OrthoCamera.h> // glm
 
 namespace Dewpsi {
     class Shader;
     class Texture;
+    class CommandList;
 
     /** High-level rendering interface.
     *   This class interprets high-level data constructs from
@@ -22,21 +25,97 @@ namespace Dewpsi {
     */
     class Renderer {
     public:
+        /** Binding point of the @c Camera uniform block.
+        *   Shaders receive the view projection matrix of the scene by declaring:
+        *   @code{.glsl}
+            layout(std140, binding = 0) uniform Camera {
+                mat4 u_ViewProjection;
+            };
+        *   @endcode
+        */
+        static constexpr PDuint CameraBinding = 0;
+
+        /// Quads covered by GetQuadIndexBuffer(), as many as 16-bit indices can reach.
+        static constexpr PDuint32 MaxSharedQuads = 65536 / 4;
+
         /// Initialize the renderer.
         static void Init();
 
+        /// Free the resources held by the renderer.
+        static void Shutdown();
+
         /// Begins a scene for the view @a camera.
         static void BeginScene(OrthoCamera& camera);
 
-        /// Ends a previously begun scene.
+        /** Ends a previously begun scene.
+        *   Everything submitted since BeginScene() is sorted by layer, shader, texture
+        *   and vertex array, then drawn.
+        */
         static void EndScene();
 
-        /// Submits a vertex array to the render queue.
+        /** Submits a vertex array to the render queue.
+        *   Nothing is drawn until EndScene(); the shader receives the @c Camera
+        *   block (see CameraBinding) and the uniform @c u_Transform.
+        */
         static void Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray,
             const glm::mat4& transform = glm::mat4(1.0f));
 
-        /*static void Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray,
-            const Ref<Texture>& texture, PDuint slot, const glm::mat4& transform = glm::mat4(1.0f));*/
+        /** Submits a textured vertex array to the render queue.
+        *   @a texture is bound to @a slot and the sampler @c u_Texture is set to @a slot.
+        */
+        static void Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray,
+            const Ref<Texture>& texture, PDuint slot, const glm::mat4& transform = glm::mat4(1.0f));
+
+        /** Submits @a instanceCount instances of a vertex array to the render queue.
+        *   The vertex array should have at least one instanced vertex buffer, see BufferLayout.
+        *   @a transform applies to every instance.
+        */
+        static void SubmitInstanced(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray,
+            PDuint32 instanceCount, const glm::mat4& transform = glm::mat4(1.0f));
+
+        /** Submits the draws recorded in @a list; may be called from any thread.
+        *   EndScene() moves the commands of every submitted list into the render queue, in the
+        *   order of CommandList::GetOrder(), behind the draws submitted directly. The list must
+        *   not be changed or destroyed until then.
+        */
+        static void Submit(CommandList& list);
+
+        /** Sets the layer of subsequent submissions.
+        *   Lower layers are drawn first. The layer is reset to 0 by BeginScene().
+        */
+        static void SetLayer(PDuint8 layer) {s_SceneData->layer = layer;}
+
+        /// Counters of a frame: draws, state changes and GPU time per pass.
+        using Stats = RendererAPI::Statistics;
+
+        /** Returns the counters of the previous frame.
+        *   Draws and state changes cover everything rendered through RenderCommand, ImGui
+        *   excluded. GPU times are read back without stalling, so they lag a frame or two behind.
+        */
+        static Stats GetStats() {return RenderCommand::GetStats();}
+
+        /** Uploads @a viewProjection into the @c Camera block and binds it to CameraBinding.
+        *   The block is shared by every shader; renderers that draw outside of the render queue
+        *   set their camera with this before drawing. Like every call into the rendering API, it
+        *   must not be made while the render thread is recording (see RenderThread::Enqueue()).
+        */
+        static void SetCamera(const glm::mat4& viewProjection);
+
+        /** Creates a shader from GLSL sources without a version directive.
+        *   <tt>\#version 430 core</tt> is put in front of both; the vertex shader also gets the
+        *   @c Camera block. Meant for the renderers built into the engine.
+        */
+        static Ref<Shader> CreateShader(const char* vertexSource, const char* fragmentSource);
+
+        /** Returns the index buffer of MaxSharedQuads quads, created once by Init().
+        *   Quad @c i is made of the vertices <tt>4i</tt> to <tt>4i + 3</tt>, counter-clockwise,
+        *   as the triangles (0, 1, 2) and (2, 3, 0). Batchers that write four vertices per quad
+        *   share it instead of generating their own; draw the first <tt>6 * quads</tt> indices.
+        */
+        static const Ref<IndexBuffer>& GetQuadIndexBuffer() {return s_SceneData->quadIndexBuffer;}
+
+        /// Returns the statistics of the render queue of the last scene that was rendered.
+        static RenderQueue::Statistics GetQueueStats();
 
         /// Sets the current rendering API.
         static void SetAPI(RendererAPI::API api) {RendererAPI::SetAPI(api);}
@@ -45,10 +124,24 @@ namespace Dewpsi {
         static RendererAPI::API GetAPI() {return RendererAPI::GetAPI();}
 
     private:
-        struct SceneData {
+        // Mirrors the std140 Camera block
+        struct CameraData {
             glm::mat4 viewProjectionMatrix;
         };
 
+        struct SceneData {
+            CameraData camera;
+            Ref<UniformBuffer> cameraBuffer;
+            Ref<IndexBuffer> quadIndexBuffer;
+            RenderQueue queue;
+            RenderQueue::Statistics queueStats = {};
+            std::vector<CommandList*> lists;
+            PDuint8 layer = 0;
+        };
+
+        // Uploads the camera and executes a sorted queue
+        static void ExecuteScene(RenderQueue& queue, const CameraData& camera);
+
         static Scope<SceneData> s_SceneData;
     };
 
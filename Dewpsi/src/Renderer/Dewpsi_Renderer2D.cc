@@ -1,56 +1,457 @@
 #include "Dewpsi_Renderer2D.h"
+#include "Dewpsi_Renderer.h"
 #include "Dewpsi_Memory.h"
 #include "Dewpsi_VertexArray.h"
-
-#if 0
+#include "Dewpsi_Array.h"
+#include "Dewpsi_RenderThread.h"
+#include <glm/gtc/packing.hpp>
+#include <vector>
 
 namespace Dewpsi {
 
-struct Render2DSceneData {
-    Ref<Shader> shader;
-    Ref<VertexArray> vertexArray;
+static const char* _VertexShaderSource = R"(
+    layout(location = 0) in vec3 in_Position;
+    layout(location = 1) in vec4 in_Color;
+    layout(location = 2) in vec2 in_TexCoord;
+    layout(location = 3) in float in_TexIndex;
+    layout(location = 4) in float in_Tiling;
 
-    Render2DSceneData() : shader(nullptr), vertexArray(nullptr) {}
+    out vec4 v_Color;
+    out vec2 v_TexCoord;
+    flat out int v_TexIndex;
 
-    ~Render2DSceneData()
-    {
-        delete shader;
-        delete vertexArray;
+    void main() {
+        v_Color = in_Color;
+        v_TexCoord = in_TexCoord * in_Tiling;
+        v_TexIndex = int(in_TexIndex);
+        gl_Position = u_ViewProjection * vec4(in_Position, 1.0);
+    }
+)";
+
+// Sampler arrays may only be indexed with dynamically uniform expressions,
+// so the texture is picked with a switch instead of u_Textures[v_TexIndex].
+static const char* _FragmentShaderSource = R"(
+    in vec4 v_Color;
+    in vec2 v_TexCoord;
+    flat in int v_TexIndex;
+    uniform sampler2D u_Textures[16];
+    out vec4 FragColor;
+
+    void main() {
+        vec4 texColor = v_Color;
+        switch (v_TexIndex)
+        {
+            case  0: texColor *= texture(u_Textures[ 0], v_TexCoord); break;
+            case  1: texColor *= texture(u_Textures[ 1], v_TexCoord); break;
+            case  2: texColor *= texture(u_Textures[ 2], v_TexCoord); break;
+            case  3: texColor *= texture(u_Textures[ 3], v_TexCoord); break;
+            case  4: texColor *= texture(u_Textures[ 4], v_TexCoord); break;
+            case  5: texColor *= texture(u_Textures[ 5], v_TexCoord); break;
+            case  6: texColor *= texture(u_Textures[ 6], v_TexCoord); break;
+            case  7: texColor *= texture(u_Textures[ 7], v_TexCoord); break;
+            case  8: texColor *= texture(u_Textures[ 8], v_TexCoord); break;
+            case  9: texColor *= texture(u_Textures[ 9], v_TexCoord); break;
+            case 10: texColor *= texture(u_Textures[10], v_TexCoord); break;
+            case 11: texColor *= texture(u_Textures[11], v_TexCoord); break;
+            case 12: texColor *= texture(u_Textures[12], v_TexCoord); break;
+            case 13: texColor *= texture(u_Textures[13], v_TexCoord); break;
+            case 14: texColor *= texture(u_Textures[14], v_TexCoord); break;
+            case 15: texColor *= texture(u_Textures[15], v_TexCoord); break;
+        }
+        FragColor = texColor;
     }
+)";
+
+// A single vertex of a batched quad; the color is packed to RGBA8, 32 bytes instead of 44.
+struct QuadVertex {
+    glm::vec3 position;
+    PDuint32 color;
+    glm::vec2 texCoord;
+    float texIndex;
+    float tiling;
+};
+
+struct Renderer2DData {
+    // Per-batch limits; 16 texture units is the minimum OpenGL guarantees
+    static constexpr PDuint32 MaxQuads = 10000;
+    static constexpr PDuint32 MaxVertices = MaxQuads * 4;
+    static constexpr PDuint32 MaxIndices = MaxQuads * 6;
+    static_assert(MaxQuads <= Renderer::MaxSharedQuads, "A batch must fit the shared quad indices");
+    static constexpr PDuint32 MaxTextureSlots = 16;
+
+    Ref<VertexArray> quadVertexArray;
+    Ref<VertexBuffer> quadVertexBuffer;
+    Ref<Shader> quadShader;
+    Ref<Texture2D> whiteTexture;
+    glm::mat4 viewProjection = glm::mat4(1.0f);
+
+    PDuint32 quadIndexCount = 0;
+    Scope<QuadVertex[]> quadVertexBufferBase;
+    QuadVertex* quadVertexBufferPtr = nullptr;
+
+    Array<Ref<Texture2D>, MaxTextureSlots> textureSlots;
+    PDuint32 textureSlotIndex = 1; // 0 = white texture
+
+    Renderer2D::Statistics stats = {0, 0};
 };
 
-static Render2DSceneData* _Data = nullptr;
+static Renderer2DData* _Data = nullptr;
+
+static const glm::vec2 _TexCoords[4] = {
+    {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}
+};
 
 void Renderer2D::Init()
 {
-    _Data = new Render2DSceneData;
-    _Data->vertexArray = VertexArray::Create();
+    PD_CORE_ASSERT(! _Data, "Renderer2D already initialized");
+    _Data = new Renderer2DData;
+
+    _Data->quadVertexArray = VertexArray::Create();
+    _Data->quadVertexArray->Bind();
+
+    _Data->quadVertexBuffer = VertexBuffer::Create(Renderer2DData::MaxVertices * sizeof(QuadVertex));
+    _Data->quadVertexBuffer->SetLayout({
+        {ShaderDataType::Float3, "in_Position"},
+        {ShaderDataType::UByte4Norm, "in_Color"},
+        {ShaderDataType::Float2, "in_TexCoord"},
+        {ShaderDataType::Float,  "in_TexIndex"},
+        {ShaderDataType::Float,  "in_Tiling"}
+    });
+    _Data->quadVertexArray->AddVertexBuffer(_Data->quadVertexBuffer);
+    _Data->quadVertexBufferBase = CreateScope<QuadVertex[]>(Renderer2DData::MaxVertices);
 
+    _Data->quadVertexArray->SetIndexBuffer(Renderer::GetQuadIndexBuffer());
+    _Data->quadVertexArray->UnBind();
+
+    // Untextured quads sample a white pixel from slot 0
     {
-        const float faVertices[] = {
-           -0.5f,  0.0f, 0.0f,
-           -0.5f, -0.5f, 0.0f,
-            0.5f, -0.5f, 0.0f,
-           -0.5f,  0.5f, 0.0f
-        };
+        const PDuint32 uiWhite = 0xffffffff;
+        _Data->whiteTexture = Texture2D::Create(1, 1);
+        _Data->whiteTexture->SetData(&uiWhite, sizeof(uiWhite));
+        _Data->textureSlots[0] = _Data->whiteTexture;
+    }
+
+    {
+        PDint iaSamplers[Renderer2DData::MaxTextureSlots];
+        for (PDuint32 i = 0; i < Renderer2DData::MaxTextureSlots; ++i)
+            iaSamplers[i] = (PDint) i;
+
+        _Data->quadShader = Renderer::CreateShader(_VertexShaderSource, _FragmentShaderSource);
+        _Data->quadShader->Bind();
+        _Data->quadShader->SetIntArray(UniformId("u_Textures"), iaSamplers, Renderer2DData::MaxTextureSlots);
+    }
+
+    PD_CORE_TRACE("Initialized Renderer2D");
+}
+
+void Renderer2D::Shutdown()
+{
+    delete _Data;
+    _Data = nullptr;
+}
+
+void Renderer2D::BeginScene(const OrthoCamera& camera)
+{
+    _Data->viewProjection = camera.GetViewProjectionMatrix();
+    StartBatch();
+}
 
-        Ref<VertexBuffer> vbo(VertexBuffer::Create(sizeof(faVertices), faVertices));
-        vbo->SetLayout({
-            ShaderDataType::Float3, "A_Position"
+void Renderer2D::EndScene()
+{
+    Flush();
+}
+
+void Renderer2D::StartBatch()
+{
+    _Data->quadIndexCount = 0;
+    _Data->quadVertexBufferPtr = _Data->quadVertexBufferBase.get();
+    _Data->textureSlotIndex = 1;
+}
+
+void Renderer2D::NextBatch()
+{
+    Flush();
+    StartBatch();
+}
+
+// Uploads and draws one batch
+static void DrawBatch(const QuadVertex* vertices, PDsizei vertexCount, const Ref<Texture2D>* textures,
+    PDuint32 textureCount, PDuint32 indexCount, const glm::mat4& viewProjection)
+{
+    RenderCommand::BeginPass("Renderer2D");
+    _Data->quadVertexBuffer->SetData(vertices, vertexCount * sizeof(QuadVertex));
+
+    for (PDuint32 i = 0; i < textureCount; ++i)
+        textures[i]->Bind(i);
+
+    Renderer::SetCamera(viewProjection);
+    _Data->quadShader->Bind();
+    _Data->quadVertexArray->Bind();
+    RenderCommand::DrawIndexed(_Data->quadVertexArray, indexCount);
+    RenderCommand::EndPass();
+}
+
+void Renderer2D::Flush()
+{
+    if (! _Data->quadIndexCount)
+        return;
+
+    const QuadVertex* vertices = _Data->quadVertexBufferBase.get();
+    const PDsizei szVertexCount = (PDsizei) (_Data->quadVertexBufferPtr - vertices);
+    const Ref<Texture2D>* textures = &_Data->textureSlots[0];
+    if (RenderThread::IsRecording())
+    {
+        // The batch buffer is refilled before the render thread gets to it, so the batch is copied
+        RenderThread::Enqueue([batch = std::vector<QuadVertex>(vertices, vertices + szVertexCount),
+            slots = std::vector<Ref<Texture2D>>(textures, textures + _Data->textureSlotIndex),
+            indexCount = _Data->quadIndexCount, viewProjection = _Data->viewProjection]{
+            DrawBatch(batch.data(), batch.size(), slots.data(), (PDuint32) slots.size(), indexCount,
+                viewProjection);
         });
-        _Data->vertexArray->AddVertexBuffer(vbo);
     }
+    else
+    {
+        DrawBatch(vertices, szVertexCount, textures, _Data->textureSlotIndex, _Data->quadIndexCount,
+            _Data->viewProjection);
+    }
+    ++_Data->stats.drawCalls;
+
+    _Data->quadIndexCount = 0;
+    _Data->quadVertexBufferPtr = _Data->quadVertexBufferBase.get();
+    _Data->textureSlotIndex = 1;
+}
+
+float Renderer2D::GetTextureSlot(const Ref<Texture2D>& texture)
+{
+    for (PDuint32 i = 1; i < _Data->textureSlotIndex; ++i)
+    {
+        if (_Data->textureSlots[i].get() == texture.get())
+            return (float) i;
+    }
+
+    if (_Data->textureSlotIndex >= Renderer2DData::MaxTextureSlots)
+        NextBatch();
+
+    float fIndex = (float) _Data->textureSlotIndex;
+    _Data->textureSlots[_Data->textureSlotIndex++] = texture;
+    return fIndex;
+}
+
+void Renderer2D::PushQuad(const glm::vec3 (&corners)[4], const glm::vec4& color, float texIndex,
+    float tiling, const glm::vec2* texCoords)
+{
+    const PDuint32 uiColor = glm::packUnorm4x8(color);
+    QuadVertex* vertex = _Data->quadVertexBufferPtr;
+    for (int i = 0; i < 4; ++i)
+    {
+        vertex[i].position = corners[i];
+        vertex[i].color = uiColor;
+        vertex[i].texCoord = texCoords[i];
+        vertex[i].texIndex = texIndex;
+        vertex[i].tiling = tiling;
+    }
+
+    _Data->quadVertexBufferPtr += 4;
+    _Data->quadIndexCount += 6;
+    ++_Data->stats.quadCount;
+}
+
+void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
+{
+    DrawQuad(glm::vec3(position, 0.0f), size, color);
+}
+
+void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color)
+{
+    if (_Data->quadIndexCount >= Renderer2DData::MaxIndices)
+        NextBatch();
+
+    // Axis-aligned quads skip the matrix multiply entirely
+    const float fX0 = position.x - size.x * 0.5f, fX1 = position.x + size.x * 0.5f;
+    const float fY0 = position.y - size.y * 0.5f, fY1 = position.y + size.y * 0.5f;
+    const glm::vec3 corners[4] = {
+        {fX0, fY0, position.z}, {fX1, fY0, position.z},
+        {fX1, fY1, position.z}, {fX0, fY1, position.z}
+    };
+    PushQuad(corners, color, 0.0f, 1.0f, _TexCoords);
+}
+
+void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const Ref<Texture2D>& texture,
+    float tiling, const glm::vec4& tint)
+{
+    DrawQuad(glm::vec3(position, 0.0f), size, texture, tiling, tint);
+}
+
+void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, const Ref<Texture2D>& texture,
+    float tiling, const glm::vec4& tint)
+{
+    if (_Data->quadIndexCount >= Renderer2DData::MaxIndices)
+        NextBatch();
+
+    const float fTexIndex = GetTextureSlot(texture);
+    const float fX0 = position.x - size.x * 0.5f, fX1 = position.x + size.x * 0.5f;
+    const float fY0 = position.y - size.y * 0.5f, fY1 = position.y + size.y * 0.5f;
+    const glm::vec3 corners[4] = {
+        {fX0, fY0, position.z}, {fX1, fY0, position.z},
+        {fX1, fY1, position.z}, {fX0, fY1, position.z}
+    };
+    PushQuad(corners, tint, fTexIndex, tiling, _TexCoords);
+}
+
+void Renderer2D::DrawQuad(const glm::mat4& transform, const glm::vec4& color)
+{
+    static const glm::vec4 _Positions[4] = {
+        {-0.5f, -0.5f, 0.0f, 1.0f}, {0.5f, -0.5f, 0.0f, 1.0f},
+        { 0.5f,  0.5f, 0.0f, 1.0f}, {-0.5f, 0.5f, 0.0f, 1.0f}
+    };
+
+    if (_Data->quadIndexCount >= Renderer2DData::MaxIndices)
+        NextBatch();
+
+    glm::vec3 corners[4];
+    for (int i = 0; i < 4; ++i)
+        corners[i] = glm::vec3(transform * _Positions[i]);
+    PushQuad(corners, color, 0.0f, 1.0f, _TexCoords);
+}
+
+void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture,
+    float tiling, const glm::vec4& tint)
+{
+    static const glm::vec4 _Positions[4] = {
+        {-0.5f, -0.5f, 0.0f, 1.0f}, {0.5f, -0.5f, 0.0f, 1.0f},
+        { 0.5f,  0.5f, 0.0f, 1.0f}, {-0.5f, 0.5f, 0.0f, 1.0f}
+    };
+
+    if (_Data->quadIndexCount >= Renderer2DData::MaxIndices)
+        NextBatch();
+
+    const float fTexIndex = GetTextureSlot(texture);
+    glm::vec3 corners[4];
+    for (int i = 0; i < 4; ++i)
+        corners[i] = glm::vec3(transform * _Positions[i]);
+    PushQuad(corners, tint, fTexIndex, tiling, _TexCoords);
+}
+
+void Renderer2D::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation,
+    const glm::vec4& color)
+{
+    glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
+        * glm::rotate(glm::mat4(1.0f), glm::radians(rotation), glm::vec3(0.0f, 0.0f, 1.0f))
+        * glm::scale(glm::mat4(1.0f), glm::vec3(size, 1.0f));
+    DrawQuad(transform, color);
+}
+
+void Renderer2D::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation,
+    const Ref<Texture2D>& texture, float tiling, const glm::vec4& tint)
+{
+    glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
+        * glm::rotate(glm::mat4(1.0f), glm::radians(rotation), glm::vec3(0.0f, 0.0f, 1.0f))
+        * glm::scale(glm::mat4(1.0f), glm::vec3(size, 1.0f));
+    DrawQuad(transform, texture, tiling, tint);
+}
+
+void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size,
+    const Ref<SubTexture2D>& subTexture, const glm::vec4& tint)
+{
+    DrawQuad(glm::vec3(position, 0.0f), size, subTexture, tint);
+}
+
+void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size,
+    const Ref<SubTexture2D>& subTexture, const glm::vec4& tint)
+{
+    if (_Data->quadIndexCount >= Renderer2DData::MaxIndices)
+        NextBatch();
+
+    const float fTexIndex = GetTextureSlot(subTexture->GetTexture());
+    const float fX0 = position.x - size.x * 0.5f, fX1 = position.x + size.x * 0.5f;
+    const float fY0 = position.y - size.y * 0.5f, fY1 = position.y + size.y * 0.5f;
+    const glm::vec3 corners[4] = {
+        {fX0, fY0, position.z}, {fX1, fY0, position.z},
+        {fX1, fY1, position.z}, {fX0, fY1, position.z}
+    };
+    PushQuad(corners, tint, fTexIndex, 1.0f, subTexture->GetTexCoords());
+}
+
+void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<SubTexture2D>& subTexture,
+    const glm::vec4& tint)
+{
+    static const glm::vec4 _Positions[4] = {
+        {-0.5f, -0.5f, 0.0f, 1.0f}, {0.5f, -0.5f, 0.0f, 1.0f},
+        { 0.5f,  0.5f, 0.0f, 1.0f}, {-0.5f, 0.5f, 0.0f, 1.0f}
+    };
+
+    if (_Data->quadIndexCount >= Renderer2DData::MaxIndices)
+        NextBatch();
 
+    const float fTexIndex = GetTextureSlot(subTexture->GetTexture());
+    glm::vec3 corners[4];
+    for (int i = 0; i < 4; ++i)
+        corners[i] = glm::vec3(transform * _Positions[i]);
+    PushQuad(corners, tint, fTexIndex, 1.0f, subTexture->GetTexCoords());
+}
+
+void Renderer2D::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation,
+    const Ref<SubTexture2D>& subTexture, const glm::vec4& tint)
+{
+    glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
+        * glm::rotate(glm::mat4(1.0f), glm::radians(rotation), glm::vec3(0.0f, 0.0f, 1.0f))
+        * glm::scale(glm::mat4(1.0f), glm::vec3(size, 1.0f));
+    DrawQuad(transform, subTexture, tint);
+}
+
+void Renderer2D::DrawString(const PDstring& text, const Ref<Font>& font, const glm::vec2& position,
+    float size, const glm::vec4& color)
+{
+    DrawString(text, font, glm::vec3(position, 0.0f), size, color);
+}
+
+void Renderer2D::DrawString(const PDstring& text, const Ref<Font>& font, const glm::vec3& position,
+    float size, const glm::vec4& color)
+{
+    const PDuint32 uiGeneration = font->GetGeneration();
+    const Font::TextRun& run = font->Shape(text);
+    if (run.quads.empty())
+        return;
+
+    // The glyphs were moved; quads already batched must be drawn before the atlas changes
+    if (font->GetGeneration() != uiGeneration)
+        NextBatch();
+
+    const Ref<Texture2D>& texture = font->GetTexture();
+    const glm::vec2 texelSize = glm::vec2(1.0f) / font->GetAtlasSize();
+    const float fScale = size / font->GetPixelHeight();
+
+    float fTexIndex = GetTextureSlot(texture);
+    for (const Font::GlyphQuad& quad : run.quads)
     {
-        const PDuint32 uiaIndices[] = {
-            0, 1, 2,
-            2, 3, 0
+        if (_Data->quadIndexCount >= Renderer2DData::MaxIndices)
+        {
+            NextBatch();
+            fTexIndex = GetTextureSlot(texture);
+        }
+
+        const float fX0 = position.x + quad.position.x * fScale, fX1 = fX0 + quad.size.x * fScale;
+        const float fY0 = position.y + quad.position.y * fScale, fY1 = fY0 + quad.size.y * fScale;
+        const glm::vec3 corners[4] = {
+            {fX0, fY0, position.z}, {fX1, fY0, position.z},
+            {fX1, fY1, position.z}, {fX0, fY1, position.z}
+        };
+        const glm::vec2 uvMin = quad.texMin * texelSize, uvMax = quad.texMax * texelSize;
+        const glm::vec2 texCoords[4] = {
+            uvMin, {uvMax.x, uvMin.y}, uvMax, {uvMin.x, uvMax.y}
         };
-        Ref<IndexBuffer> ibo(IndexBuffer::Create(PD_ARRAYSIZE(uiaIndices), uiaIndices));
-        _Data->vertexArray->SetIndexBuffer(ibo);
+        PushQuad(corners, color, fTexIndex, 1.0f, texCoords);
     }
 }
 
+Renderer2D::Statistics Renderer2D::GetStats()
+{
+    return _Data->stats;
 }
 
-#endif // 0
+void Renderer2D::ResetStats()
+{
+    _Data->stats = {0, 0};
+}
+
+}
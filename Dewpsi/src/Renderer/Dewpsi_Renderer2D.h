@@ -1,20 +1,132 @@
 #ifndef DEWPSI_RENDERER2D_H
 #define DEWPSI_RENDERER2D_H
 
+/** @file Dewpsi_Renderer2D.h
+*   @ref core_renderer
+*/
+
 #include <Dewpsi_Shader.h>
+#include <Dewpsi_Texture.h>
+#include <Dewpsi_SubTexture2D.h>
+#include <Dewpsi_Font.h>
 #include <Dewpsi_RenderCommand.h>
 #include <Dewpsi_OrthoCamera.h>
 
-#if 0
-
 namespace Dewpsi {
+    /** Batched 2D renderer.
+    *   Quads drawn between BeginScene() and EndScene() are built on the CPU
+    *   into one large vertex buffer and drawn with as few draw calls as
+    *   possible. A batch is flushed when it runs out of quads or texture slots,
+    *   or when the scene ends.
+    *
+    *   @code{.cpp}
+        Renderer2D::BeginScene(camera);
+        Renderer2D::DrawQuad({0.0f, 0.0f}, {1.0f, 1.0f}, {1.0f, 0.0f, 0.0f, 1.0f});
+        Renderer2D::DrawQuad({1.0f, 0.0f}, {1.0f, 1.0f}, texture);
+        Renderer2D::EndScene();
+    *   @endcode
+    *	@ingroup core_renderer
+    */
     class Renderer2D {
     public:
+        /// Draw statistics of the batch renderer.
+        struct Statistics {
+            PDuint32 drawCalls; ///< Number of draw calls issued
+            PDuint32 quadCount; ///< Number of quads drawn
+
+            /// Returns the number of vertices drawn.
+            PDuint32 GetVertexCount() const {return quadCount * 4;}
+
+            /// Returns the number of indices drawn.
+            PDuint32 GetIndexCount() const {return quadCount * 6;}
+        };
+
+        /// Initialize the 2D renderer; called by Renderer::Init().
         static void Init();
+
+        /// Free the resources held by the 2D renderer.
         static void Shutdown();
+
+        /// Begins a scene for the view @a camera.
+        static void BeginScene(const OrthoCamera& camera);
+
+        /// Ends the scene and draws whatever is left in the batch.
+        static void EndScene();
+
+        /// Draws the quads in the current batch and starts a new one.
+        static void Flush();
+
+        /// Draws a quad of a single color.
+        static void DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
+
+        /// Draws a quad of a single color.
+        static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
+
+        /// Draws a textured quad; @a tiling repeats the texture and @a tint is multiplied with it.
+        static void DrawQuad(const glm::vec2& position, const glm::vec2& size, const Ref<Texture2D>& texture,
+            float tiling = 1.0f, const glm::vec4& tint = glm::vec4(1.0f));
+
+        /// Draws a textured quad; @a tiling repeats the texture and @a tint is multiplied with it.
+        static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const Ref<Texture2D>& texture,
+            float tiling = 1.0f, const glm::vec4& tint = glm::vec4(1.0f));
+
+        /// Draws a unit quad transformed by @a transform.
+        static void DrawQuad(const glm::mat4& transform, const glm::vec4& color);
+
+        /// Draws a textured unit quad transformed by @a transform.
+        static void DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture,
+            float tiling = 1.0f, const glm::vec4& tint = glm::vec4(1.0f));
+
+        /// Draws a region of a texture, such as a sprite in a TextureAtlas.
+        static void DrawQuad(const glm::vec2& position, const glm::vec2& size,
+            const Ref<SubTexture2D>& subTexture, const glm::vec4& tint = glm::vec4(1.0f));
+
+        /// Draws a region of a texture, such as a sprite in a TextureAtlas.
+        static void DrawQuad(const glm::vec3& position, const glm::vec2& size,
+            const Ref<SubTexture2D>& subTexture, const glm::vec4& tint = glm::vec4(1.0f));
+
+        /// Draws a region of a texture on a unit quad transformed by @a transform.
+        static void DrawQuad(const glm::mat4& transform, const Ref<SubTexture2D>& subTexture,
+            const glm::vec4& tint = glm::vec4(1.0f));
+
+        /// Draws a quad rotated by @a rotation degrees around its center.
+        static void DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation,
+            const glm::vec4& color);
+
+        /// Draws a textured quad rotated by @a rotation degrees around its center.
+        static void DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation,
+            const Ref<Texture2D>& texture, float tiling = 1.0f, const glm::vec4& tint = glm::vec4(1.0f));
+
+        /// Draws a region of a texture rotated by @a rotation degrees around its center.
+        static void DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation,
+            const Ref<SubTexture2D>& subTexture, const glm::vec4& tint = glm::vec4(1.0f));
+
+        /** Draws @a text, a UTF-8 string, with one quad per glyph.
+        *   Glyphs share the atlas of @a font, so many strings drawn with it batch together.
+        *   @param position  The start of the baseline of the first line
+        *   @param size      The height the pixel height of the font is drawn at, in world units
+        *   @param color     The color of the text
+        */
+        static void DrawString(const PDstring& text, const Ref<Font>& font, const glm::vec2& position,
+            float size, const glm::vec4& color = glm::vec4(1.0f));
+
+        /// Draws @a text, a UTF-8 string, with one quad per glyph.
+        static void DrawString(const PDstring& text, const Ref<Font>& font, const glm::vec3& position,
+            float size, const glm::vec4& color = glm::vec4(1.0f));
+
+        /// Returns the statistics gathered since the last call to ResetStats().
+        static Statistics GetStats();
+
+        /// Resets the statistics.
+        static void ResetStats();
+
+    private:
+        static void StartBatch();
+        static void NextBatch();
+        static float GetTextureSlot(const Ref<Texture2D>& texture);
+        static void PushQuad(const glm::vec3 (&corners)[4], const glm::vec4& color, float texIndex,
+            float tiling, const glm::vec2* texCoords);
     };
 }
 
-#endif // 0
-
 #endif /* DEWPSI_RENDERER2D_H */
@@ -11,6 +11,7 @@
 #include <Dewpsi_Memory.h>
 #include <Dewpsi_Color.h>
 #include <Dewpsi_VertexArray.h>
+#include <vector>
 
 namespace Dewpsi {
 	/** Rendering API abstraction.
@@ -27,13 +28,47 @@ namespace Dewpsi {
 
 		/// Rendering API
 	    enum class API {
-	        None,       ///< No API selected
-	        OpenGL      ///< OpenGL API
+	        None,       ///< Null API; nothing is drawn, draws and binds are only counted
+	        OpenGL,     ///< OpenGL API
+	        Software    ///< Multi-threaded rasterizer on the CPU, into a framebuffer in memory
 	    };
 
+		/// Primitives assembled by DrawArrays().
+		enum class PrimitiveType {
+			Triangles,  ///< Every three vertices are a triangle
+			Lines       ///< Every two vertices are a line, one pixel wide
+		};
+
+		/// GPU time of a render pass, see BeginPass().
+		struct PassTiming {
+			PDstring name;          ///< Name given to BeginPass()
+			float milliseconds;     ///< Time of every instance of the pass in the frame
+		};
+
+		/// Counters of one frame.
+		struct Statistics {
+			PDuint32 drawCalls;             ///< Draw calls issued
+			PDuint32 instances;             ///< Instances drawn; a draw that is not instanced draws one
+			PDuint64 indices;               ///< Indices drawn, over all instances
+			PDuint64 triangles;             ///< Triangles drawn, over all instances
+			PDuint64 lines;                 ///< Lines drawn
+			PDuint32 stateChanges;          ///< Binds and state changes passed on to the API
+			PDuint32 stateChangesElided;    ///< Redundant binds and state changes that were skipped
+			float gpuMilliseconds;          ///< GPU time of all passes
+			std::vector<PassTiming> passes; ///< GPU time of each pass, in the order they first ran
+		};
+
 		/// Initialize the rendering API.
 		virtual void Init() = 0;
 
+		/// Frees the resources held by the rendering API.
+		virtual void Shutdown() = 0;
+
+		/** Prepares the API for a new frame.
+		*	Called once at the start of every frame, before anything is drawn.
+		*/
+		virtual void BeginFrame() = 0;
+
 		/** Sets the clear color.
 		*	The argument is a Color object that has the fields
 		*	@a red, @a green, @a blue, and @a alpha, each field
@@ -44,8 +79,47 @@ namespace Dewpsi {
 		/// Clears the window using the color set in SetClearColor().
 		virtual void Clear() = 0;
 
-		/// Draws the given vertex array.
-		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray) = 0;
+		/** Draws the given vertex array.
+		*	@param vertexArray  The vertex array to draw; its index buffer is used
+		*	@param indexCount   The number of indices to draw, or zero to draw
+		*	                    every index in the index buffer
+		*/
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, PDuint32 indexCount) = 0;
+
+		/** Draws @a instanceCount instances of the given vertex array.
+		*	Attributes of instanced buffer layouts advance per instance, see BufferLayout.
+		*	@param vertexArray    The vertex array to draw; its index buffer is used
+		*	@param instanceCount  The number of instances to draw
+		*	@param indexCount     The number of indices per instance, or zero to draw
+		*	                      every index in the index buffer
+		*	@param baseInstance   The element of the per-instance buffers the first instance
+		*	                      reads, e.g. where this frame's data starts in a StreamBuffer
+		*/
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, PDuint32 instanceCount,
+			PDuint32 indexCount, PDuint32 baseInstance) = 0;
+
+		/** Draws the first @a vertexCount vertices of the given vertex array in order,
+		*	without its index buffer.
+		*	@param vertexArray  The vertex array to draw; it does not need an index buffer
+		*	@param vertexCount  The number of vertices to draw
+		*	@param type         How the vertices are assembled into primitives
+		*/
+		virtual void DrawArrays(const Ref<VertexArray>& vertexArray, PDuint32 vertexCount, PrimitiveType type) = 0;
+
+		/** Starts timing a render pass on the GPU.
+		*	Passes cannot be nested. A pass may run several times per frame; its times are added.
+		*	APIs without GPU timers ignore passes.
+		*/
+		virtual void BeginPass(const char* name) = 0;
+
+		/// Ends the pass started by BeginPass().
+		virtual void EndPass() = 0;
+
+		/** Adds the counters the API keeps to @a stats.
+		*	Called right after BeginFrame(), for the frame that just ended. Timers are read back
+		*	without waiting for the GPU, so pass times are those of an earlier frame.
+		*/
+		virtual void GetFrameStats(Statistics& stats) = 0;
 
 		/// Sets the new current API.
 		static void SetAPI(API api) {s_API = api;}
@@ -4,22 +4,31 @@
 //#include "Dewpsi_String.h"
 
 #include "Dewpsi_OpenGLShader.h"
+#include "Dewpsi_NullShader.h"
+#include "Dewpsi_SoftwareShader.h"
 #include "Dewpsi_OpenGL.h"
 
 namespace Dewpsi {
 
-Ref<Shader> Shader::Create(const PDstring& vertSrc, const PDstring& fragSrc)
+// Empty until the application picks a directory it owns
+static PDstring _CacheDirectory;
+
+Ref<Shader> Shader::Create(const PDstring& vertSrc, const PDstring& fragSrc, bool deferred)
 {
     #define _ERROR(msg) "Shader::Shader: " msg
 
     switch (Renderer::GetAPI())
     {
         case RendererAPI::API::None:
-            throw DewpsiError(_ERROR("Renderer API is set to none"));
+            return CreateRef<NullShader>();
             break;
 
         case RendererAPI::API::OpenGL:
-            return CreateRef<OpenGLShader>(vertSrc, fragSrc);
+            return CreateRef<OpenGLShader>(vertSrc, fragSrc, deferred);
+            break;
+
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareShader>(vertSrc, fragSrc);
             break;
 
         default: break;
@@ -31,18 +40,22 @@ Ref<Shader> Shader::Create(const PDstring& vertSrc, const PDstring& fragSrc)
     #undef _ERROR
 }
 
-Ref<Shader> Shader::Create(const PDstring& file)
+Ref<Shader> Shader::Create(const PDstring& file, bool deferred)
 {
     #define _ERROR(msg) "Shader::Shader: " msg
 
     switch (Renderer::GetAPI())
     {
         case RendererAPI::API::None:
-            throw DewpsiError(_ERROR("Renderer API is set to none"));
+            return CreateRef<NullShader>();
             break;
 
         case RendererAPI::API::OpenGL:
-            return CreateRef<OpenGLShader>(file);
+            return CreateRef<OpenGLShader>(file, deferred);
+            break;
+
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareShader>(file);
             break;
 
         default: break;
@@ -54,4 +67,14 @@ Ref<Shader> Shader::Create(const PDstring& file)
     #undef _ERROR
 }
 
+void Shader::SetCacheDirectory(const PDstring& path)
+{
+    _CacheDirectory = path;
+}
+
+const PDstring& Shader::GetCacheDirectory()
+{
+    return _CacheDirectory;
+}
+
 }
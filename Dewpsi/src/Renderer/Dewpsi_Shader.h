@@ -8,9 +8,50 @@
 #include <Dewpsi_Core.h>
 #include <Dewpsi_RendererAPI.h>
 #include <Dewpsi_Memory.h>
+#include <Dewpsi_String.h>
 #include <glm/glm.hpp>
 
 namespace Dewpsi {
+    /** Handle of a uniform variable.
+    *   The name of the uniform is hashed when the handle is constructed, which happens at
+    *   compile time for string literals. Passing a handle to a @doxtype{Shader} setter
+    *   resolves the uniform's location without allocating or hashing a string.
+    *   @code{.cpp}
+        static constexpr Dewpsi::UniformId u_Color("u_Color");
+        shader->SetFloat3(u_Color, 1.0f, 0.0f, 0.0f);
+    *   @endcode
+    *   @ingroup core_renderer
+    */
+    class UniformId {
+    public:
+        /// Hashes the static string @a name.
+        constexpr UniformId(const StaticString& name)
+            : m_Name(name.get()), m_Length(name.size() - 1), m_Hash(String::Hash(name.get(), name.size() - 1)) {}
+
+        /// Hashes the string literal @a name.
+        template<size_t N>
+        constexpr explicit UniformId(const char (&name)[N])
+            : m_Name(name), m_Length(N - 1), m_Hash(String::Hash(name, N - 1)) {}
+
+        /// Hashes the first @a len characters of @a name; the handle must not outlive @a name.
+        constexpr UniformId(const char* name, size_t len)
+            : m_Name(name), m_Length(len), m_Hash(String::Hash(name, len)) {}
+
+        /// Returns the hash of the name.
+        constexpr PDuint32 GetHash() const {return m_Hash;}
+
+        /// Returns the name of the uniform; it is GetLength() characters long.
+        constexpr const char* GetName() const {return m_Name;}
+
+        /// Returns the length of the name.
+        constexpr size_t GetLength() const {return m_Length;}
+
+    private:
+        const char* m_Name;
+        size_t m_Length;
+        PDuint32 m_Hash;
+    };
+
     /** Defines an interface to shaders for the native rendering API.
     *	@ingroup core_renderer
     *
@@ -23,6 +64,7 @@ namespace Dewpsi {
     *       void SetInt2(const PDstring& name, PDint v1, PDint v2);
     *       void SetInt3(const PDstring& name, PDint v1, PDint v2, PDint v3);
     *       void SetInt4(const PDstring& name, PDint v1, PDint v2, PDint v3, PDint v4);
+    *       void SetIntArray(const PDstring& name, const PDint* value, PDsizei count);
     *       void SetUInt1(const PDstring& name, PDuint v0);
     *       void SetUInt2(const PDstring& name, PDuint v1, PDuint v2);
     *       void SetUInt3(const PDstring& name, PDuint v1, PDuint v2, PDuint v3);
@@ -62,6 +104,10 @@ namespace Dewpsi {
     *   and a vector of two floats can be modified with @doxfunc{SetFloat2}. *Table 1* below shows
     *   the functions and their corresponding type.
     *
+    *   @par
+    *   Every function also has an overload that takes a @doxtype{UniformId} instead of @a name.
+    *   It is the preferred form in code that runs every frame.
+    *
     *   @par Table 1
     *   Function    | Type
     *   ----------- | ----
@@ -69,6 +115,7 @@ namespace Dewpsi {
     *   `SetInt2`   | Two-component @c PDint vector
     *   `SetInt3`   | Three-component @c PDint vector
     *   `SetInt4`   | Four-component @c PDint vector
+    *   `SetIntArray` | Array of @c PDint scalars (e.g., an array of samplers)
     *   `SetUInt1`  | Single @c PDuint scalar
     *   `SetUInt2`  | Two-component @c PDuint vector
     *   `SetUInt3`  | Three-component @c PDuint vector
@@ -84,17 +131,31 @@ namespace Dewpsi {
         Shader() = default;
         virtual ~Shader() = default;
 
-        /// Binds the shader.
-        virtual void Bind() const = 0;
+        /** Binds the shader.
+        *   @return @c false if the shader failed to compile or link; nothing is bound then
+        *           and the error has been logged
+        */
+        virtual bool Bind() const = 0;
 
         /// Unbinds the shader.
         virtual void UnBind() const = 0;
 
+        /// Returns the API-specific ID of the shader program.
+        virtual PDuint GetRendererID() const = 0;
+
+        /** Returns true if the shader has finished compiling.
+        *   Only shaders created with @a deferred set can be unfinished; binding one
+        *   before it is ready waits for the compile to finish. Where the API cannot tell
+        *   without waiting, this returns true.
+        */
+        virtual bool IsReady() const = 0;
+
         // These are documented up above in the class doc.
         virtual void SetInt1(const PDstring& name, PDint v0) = 0;
         virtual void SetInt2(const PDstring& name, PDint v1, PDint v2) = 0;
         virtual void SetInt3(const PDstring& name, PDint v1, PDint v2, PDint v3) = 0;
         virtual void SetInt4(const PDstring& name, PDint v1, PDint v2, PDint v3, PDint v4) = 0;
+        virtual void SetIntArray(const PDstring& name, const PDint* value, PDsizei count) = 0;
 
         virtual void SetUInt1(const PDstring& name, PDuint v0) = 0;
         virtual void SetUInt2(const PDstring& name, PDuint v1, PDuint v2) = 0;
@@ -108,26 +169,65 @@ namespace Dewpsi {
         virtual void SetMat4(const PDstring& name, PDsizei count, const glm::mat4* value,
             bool transpose = false) = 0;
 
+        virtual void SetInt1(UniformId id, PDint v0) = 0;
+        virtual void SetInt2(UniformId id, PDint v1, PDint v2) = 0;
+        virtual void SetInt3(UniformId id, PDint v1, PDint v2, PDint v3) = 0;
+        virtual void SetInt4(UniformId id, PDint v1, PDint v2, PDint v3, PDint v4) = 0;
+        virtual void SetIntArray(UniformId id, const PDint* value, PDsizei count) = 0;
+
+        virtual void SetUInt1(UniformId id, PDuint v0) = 0;
+        virtual void SetUInt2(UniformId id, PDuint v1, PDuint v2) = 0;
+        virtual void SetUInt3(UniformId id, PDuint v1, PDuint v2, PDuint v3) = 0;
+        virtual void SetUInt4(UniformId id, PDuint v1, PDuint v2, PDuint v3, PDuint v4) = 0;
+
+        virtual void SetFloat1(UniformId id, float v1) = 0;
+        virtual void SetFloat2(UniformId id, float v1, float v2) = 0;
+        virtual void SetFloat3(UniformId id, float v1, float v2, float v3) = 0;
+        virtual void SetFloat4(UniformId id, float v1, float v2, float v3, float v4) = 0;
+        virtual void SetMat4(UniformId id, PDsizei count, const glm::mat4* value,
+            bool transpose = false) = 0;
+
         /** Creates a shader program and returns a pointer to it.
         *	The exact kind of shader that is created, and what language the
         *	source code is in, depends on the currently selected API.
         *	@param    vertSrc A string containing the source code of the vertex shader
         *	@param    fragSrc A string containing the source code of the fragment shader
+        *	@param    deferred If true, the compile is started but not waited for; errors
+        *	                   are reported when the shader is first used
         *	@return           A pointer to the platform-dependent shader object
         *	@throw    DewpsiError     Thrown if an unsupported API is detected.
         */
-        static Ref<Shader> Create(const PDstring& vertSrc, const PDstring& fragSrc);
+        static Ref<Shader> Create(const PDstring& vertSrc, const PDstring& fragSrc,
+            bool deferred = false);
 
         /** Creates a shader program and returns a pointer to it.
         *	The exact kind of shader that is created, and what language the
         *	source code is in, depends on the currently selected API.
         *	@param    file    A string containing the path to a file with the source
         *                     code for the vertex and fragment shaders.
+        *	@param    deferred If true, the compile is started but not waited for; errors
+        *	                   are reported when the shader is first used
         *	@return           A pointer to the platform-dependent shader object
         /
         *	@throw DewpsiError Thrown if an unsupported API is detected.
         */
-        static Ref<Shader> Create(const PDstring& file);
+        static Ref<Shader> Create(const PDstring& file, bool deferred = false);
+
+        /** Sets the directory compiled shader programs are cached in.
+        *   Shaders created afterwards are loaded from the cache if their sources, the
+        *   driver and the GPU all match a cached program, which skips compiling them.
+        *   The directory is created when the first program is stored. The cache is off
+        *   until this is called, as a relative path would depend on the directory the
+        *   application is started from; pass a directory the application owns, such as one
+        *   under the user's data directory. An empty path disables the cache again.
+        *   @code{.cpp}
+            Dewpsi::Shader::SetCacheDirectory(m_DataDirectory + "/cache/shaders");
+        *   @endcode
+        */
+        static void SetCacheDirectory(const PDstring& path);
+
+        /// Returns the directory compiled shader programs are cached in.
+        static const PDstring& GetCacheDirectory();
     };
 
     /// A chunk with the source code for shaders.
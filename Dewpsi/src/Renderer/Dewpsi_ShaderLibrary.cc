@@ -0,0 +1,48 @@
+#include "Dewpsi_ShaderLibrary.h"
+
+namespace Dewpsi {
+
+void ShaderLibrary::Add(const PDstring& name, const Ref<Shader>& shader)
+{
+    PD_CORE_ASSERT(! Exists(name), "Shader '{0}' already exists", name);
+    m_Shaders[name] = shader;
+}
+
+Ref<Shader> ShaderLibrary::Load(const PDstring& name, const PDstring& file)
+{
+    Ref<Shader> shader = Shader::Create(file, true);
+    Add(name, shader);
+    return shader;
+}
+
+Ref<Shader> ShaderLibrary::Load(const PDstring& name, const PDstring& vertSrc, const PDstring& fragSrc)
+{
+    Ref<Shader> shader = Shader::Create(vertSrc, fragSrc, true);
+    Add(name, shader);
+    return shader;
+}
+
+Ref<Shader> ShaderLibrary::Get(const PDstring& name) const
+{
+    auto found = m_Shaders.find(name);
+    PD_CORE_ASSERT(found != m_Shaders.end(), "Shader '{0}' not found", name);
+    return (found != m_Shaders.end()) ? found->second : nullptr;
+}
+
+bool ShaderLibrary::Exists(const PDstring& name) const
+{
+    return m_Shaders.find(name) != m_Shaders.end();
+}
+
+bool ShaderLibrary::IsReady() const
+{
+    for (const auto& pair : m_Shaders)
+    {
+        if (! pair.second->IsReady())
+            return false;
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,62 @@
+#ifndef DEWPSI_SHADERLIBRARY_H
+#define DEWPSI_SHADERLIBRARY_H
+
+/** @file Dewpsi_ShaderLibrary.h
+*   @ref core_renderer
+*/
+
+#include <Dewpsi_Shader.h>
+#include <unordered_map>
+
+namespace Dewpsi {
+    /** A named collection of shaders.
+    *   Shaders loaded into the library start compiling right away, but the library
+    *   never waits for them: a shader's compile and link status is only checked when
+    *   it is first bound. Loading every shader up front therefore lets the driver
+    *   compile them in the background (on its own threads, if it supports
+    *   KHR_parallel_shader_compile) while the application loads other assets.
+    *
+    *   @code{.cpp}
+        Dewpsi::ShaderLibrary library;
+        library.Load("Color", "assets/shaders/Color.glsl");
+        library.Load("Texture", "assets/shaders/Texture.glsl");
+        // ... load textures ...
+        auto shader = library.Get("Texture");
+    *   @endcode
+    *   @ingroup core_renderer
+    */
+    class ShaderLibrary {
+    public:
+        ShaderLibrary() = default;
+
+        /// Adds an existing shader to the library under @a name.
+        void Add(const PDstring& name, const Ref<Shader>& shader);
+
+        /** Starts compiling the shader in @a file and adds it under @a name.
+        *   @return The shader; it is not ready until IsReady() returns true
+        */
+        Ref<Shader> Load(const PDstring& name, const PDstring& file);
+
+        /** Starts compiling the given sources and adds the shader under @a name.
+        *   @return The shader; it is not ready until IsReady() returns true
+        */
+        Ref<Shader> Load(const PDstring& name, const PDstring& vertSrc, const PDstring& fragSrc);
+
+        /// Returns the shader called @a name, or @c NULL if there is none.
+        Ref<Shader> Get(const PDstring& name) const;
+
+        /// Returns true if there is a shader called @a name.
+        bool Exists(const PDstring& name) const;
+
+        /// Returns true if every shader has finished compiling; does not wait.
+        bool IsReady() const;
+
+        /// Returns the number of shaders in the library.
+        PDsizei GetSize() const {return m_Shaders.size();}
+
+    private:
+        std::unordered_map<PDstring, Ref<Shader>> m_Shaders;
+    };
+}
+
+#endif /* DEWPSI_SHADERLIBRARY_H */
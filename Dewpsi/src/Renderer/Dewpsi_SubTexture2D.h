@@ -0,0 +1,47 @@
+#ifndef DEWPSI_SUBTEXTURE2D_H
+#define DEWPSI_SUBTEXTURE2D_H
+
+/** @file Dewpsi_SubTexture2D.h
+*   @ref core_renderer
+*/
+
+#include <Dewpsi_Texture.h>
+#include <glm/glm.hpp>
+
+namespace Dewpsi {
+    /** A rectangular region of a 2D texture.
+    *   Sprites that live in the same texture (see @doxtype{TextureAtlas}) are drawn
+    *   by Renderer2D in the same batch.
+    *   @ingroup core_renderer_textures
+    */
+    class SubTexture2D {
+    public:
+        /** Creates a region of @a texture.
+        *   @param texture  The texture that holds the region
+        *   @param min      The texture coordinates of the bottom-left corner
+        *   @param max      The texture coordinates of the top-right corner
+        */
+        SubTexture2D(const Ref<Texture2D>& texture, const glm::vec2& min, const glm::vec2& max)
+            : m_Texture(texture),
+              m_TexCoords{{min.x, min.y}, {max.x, min.y}, {max.x, max.y}, {min.x, max.y}} {}
+
+        /// Returns the texture that holds the region.
+        const Ref<Texture2D>& GetTexture() const {return m_Texture;}
+
+        /// Returns the texture coordinates of the corners, counter-clockwise from bottom-left.
+        const glm::vec2* GetTexCoords() const {return m_TexCoords;}
+
+        /// Returns the size of the region in texels.
+        glm::vec2 GetSize() const
+        {
+            return (m_TexCoords[2] - m_TexCoords[0])
+                * glm::vec2((float) m_Texture->GetWidth(), (float) m_Texture->GetHeight());
+        }
+
+    private:
+        Ref<Texture2D> m_Texture;
+        glm::vec2 m_TexCoords[4];
+    };
+}
+
+#endif /* DEWPSI_SUBTEXTURE2D_H */
@@ -2,21 +2,83 @@
 #include "Dewpsi_WhichOS.h"
 #include "Dewpsi_Except.h"
 #include "Dewpsi_Renderer.h"
+#include <atomic>
 
 namespace Dewpsi {
 
-Ref<Texture2D> Texture2D::Create(const PDstring& file)
+// Read by the render thread in OpenGLTextureLoader::Update()
+static std::atomic<PDsizei> _UploadBudget{8 * 1024 * 1024};
+
+Ref<Texture2D> Texture2D::Create(const PDstring& file, const TextureProperties& props)
+{
+    #define _ERROR(msg) "Texture2D::Create: " msg
+
+    switch (Renderer::GetAPI())
+    {
+        case RendererAPI::API::None:
+            return CreateRef<NullTexture2D>(file, props);
+            break;
+
+        case RendererAPI::API::OpenGL:
+            return CreateRef<OpenGLTexture2D>(file, props);
+            break;
+
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareTexture2D>(file, props);
+            break;
+
+        default: break;
+    }
+
+    throw DewpsiError(_ERROR("unrecognized API"));
+
+    return nullptr;
+    #undef _ERROR
+}
+
+Ref<Texture2D> Texture2D::Create(PDuint width, PDuint height, const TextureProperties& props)
 {
     #define _ERROR(msg) "Texture2D::Create: " msg
 
     switch (Renderer::GetAPI())
     {
         case RendererAPI::API::None:
-            throw DewpsiError(_ERROR("renderer API is set to none"));
+            return CreateRef<NullTexture2D>(width, height, props);
+            break;
+
+        case RendererAPI::API::OpenGL:
+            return CreateRef<OpenGLTexture2D>(width, height, props);
+            break;
+
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareTexture2D>(width, height, props);
+            break;
+
+        default: break;
+    }
+
+    throw DewpsiError(_ERROR("unrecognized API"));
+
+    return nullptr;
+    #undef _ERROR
+}
+
+Ref<Texture2D> Texture2D::CreateAsync(const PDstring& file, const TextureProperties& props)
+{
+    #define _ERROR(msg) "Texture2D::CreateAsync: " msg
+
+    switch (Renderer::GetAPI())
+    {
+        case RendererAPI::API::None:
+            return CreateRef<NullTexture2D>(file, props);
             break;
 
         case RendererAPI::API::OpenGL:
-            return CreateRef<OpenGLTexture2D>(file);
+            return OpenGLTextureLoader::Load(file, props);
+            break;
+
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareTexture2D>(file, props);
             break;
 
         default: break;
@@ -28,4 +90,15 @@ Ref<Texture2D> Texture2D::Create(const PDstring& file)
     #undef _ERROR
 }
 
+void Texture2D::SetUploadBudget(PDsizei bytesPerFrame)
+{
+    PD_CORE_ASSERT(bytesPerFrame, "Upload budget cannot be zero");
+    _UploadBudget = bytesPerFrame;
+}
+
+PDsizei Texture2D::GetUploadBudget()
+{
+    return _UploadBudget;
+}
+
 }
@@ -10,9 +10,36 @@
 #include <Dewpsi_Core.h>
 #include <Dewpsi_String.h>
 #include <Dewpsi_Memory.h>
+#include <Dewpsi_Mipmap.h>
 #include <stb_image.h>
+#include <atomic>
 
 namespace Dewpsi {
+    /// How texels are sampled.
+    /// @ingroup core_renderer_textures
+    enum class TextureFilter {
+        Nearest,    ///< The nearest texel of the nearest mip level
+        Linear,     ///< Bilinear, within the nearest mip level
+        Trilinear   ///< Bilinear, blended between the two nearest mip levels; same as Linear when magnifying
+    };
+
+    /** Sampling and mip chain of a texture, chosen when it is created.
+    *   By default, textures get a full mip chain built by the rendering API and are
+    *   sampled trilinearly when minified. Textures that are only drawn at their native
+    *   size or larger (e.g., pixel art or atlas pages) can skip the chain:
+    *   @code{.cpp}
+        Dewpsi::TextureProperties props;
+        props.mipmaps = Dewpsi::MipmapFilter::None;
+        props.minFilter = props.magFilter = Dewpsi::TextureFilter::Nearest;
+        auto sprite = Dewpsi::Texture2D::Create("assets/images/sprite.png", props);
+    *   @endcode
+    *   @ingroup core_renderer_textures
+    */
+    struct TextureProperties {
+        MipmapFilter mipmaps = MipmapFilter::GPU;           ///< How the mip chain is built
+        TextureFilter minFilter = TextureFilter::Trilinear; ///< Filter when the texture is minified
+        TextureFilter magFilter = TextureFilter::Linear;    ///< Filter when the texture is magnified
+    };
     /// A texture.
     /// @ingroup core_renderer_textures
     class Texture {
@@ -35,12 +62,50 @@ namespace Dewpsi {
         /// Return an immutable pointer to the pixel data.
         virtual const PDuchar* GetData() const = 0;
 
+        /** Replaces the pixel data of the texture.
+        *   The mip chain, if any, is rebuilt.
+        *   @param data  A pointer to tightly packed RGBA pixels
+        *   @param size  The size of @a data in bytes; must cover the whole texture
+        */
+        virtual void SetData(const void* data, PDsizei size) = 0;
+
+        /** Replaces a rectangle of the texture's pixel data.
+        *   Only the base level is changed; call GenerateMipmaps() once all changes are made.
+        *   @param data    A pointer to tightly packed RGBA pixels, @a width by @a height
+        *   @param x       The left edge of the rectangle in texels
+        *   @param y       The bottom edge of the rectangle in texels
+        *   @param width   The width of the rectangle
+        *   @param height  The height of the rectangle
+        */
+        virtual void SetSubData(const void* data, PDuint x, PDuint y, PDuint width, PDuint height) = 0;
+
+        /// Rebuilds the mip chain from the base level on the GPU, whatever the MipmapFilter.
+        virtual void GenerateMipmaps() = 0;
+
+        /// Returns the number of mip levels, including the base level.
+        virtual PDuint GetMipLevelCount() const = 0;
+
+        /// Returns the properties the texture was created with.
+        virtual const TextureProperties& GetProperties() const = 0;
+
+        /// Returns an estimate of the GPU memory taken by the texture and its mip chain, in bytes.
+        virtual PDsizei GetMemorySize() const = 0;
+
+        /// Returns the API-specific handle of the texture.
+        virtual PDuint GetRendererID() const = 0;
+
+        /** Returns @c false while the pixels of an asynchronously loaded texture are not uploaded yet.
+        *   Until then, the texture is a 1x1 transparent placeholder.
+        */
+        virtual bool IsLoaded() const = 0;
+
         /// Returns @c true if there is an error.
         /// @note If this returns true, the error message can be obtained with SetError().
         bool IsError() const {return m_IsError;}
 
     protected:
-        bool m_IsError;
+        // Set by the render thread when an asynchronous load fails
+        std::atomic<bool> m_IsError{false};
     };
 
     /// A 2D texture.
@@ -51,7 +116,25 @@ namespace Dewpsi {
         virtual ~Texture2D() = default;
 
         /// Create a 2D texture from file.
-        static Ref<Texture2D> Create(const PDstring& file);
+        static Ref<Texture2D> Create(const PDstring& file, const TextureProperties& props = {});
+
+        /// Create an empty RGBA 2D texture; fill it with SetData().
+        static Ref<Texture2D> Create(PDuint width, PDuint height, const TextureProperties& props = {});
+
+        /** Create a 2D texture from file without blocking.
+        *   The texture is returned right away as a placeholder, see IsLoaded(). The file is
+        *   decoded on a worker thread and the pixels are uploaded over the following frames,
+        *   at most SetUploadBudget() bytes per frame. If the file cannot be read, the texture
+        *   stays a placeholder and IsError() returns @c true once the failure is noticed.
+        *   @note Decoded images are always RGBA.
+        */
+        static Ref<Texture2D> CreateAsync(const PDstring& file, const TextureProperties& props = {});
+
+        /// Sets the number of bytes asynchronously loaded textures may upload per frame.
+        static void SetUploadBudget(PDsizei bytesPerFrame);
+
+        /// Returns the number of bytes asynchronously loaded textures may upload per frame.
+        static PDsizei GetUploadBudget();
     };
 }
 
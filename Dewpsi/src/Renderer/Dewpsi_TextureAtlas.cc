@@ -0,0 +1,188 @@
+#include "Dewpsi_TextureAtlas.h"
+#include "Dewpsi_Log.h"
+#include "Dewpsi_RenderThread.h"
+
+#include <limits>
+
+namespace Dewpsi {
+
+TextureAtlas::TextureAtlas(PDuint pageWidth, PDuint pageHeight, PDuint padding)
+    : m_PageWidth(pageWidth), m_PageHeight(pageHeight), m_Padding(padding)
+{
+    PD_CORE_ASSERT(pageWidth && pageHeight, "Atlas pages cannot be empty");
+}
+
+TextureAtlas::~TextureAtlas()
+{
+    // A recorded frame may still draw from the pages
+    for (Page& page : m_Pages)
+        RenderThread::Release(page.texture);
+}
+
+Ref<SubTexture2D> TextureAtlas::Add(const PDstring& file)
+{
+    int iWidth, iHeight, iChannels;
+    stbi_set_flip_vertically_on_load(1);
+    PDuchar* ucpBuffer = stbi_load(file.c_str(), &iWidth, &iHeight, &iChannels, 4);
+    PD_CORE_ASSERT(ucpBuffer, "Failed to load {0}", file);
+    if (! ucpBuffer)
+    {
+        SetError("Failed to read %s", file.c_str());
+        return nullptr;
+    }
+
+    Ref<SubTexture2D> result = Add(ucpBuffer, (PDuint) iWidth, (PDuint) iHeight);
+    stbi_image_free(ucpBuffer);
+    return result;
+}
+
+Ref<SubTexture2D> TextureAtlas::Add(const void* pixels, PDuint width, PDuint height)
+{
+    // Reserve the padding on the right and top edges of every image
+    const PDuint uWidth = width + m_Padding, uHeight = height + m_Padding;
+    if (uWidth > m_PageWidth || uHeight > m_PageHeight)
+    {
+        PD_CORE_ERROR("A {0}x{1} image does not fit in a {2}x{3} atlas page", width, height,
+            m_PageWidth, m_PageHeight);
+        SetError("Image is larger than an atlas page");
+        return nullptr;
+    }
+
+    PDsizei szNode = 0;
+    PDuint uX = 0, uY = 0;
+    Page* page = nullptr;
+    for (Page& candidate : m_Pages)
+    {
+        if (FindPosition(candidate, uWidth, uHeight, szNode, uX, uY))
+        {
+            page = &candidate;
+            break;
+        }
+    }
+
+    if (! page)
+    {
+        page = &AddPage();
+        FindPosition(*page, uWidth, uHeight, szNode, uX, uY);
+    }
+
+    Insert(*page, szNode, uX, uY, uWidth, uHeight);
+    if (RenderThread::IsRecording())
+    {
+        // The caller may free the pixels before the render thread gets to them
+        const PDuchar* ucpPixels = static_cast<const PDuchar*>(pixels);
+        RenderThread::Enqueue([texture = page->texture, data = std::vector<PDuchar>(ucpPixels,
+            ucpPixels + (PDsizei) width * height * 4), uX, uY, width, height]{
+            texture->SetSubData(data.data(), uX, uY, width, height);
+        });
+    }
+    else
+        page->texture->SetSubData(pixels, uX, uY, width, height);
+
+    const glm::vec2 size((float) m_PageWidth, (float) m_PageHeight);
+    return CreateRef<SubTexture2D>(page->texture, glm::vec2((float) uX, (float) uY) / size,
+        glm::vec2((float) (uX + width), (float) (uY + height)) / size);
+}
+
+bool TextureAtlas::FindPosition(const Page& page, PDuint width, PDuint height,
+    PDsizei& node, PDuint& x, PDuint& y) const
+{
+    PDuint uBestTop = std::numeric_limits<PDuint>::max();
+    PDuint uBestWidth = std::numeric_limits<PDuint>::max();
+    bool found = false;
+
+    for (PDsizei i = 0; i < page.skyline.size(); ++i)
+    {
+        const PDuint uX = page.skyline[i].x;
+        if (uX + width > m_PageWidth)
+            break;
+
+        // The image rests on the highest node it spans
+        PDuint uY = 0;
+        PDsizei j = i;
+        for (PDuint uCovered = 0; uCovered < width; ++j)
+        {
+            uY = std::max(uY, page.skyline[j].y);
+            uCovered += page.skyline[j].width;
+        }
+
+        if (uY + height > m_PageHeight)
+            continue;
+
+        // Bottom-left: lowest top edge first, then the narrowest resting node
+        const PDuint uTop = uY + height;
+        if (uTop < uBestTop || (uTop == uBestTop && page.skyline[i].width < uBestWidth))
+        {
+            uBestTop = uTop;
+            uBestWidth = page.skyline[i].width;
+            node = i;
+            x = uX;
+            y = uY;
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+void TextureAtlas::Insert(Page& page, PDsizei node, PDuint x, PDuint y, PDuint width, PDuint height)
+{
+    std::vector<SkylineNode>& skyline = page.skyline;
+    skyline.insert(skyline.begin() + node, {x, y + height, width});
+
+    // Shrink or remove the nodes now covered by the new one
+    for (PDsizei i = node + 1; i < skyline.size(); )
+    {
+        const PDuint uEnd = skyline[i - 1].x + skyline[i - 1].width;
+        if (skyline[i].x >= uEnd)
+            break;
+
+        const PDuint uShrink = uEnd - skyline[i].x;
+        if (skyline[i].width <= uShrink)
+        {
+            skyline.erase(skyline.begin() + i);
+            continue;
+        }
+
+        skyline[i].x += uShrink;
+        skyline[i].width -= uShrink;
+        break;
+    }
+
+    // Merge neighbors of the same height
+    for (PDsizei i = 0; i + 1 < skyline.size(); )
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+TextureAtlas::Page& TextureAtlas::AddPage()
+{
+    Page page;
+    // Images are added one at a time, and a mip chain would bleed neighbors into each other
+    TextureProperties props;
+    props.mipmaps = MipmapFilter::None;
+    props.minFilter = TextureFilter::Linear;
+    RenderThread::Call([this, &page, props]{
+        page.texture = Texture2D::Create(m_PageWidth, m_PageHeight, props);
+
+        // Storage starts out undefined; the padding between images must be transparent
+        std::vector<PDuchar> clear((PDsizei) m_PageWidth * m_PageHeight * 4, 0);
+        page.texture->SetData(clear.data(), clear.size());
+    });
+    page.skyline.push_back({0, 0, m_PageWidth});
+
+    PD_CORE_TRACE("Created a {0}x{1} atlas page", m_PageWidth, m_PageHeight);
+    m_Pages.push_back(PD_MOVE(page));
+    return m_Pages.back();
+}
+
+}
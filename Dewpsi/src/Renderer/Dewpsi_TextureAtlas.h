@@ -0,0 +1,83 @@
+#ifndef DEWPSI_TEXTUREATLAS_H
+#define DEWPSI_TEXTUREATLAS_H
+
+/** @file Dewpsi_TextureAtlas.h
+*   @ref core_renderer
+*/
+
+#include <Dewpsi_SubTexture2D.h>
+#include <vector>
+
+namespace Dewpsi {
+    /** Packs many images into a few large textures.
+    *   Images are placed with a skyline bottom-left packer into pages of a fixed size;
+    *   a new page is started when an image fits in none of the existing ones. Images can
+    *   be added at any time, and only the texels of the new image are uploaded.
+    *
+    *   @code{.cpp}
+        Dewpsi::TextureAtlas atlas(1024, 1024);
+        auto player = atlas.Add("assets/images/player.png");
+        auto enemy = atlas.Add("assets/images/enemy.png");
+        // Both quads end up in the same batch
+        Dewpsi::Renderer2D::DrawQuad({0.0f, 0.0f}, {1.0f, 1.0f}, player);
+        Dewpsi::Renderer2D::DrawQuad({1.0f, 0.0f}, {1.0f, 1.0f}, enemy);
+    *   @endcode
+    *   @ingroup core_renderer_textures
+    */
+    class TextureAtlas {
+    public:
+        /** Creates an empty atlas; no texture is created until the first image is added.
+        *   @param pageWidth   The width of each page texture
+        *   @param pageHeight  The height of each page texture
+        *   @param padding     Empty texels left between images, so filtering does not
+        *                      bleed neighbors into each other
+        */
+        TextureAtlas(PDuint pageWidth = 2048, PDuint pageHeight = 2048, PDuint padding = 1);
+        ~TextureAtlas();
+
+        /** Loads the image in @a file and packs it.
+        *   @return The region of the image, or @c NULL if the file could not be read or
+        *           the image is larger than a page
+        */
+        Ref<SubTexture2D> Add(const PDstring& file);
+
+        /** Packs an image.
+        *   With the render thread running, the pixels are copied for it, and an image that
+        *   needs a new page waits until the render thread has created it.
+        *   @param pixels  Tightly packed RGBA pixels, bottom row first
+        *   @param width   The width of the image
+        *   @param height  The height of the image
+        *   @return        The region of the image, or @c NULL if it is larger than a page
+        */
+        Ref<SubTexture2D> Add(const void* pixels, PDuint width, PDuint height);
+
+        /// Returns the number of pages.
+        PDsizei GetPageCount() const {return m_Pages.size();}
+
+        /// Returns the texture of page @a index.
+        const Ref<Texture2D>& GetPage(PDsizei index) const {return m_Pages[index].texture;}
+
+    private:
+        // Top edge of the packed area over [x, x + width)
+        struct SkylineNode {
+            PDuint x, y, width;
+        };
+
+        struct Page {
+            Ref<Texture2D> texture;
+            std::vector<SkylineNode> skyline;
+        };
+
+        bool FindPosition(const Page& page, PDuint width, PDuint height,
+            PDsizei& node, PDuint& x, PDuint& y) const;
+        void Insert(Page& page, PDsizei node, PDuint x, PDuint y, PDuint width, PDuint height);
+        Page& AddPage();
+
+        std::vector<Page> m_Pages;
+        PDuint m_PageWidth;
+        PDuint m_PageHeight;
+        PDuint m_Padding;
+    };
+}
+
+#endif /* DEWPSI_TEXTUREATLAS_H */
@@ -0,0 +1,312 @@
+#include "Dewpsi_Tilemap.h"
+#include "Dewpsi_Renderer.h"
+#include "Dewpsi_RenderCommand.h"
+#include "Dewpsi_RenderThread.h"
+#include "Dewpsi_Shader.h"
+#include "Dewpsi_VertexArray.h"
+#include "Dewpsi_Log.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Dewpsi {
+
+static const char* _VertexShaderSource = R"(
+    layout(location = 0) in vec3 in_Position;
+    layout(location = 1) in vec2 in_TexCoord;
+
+    out vec2 v_TexCoord;
+
+    void main() {
+        v_TexCoord = in_TexCoord;
+        gl_Position = u_ViewProjection * vec4(in_Position, 1.0);
+    }
+)";
+
+static const char* _FragmentShaderSource = R"(
+    in vec2 v_TexCoord;
+    uniform sampler2D u_Texture;
+    uniform vec4 u_Color;
+    out vec4 FragColor;
+
+    void main() {
+        FragColor = texture(u_Texture, v_TexCoord) * u_Color;
+    }
+)";
+
+// A corner of a tile.
+struct TileVertex {
+    glm::vec3 position;
+    glm::vec2 texCoord;
+};
+
+struct Tilemap::ChunkMesh {
+    Ref<VertexArray> vertexArray;
+    Ref<VertexBuffer> vertexBuffer;
+    PDuint32 capacity = 0;      // quads the vertex buffer has room for
+    PDuint32 indexCount = 0;
+};
+
+// A full chunk is the most a chunk can draw, so the shared quad indices cover them all
+static_assert(Tilemap::ChunkSize * Tilemap::ChunkSize <= Renderer::MaxSharedQuads,
+    "A chunk must fit the shared quad indices");
+
+// Created by the first draw
+static Ref<Shader> _Shader;
+
+void Tilemap::Shutdown()
+{
+    _Shader = nullptr;
+}
+
+Tilemap::Tilemap(PDuint width, PDuint height, const Ref<Texture2D>& tileset, PDuint tilePixels,
+    float tileSize, const glm::vec2& origin)
+    : m_Width(width), m_Height(height),
+      m_ChunksX((width + ChunkSize - 1) / ChunkSize), m_ChunksY((height + ChunkSize - 1) / ChunkSize),
+      m_Tileset(tileset), m_TilePixels(tilePixels), m_TileSize(tileSize), m_Origin(origin)
+{
+    PD_CORE_ASSERT(tileset, "A tilemap needs a tileset");
+    PD_CORE_ASSERT(tilePixels > 0, "Tiles must be at least one texel wide");
+}
+
+Tilemap::~Tilemap()
+{
+    // The chunk meshes and the tileset may still be in use by a recorded frame
+    for (Layer& layer : m_Layers)
+    {
+        for (Chunk& chunk : layer.chunks)
+            RenderThread::Release(chunk.mesh);
+    }
+    RenderThread::Release(m_Tileset);
+}
+
+PDuint Tilemap::AddLayer(const glm::vec4& tint)
+{
+    Layer layer;
+    layer.tiles.assign((PDsizei) m_Width * m_Height, Empty);
+    layer.chunks.resize((PDsizei) m_ChunksX * m_ChunksY);
+    layer.tint = tint;
+    m_Layers.push_back(PD_MOVE(layer));
+    return (PDuint) m_Layers.size() - 1;
+}
+
+void Tilemap::SetLayerTint(PDuint layer, const glm::vec4& tint)
+{
+    PD_CORE_ASSERT(layer < m_Layers.size(), "Layer out of range");
+    m_Layers[layer].tint = tint;
+}
+
+void Tilemap::SetLayerVisible(PDuint layer, bool visible)
+{
+    PD_CORE_ASSERT(layer < m_Layers.size(), "Layer out of range");
+    m_Layers[layer].visible = visible;
+}
+
+void Tilemap::SetTile(PDuint layer, PDuint x, PDuint y, PDuint16 tile)
+{
+    PD_CORE_ASSERT(layer < m_Layers.size(), "Layer out of range");
+    PD_CORE_ASSERT(x < m_Width && y < m_Height, "Tile out of range");
+
+    Layer& l = m_Layers[layer];
+    PDuint16& cell = l.tiles[(PDsizei) y * m_Width + x];
+    if (cell == tile)
+        return;
+    cell = tile;
+    GetChunk(l, x, y).dirty = true;
+}
+
+PDuint16 Tilemap::GetTile(PDuint layer, PDuint x, PDuint y) const
+{
+    PD_CORE_ASSERT(layer < m_Layers.size(), "Layer out of range");
+    PD_CORE_ASSERT(x < m_Width && y < m_Height, "Tile out of range");
+    return m_Layers[layer].tiles[(PDsizei) y * m_Width + x];
+}
+
+void Tilemap::Fill(PDuint layer, PDuint x, PDuint y, PDuint width, PDuint height, PDuint16 tile)
+{
+    const PDuint uEndX = std::min(m_Width, x + width), uEndY = std::min(m_Height, y + height);
+    for (PDuint j = y; j < uEndY; ++j)
+    {
+        for (PDuint i = x; i < uEndX; ++i)
+            SetTile(layer, i, j, tile);
+    }
+}
+
+Tilemap::Chunk& Tilemap::GetChunk(Layer& layer, PDuint x, PDuint y)
+{
+    return layer.chunks[(PDsizei) (y / ChunkSize) * m_ChunksX + x / ChunkSize];
+}
+
+void Tilemap::Rebuild(Layer& layer, PDuint chunkX, PDuint chunkY)
+{
+    Chunk& chunk = layer.chunks[(PDsizei) chunkY * m_ChunksX + chunkX];
+    chunk.dirty = false;
+
+    // Tiles are read from the tileset top row first; the texture is stored bottom row first
+    const PDuint uColumns = std::max(1u, m_Tileset->GetWidth() / m_TilePixels);
+    const glm::vec2 tileUV = glm::vec2((float) m_TilePixels) /
+        glm::vec2((float) m_Tileset->GetWidth(), (float) m_Tileset->GetHeight());
+
+    const PDuint uBeginX = chunkX * ChunkSize, uEndX = std::min(m_Width, uBeginX + ChunkSize);
+    const PDuint uBeginY = chunkY * ChunkSize, uEndY = std::min(m_Height, uBeginY + ChunkSize);
+
+    std::vector<TileVertex> vertices;
+    vertices.reserve((PDsizei) (uEndX - uBeginX) * (uEndY - uBeginY) * 4);
+    for (PDuint y = uBeginY; y < uEndY; ++y)
+    {
+        const PDuint16* row = &layer.tiles[(PDsizei) y * m_Width];
+        const float fBottom = m_Origin.y + (float) y * m_TileSize, fTop = fBottom + m_TileSize;
+        for (PDuint x = uBeginX; x < uEndX; ++x)
+        {
+            if (row[x] == Empty)
+                continue;
+
+            const PDuint uIndex = row[x] - 1u;
+            const glm::vec2 uvMin((float) (uIndex % uColumns) * tileUV.x,
+                1.0f - (float) (uIndex / uColumns + 1) * tileUV.y);
+            const glm::vec2 uvMax = uvMin + tileUV;
+            const float fLeft = m_Origin.x + (float) x * m_TileSize, fRight = fLeft + m_TileSize;
+
+            vertices.push_back({{fLeft,  fBottom, 0.0f}, {uvMin.x, uvMin.y}});
+            vertices.push_back({{fRight, fBottom, 0.0f}, {uvMax.x, uvMin.y}});
+            vertices.push_back({{fRight, fTop,    0.0f}, {uvMax.x, uvMax.y}});
+            vertices.push_back({{fLeft,  fTop,    0.0f}, {uvMin.x, uvMax.y}});
+        }
+    }
+
+    chunk.quadCount = (PDuint32) (vertices.size() / 4);
+    if (! chunk.quadCount)
+    {
+        // An emptied chunk keeps its buffer in case tiles come back
+        if (chunk.mesh)
+            RenderThread::Enqueue([mesh = chunk.mesh]{ mesh->indexCount = 0; });
+        return;
+    }
+
+    if (! chunk.mesh)
+        chunk.mesh = CreateRef<ChunkMesh>();
+
+    // The mesh is drawn by recorded frames, so it is changed by a command too
+    RenderThread::Enqueue([mesh = chunk.mesh, vertices = PD_MOVE(vertices)]{
+        const PDuint32 uiQuads = (PDuint32) (vertices.size() / 4);
+        if (uiQuads > mesh->capacity)
+        {
+            mesh->vertexArray = VertexArray::Create();
+            mesh->vertexArray->Bind();
+            mesh->vertexBuffer = VertexBuffer::Create((PDsizei) uiQuads * 4 * sizeof(TileVertex));
+            mesh->vertexBuffer->SetLayout({
+                {ShaderDataType::Float3, "in_Position"},
+                {ShaderDataType::Float2, "in_TexCoord"}
+            });
+            mesh->vertexArray->AddVertexBuffer(mesh->vertexBuffer);
+            mesh->vertexArray->SetIndexBuffer(Renderer::GetQuadIndexBuffer());
+            mesh->vertexArray->UnBind();
+            mesh->capacity = uiQuads;
+        }
+
+        mesh->vertexBuffer->SetData(vertices.data(), vertices.size() * sizeof(TileVertex));
+        mesh->indexCount = uiQuads * 6;
+    });
+}
+
+// Returns the corners of the area @a viewProjection maps onto the screen
+static void GetViewBounds(const glm::mat4& viewProjection, glm::vec2& min, glm::vec2& max)
+{
+    const glm::mat4 inverse = glm::inverse(viewProjection);
+    min = glm::vec2(INFINITY);
+    max = glm::vec2(-INFINITY);
+    for (PDuint i = 0; i < 4; ++i)
+    {
+        const glm::vec4 corner = inverse * glm::vec4((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, 0.0f, 1.0f);
+        const glm::vec2 point = glm::vec2(corner) / corner.w;
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+}
+
+void Tilemap::Draw(const OrthoCamera& camera)
+{
+    m_Stats = {0, 0, 0};
+    if (m_Layers.empty() || ! m_ChunksX || ! m_ChunksY)
+        return;
+
+    glm::vec2 viewMin, viewMax;
+    GetViewBounds(camera.GetViewProjectionMatrix(), viewMin, viewMax);
+
+    // Chunks overlapping the view, clamped to the map
+    const float fChunkSize = (float) ChunkSize * m_TileSize;
+    const glm::vec2 first = glm::floor((viewMin - m_Origin) / fChunkSize);
+    const glm::vec2 last = glm::floor((viewMax - m_Origin) / fChunkSize);
+    const PDint iBeginX = std::max(0, (PDint) first.x), iEndX = std::min((PDint) m_ChunksX - 1, (PDint) last.x);
+    const PDint iBeginY = std::max(0, (PDint) first.y), iEndY = std::min((PDint) m_ChunksY - 1, (PDint) last.y);
+
+    struct LayerDraw {
+        glm::vec4 tint;
+        std::vector<Ref<ChunkMesh>> meshes;
+    };
+    std::vector<LayerDraw> draws;
+    PDuint32 uiVisibleLayers = 0;
+    for (Layer& layer : m_Layers)
+    {
+        if (! layer.visible)
+            continue;
+        ++uiVisibleLayers;
+
+        LayerDraw draw = {layer.tint, {}};
+        for (PDint y = iBeginY; y <= iEndY; ++y)
+        {
+            for (PDint x = iBeginX; x <= iEndX; ++x)
+            {
+                Chunk& chunk = layer.chunks[(PDsizei) y * m_ChunksX + x];
+                if (chunk.dirty)
+                {
+                    Rebuild(layer, (PDuint) x, (PDuint) y);
+                    ++m_Stats.chunksRebuilt;
+                }
+                if (chunk.quadCount)
+                {
+                    draw.meshes.push_back(chunk.mesh);
+                    ++m_Stats.chunksDrawn;
+                }
+            }
+        }
+        if (! draw.meshes.empty())
+            draws.push_back(PD_MOVE(draw));
+    }
+
+    const PDuint32 uiInView = (iEndX >= iBeginX && iEndY >= iBeginY) ?
+        (PDuint32) ((iEndX - iBeginX + 1) * (iEndY - iBeginY + 1)) : 0;
+    m_Stats.chunksCulled = (PDuint32) (m_ChunksX * m_ChunksY - uiInView) * uiVisibleLayers;
+    if (draws.empty())
+        return;
+
+    RenderCommand::BeginPass("Tilemap");
+    RenderThread::Enqueue([draws = PD_MOVE(draws), tileset = m_Tileset,
+        viewProjection = camera.GetViewProjectionMatrix()]{
+        Renderer::SetCamera(viewProjection);
+        if (! _Shader)
+        {
+            _Shader = Renderer::CreateShader(_VertexShaderSource, _FragmentShaderSource);
+            _Shader->Bind();
+            _Shader->SetInt1(UniformId("u_Texture"), 0);
+        }
+        if (! _Shader->Bind())
+            return;
+        tileset->Bind(0);
+
+        for (const LayerDraw& draw : draws)
+        {
+            _Shader->SetFloat4(UniformId("u_Color"), draw.tint.x, draw.tint.y, draw.tint.z, draw.tint.w);
+            for (const Ref<ChunkMesh>& mesh : draw.meshes)
+            {
+                // The shared quad indices are drawn whole for an index count of 0
+                if (! mesh->indexCount)
+                    continue;
+                mesh->vertexArray->Bind();
+                RenderCommand::DrawIndexed(mesh->vertexArray, mesh->indexCount);
+            }
+        }
+    });
+    RenderCommand::EndPass();
+}
+
+}
@@ -0,0 +1,143 @@
+#ifndef DEWPSI_TILEMAP_H
+#define DEWPSI_TILEMAP_H
+
+/** @file Dewpsi_Tilemap.h
+*   @ref core_renderer
+*/
+
+#include <Dewpsi_Core.h>
+#include <Dewpsi_Memory.h>
+#include <Dewpsi_Texture.h>
+#include <Dewpsi_OrthoCamera.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Dewpsi {
+    /** A grid of tiles drawn from a tileset texture, with any number of layers.
+    *   Every layer is split into chunks of ChunkSize by ChunkSize tiles. A chunk is baked into
+    *   a vertex buffer of its own the first time it is seen, and is only rebuilt when one of its
+    *   tiles changes, so a map that does not change costs no vertex work per frame. Draw() skips
+    *   the chunks outside the view of the camera, and draws the rest with one draw call each.
+    *
+    *   Tiles are numbered from 1 in the tileset, left to right and then top to bottom;
+    *   0 is an empty cell. Tile (0, 0) is the bottom-left one. The tileset should be sampled
+    *   with TextureFilter::Nearest and no mipmaps, so neighboring tiles do not bleed in.
+    *
+    *   @code{.cpp}
+        // In OnAttach()
+        m_Map = Dewpsi::CreateScope<Dewpsi::Tilemap>(256, 256, m_Tileset, 16);
+        PDuint uGround = m_Map->AddLayer();
+        m_Map->Fill(uGround, 0, 0, 256, 256, 1);
+
+        // In OnUpdate(), after the scene has been cleared
+        m_Map->Draw(m_CameraController.GetCamera());
+    *   @endcode
+    *   @ingroup core_renderer
+    */
+    class Tilemap {
+    public:
+        /// Width and height of a chunk, in tiles.
+        static constexpr PDuint ChunkSize = 32;
+
+        /// The tile of an empty cell.
+        static constexpr PDuint16 Empty = 0;
+
+        /// What the last Draw() did.
+        struct Statistics {
+            PDuint32 chunksDrawn;   ///< Chunks in view with tiles to draw
+            PDuint32 chunksCulled;  ///< Chunks of visible layers outside the view
+            PDuint32 chunksRebuilt; ///< Chunks whose vertices were built again
+        };
+
+        /** Creates a map of @a width by @a height tiles without layers.
+        *   @param tileset     The texture holding the tiles in a grid
+        *   @param tilePixels  The width and height of a tile in the tileset, in texels
+        *   @param tileSize    The width and height of a tile in world units
+        *   @param origin      The position of the bottom-left corner of tile (0, 0)
+        */
+        Tilemap(PDuint width, PDuint height, const Ref<Texture2D>& tileset, PDuint tilePixels,
+            float tileSize = 1.0f, const glm::vec2& origin = glm::vec2(0.0f));
+        ~Tilemap();
+
+        Tilemap(const Tilemap&) = delete;
+        Tilemap& operator=(const Tilemap&) = delete;
+
+        /** Adds an empty layer, drawn over the ones added before it.
+        *   @param tint  The color the tiles of the layer are multiplied with
+        *   @return      The index of the layer
+        */
+        PDuint AddLayer(const glm::vec4& tint = glm::vec4(1.0f));
+
+        /// Returns the number of layers.
+        PDuint GetLayerCount() const {return (PDuint) m_Layers.size();}
+
+        /// Sets the color the tiles of @a layer are multiplied with.
+        void SetLayerTint(PDuint layer, const glm::vec4& tint);
+
+        /// Shows or hides @a layer.
+        void SetLayerVisible(PDuint layer, bool visible);
+
+        /// Sets the tile at @a x, @a y; only the chunk it is in is rebuilt.
+        void SetTile(PDuint layer, PDuint x, PDuint y, PDuint16 tile);
+
+        /// Returns the tile at @a x, @a y.
+        PDuint16 GetTile(PDuint layer, PDuint x, PDuint y) const;
+
+        /// Sets every tile of a rectangle, clipped to the map.
+        void Fill(PDuint layer, PDuint x, PDuint y, PDuint width, PDuint height, PDuint16 tile);
+
+        /** Draws the chunks in view of @a camera, rebuilding the ones that changed.
+        *   Uses its own shader, so it is drawn outside Renderer2D::BeginScene() and
+        *   Renderer2D::EndScene(); draw the map first to put sprites on top of it.
+        */
+        void Draw(const OrthoCamera& camera);
+
+        /// Returns the width of the map in tiles.
+        PDuint GetWidth() const {return m_Width;}
+
+        /// Returns the height of the map in tiles.
+        PDuint GetHeight() const {return m_Height;}
+
+        /// Returns the width and height of a tile in world units.
+        float GetTileSize() const {return m_TileSize;}
+
+        /// Returns what the last Draw() did.
+        const Statistics& GetStats() const {return m_Stats;}
+
+        /// Destroys the shader created by the first Draw(); called by Renderer::Shutdown().
+        static void Shutdown();
+
+    private:
+        // GPU objects of a chunk
+        struct ChunkMesh;
+
+        struct Chunk {
+            Ref<ChunkMesh> mesh;
+            PDuint32 quadCount = 0;
+            bool dirty = true;
+        };
+
+        struct Layer {
+            std::vector<PDuint16> tiles;    // row by row, bottom row first
+            std::vector<Chunk> chunks;
+            glm::vec4 tint;
+            bool visible = true;
+        };
+
+        Chunk& GetChunk(Layer& layer, PDuint x, PDuint y);
+        void Rebuild(Layer& layer, PDuint chunkX, PDuint chunkY);
+
+        PDuint m_Width;
+        PDuint m_Height;
+        PDuint m_ChunksX;
+        PDuint m_ChunksY;
+        Ref<Texture2D> m_Tileset;
+        PDuint m_TilePixels;
+        float m_TileSize;
+        glm::vec2 m_Origin;
+        std::vector<Layer> m_Layers;
+        Statistics m_Stats = {0, 0, 0};
+    };
+}
+
+#endif /* DEWPSI_TILEMAP_H */
@@ -0,0 +1,674 @@
+#include "Dewpsi_TrueType.h"
+#include "Dewpsi_Log.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Dewpsi {
+
+static constexpr PDuint32 Tag(const char (&name)[5])
+{
+    return ((PDuint32) (PDuchar) name[0] << 24) | ((PDuint32) (PDuchar) name[1] << 16)
+        | ((PDuint32) (PDuchar) name[2] << 8) | (PDuint32) (PDuchar) name[3];
+}
+
+// Composite glyph flags
+enum : PDuint16 {
+    ArgsAreWords    = 0x0001,
+    ArgsAreXY       = 0x0002,
+    HaveScale       = 0x0008,
+    MoreComponents  = 0x0020,
+    HaveXYScale     = 0x0040,
+    HaveTwoByTwo    = 0x0080
+};
+
+// Simple glyph point flags
+enum : PDuchar {
+    OnCurve     = 0x01,
+    ShortX      = 0x02,
+    ShortY      = 0x04,
+    Repeat      = 0x08,
+    SameX       = 0x10,   // or positive, for a short coordinate
+    SameY       = 0x20
+};
+
+// Composites may nest; deeper ones are malformed or malicious
+static constexpr PDuint _MaxCompositeDepth = 8;
+
+// Composites can reuse a component many times over; outlines past this many points are cut off
+static constexpr PDsizei _MaxOutlinePoints = 1 << 20;
+
+// Coordinates are tested against this before they are converted to pixel indices
+static constexpr float _MaxCoordinate = 1 << 24;
+
+PDuint16 TrueTypeFont::ReadU16(PDsizei offset) const
+{
+    if (offset + 2 > m_Data.size())
+        return 0;
+    return (PDuint16) ((m_Data[offset] << 8) | m_Data[offset + 1]);
+}
+
+PDuint32 TrueTypeFont::ReadU32(PDsizei offset) const
+{
+    if (offset + 4 > m_Data.size())
+        return 0;
+    return ((PDuint32) m_Data[offset] << 24) | ((PDuint32) m_Data[offset + 1] << 16)
+        | ((PDuint32) m_Data[offset + 2] << 8) | (PDuint32) m_Data[offset + 3];
+}
+
+PDsizei TrueTypeFont::FindTable(PDsizei fontOffset, const char* tag) const
+{
+    const PDuint32 uiTag = ((PDuint32) (PDuchar) tag[0] << 24) | ((PDuint32) (PDuchar) tag[1] << 16)
+        | ((PDuint32) (PDuchar) tag[2] << 8) | (PDuint32) (PDuchar) tag[3];
+    const PDuint uTableCount = ReadU16(fontOffset + 4);
+    for (PDuint i = 0; i < uTableCount; ++i)
+    {
+        const PDsizei szRecord = fontOffset + 12 + 16 * (PDsizei) i;
+        if (ReadU32(szRecord) == uiTag)
+        {
+            const PDsizei szOffset = ReadU32(szRecord + 8);
+            return (szOffset < m_Data.size()) ? szOffset : 0;
+        }
+    }
+    return 0;
+}
+
+bool TrueTypeFont::Load(const void* data, PDsizei size, PDuint index)
+{
+    *this = TrueTypeFont();
+    m_Data.assign((const PDuchar*) data, (const PDuchar*) data + size);
+
+    // A collection starts with a list of the fonts in it
+    PDsizei szFont = 0;
+    if (ReadU32(0) == Tag("ttcf"))
+    {
+        if (index >= ReadU32(8))
+        {
+            m_Data.clear();
+            SetError("Font collection has no font %u", index);
+            return false;
+        }
+        szFont = ReadU32(12 + 4 * (PDsizei) index);
+    }
+    else if (index)
+    {
+        m_Data.clear();
+        SetError("Font index %u given for a file that is not a collection", index);
+        return false;
+    }
+
+    const PDuint32 uiVersion = ReadU32(szFont);
+    if (uiVersion == Tag("OTTO"))
+    {
+        m_Data.clear();
+        SetError("Fonts with CFF outlines are not supported");
+        return false;
+    }
+    if (uiVersion != 0x00010000 && uiVersion != Tag("true"))
+    {
+        m_Data.clear();
+        SetError("Not a TrueType font");
+        return false;
+    }
+
+    const PDsizei szHead = FindTable(szFont, "head");
+    const PDsizei szHhea = FindTable(szFont, "hhea");
+    const PDsizei szMaxp = FindTable(szFont, "maxp");
+    const PDsizei szCmap = FindTable(szFont, "cmap");
+    m_Hmtx = FindTable(szFont, "hmtx");
+    m_Loca = FindTable(szFont, "loca");
+    m_Glyf = FindTable(szFont, "glyf");
+    if (! szHead || ! szHhea || ! szMaxp || ! szCmap || ! m_Hmtx || ! m_Loca || ! m_Glyf)
+    {
+        m_Data.clear();
+        SetError("Font is missing a required table");
+        return false;
+    }
+
+    m_UnitsPerEm = ReadU16(szHead + 18);
+    m_LongLoca = ReadI16(szHead + 50) != 0;
+    m_GlyphCount = ReadU16(szMaxp + 4);
+    m_Ascent = ReadI16(szHhea + 4);
+    m_Descent = ReadI16(szHhea + 6);
+    m_LineGap = ReadI16(szHhea + 8);
+    m_HMetricCount = ReadU16(szHhea + 34);
+    if (! m_UnitsPerEm || ! m_HMetricCount || m_Ascent <= m_Descent)
+    {
+        m_Data.clear();
+        SetError("Font has invalid metrics");
+        return false;
+    }
+
+    // Prefer the full Unicode map (format 12), then the Basic Multilingual Plane (format 4)
+    const PDuint uSubtableCount = ReadU16(szCmap + 2);
+    for (PDuint i = 0; i < uSubtableCount; ++i)
+    {
+        const PDsizei szRecord = szCmap + 4 + 8 * (PDsizei) i;
+        const PDuint uPlatform = ReadU16(szRecord);
+        const PDuint uEncoding = ReadU16(szRecord + 2);
+        const PDsizei szSubtable = szCmap + ReadU32(szRecord + 4);
+        const PDuint uFormat = ReadU16(szSubtable);
+        const bool bUnicode = uPlatform == 0 || (uPlatform == 3 && (uEncoding == 1 || uEncoding == 10));
+        if (! bUnicode)
+            continue;
+
+        if (uFormat == 12)
+        {
+            m_Cmap = szSubtable;
+            break;
+        }
+        if (uFormat == 4 && ! m_Cmap)
+            m_Cmap = szSubtable;
+    }
+    if (! m_Cmap)
+    {
+        m_Data.clear();
+        SetError("Font has no Unicode character map");
+        return false;
+    }
+
+    // Only the first subtable is read, and only if it holds horizontal pairs (format 0)
+    const PDsizei szKern = FindTable(szFont, "kern");
+    if (szKern && ReadU16(szKern) == 0 && ReadU16(szKern + 2) > 0)
+    {
+        const PDuint uCoverage = ReadU16(szKern + 8);
+        if ((uCoverage >> 8) == 0 && (uCoverage & 1) && ! (uCoverage & 4))
+            m_Kern = szKern + 4;
+    }
+
+    return true;
+}
+
+PDuint TrueTypeFont::FindGlyph(PDuint32 codepoint) const
+{
+    if (! IsLoaded())
+        return 0;
+
+    if (ReadU16(m_Cmap) == 12)
+    {
+        PDsizei szLow = 0, szHigh = ReadU32(m_Cmap + 12);
+        while (szLow < szHigh)
+        {
+            const PDsizei szMid = (szLow + szHigh) / 2;
+            const PDsizei szGroup = m_Cmap + 16 + 12 * szMid;
+            const PDuint32 uiStart = ReadU32(szGroup), uiEnd = ReadU32(szGroup + 4);
+            if (codepoint < uiStart)
+                szHigh = szMid;
+            else if (codepoint > uiEnd)
+                szLow = szMid + 1;
+            else
+                return ReadU32(szGroup + 8) + (codepoint - uiStart);
+        }
+        return 0;
+    }
+
+    // Format 4: segments sorted by their last code
+    if (codepoint > 0xFFFF)
+        return 0;
+
+    const PDsizei szSegCount = ReadU16(m_Cmap + 6) / 2;
+    const PDsizei szEnds = m_Cmap + 14;
+    const PDsizei szStarts = szEnds + 2 * szSegCount + 2;
+    const PDsizei szDeltas = szStarts + 2 * szSegCount;
+    const PDsizei szRangeOffsets = szDeltas + 2 * szSegCount;
+
+    PDsizei szLow = 0, szHigh = szSegCount;
+    while (szLow < szHigh)
+    {
+        const PDsizei szMid = (szLow + szHigh) / 2;
+        if (ReadU16(szEnds + 2 * szMid) < codepoint)
+            szLow = szMid + 1;
+        else
+            szHigh = szMid;
+    }
+    if (szLow == szSegCount)
+        return 0;
+
+    const PDuint uStart = ReadU16(szStarts + 2 * szLow);
+    if (codepoint < uStart)
+        return 0;
+
+    const PDuint uDelta = ReadU16(szDeltas + 2 * szLow);
+    const PDuint uRangeOffset = ReadU16(szRangeOffsets + 2 * szLow);
+    if (! uRangeOffset)
+        return (codepoint + uDelta) & 0xFFFF;
+
+    // The offset is relative to where it is stored
+    const PDuint uGlyph = ReadU16(szRangeOffsets + 2 * szLow + uRangeOffset + 2 * (codepoint - uStart));
+    return uGlyph ? (uGlyph + uDelta) & 0xFFFF : 0;
+}
+
+void TrueTypeFont::GetVerticalMetrics(PDint& ascent, PDint& descent, PDint& lineGap) const
+{
+    ascent = m_Ascent;
+    descent = m_Descent;
+    lineGap = m_LineGap;
+}
+
+PDint TrueTypeFont::GetAdvance(PDuint glyph) const
+{
+    if (! IsLoaded())
+        return 0;
+
+    // Glyphs past the last metric share its advance
+    const PDuint uMetric = std::min(glyph, m_HMetricCount - 1);
+    return ReadU16(m_Hmtx + 4 * (PDsizei) uMetric);
+}
+
+PDint TrueTypeFont::GetKerning(PDuint left, PDuint right) const
+{
+    if (! m_Kern)
+        return 0;
+
+    const PDuint32 uiKey = ((PDuint32) left << 16) | right;
+    PDsizei szLow = 0, szHigh = ReadU16(m_Kern + 6);
+    while (szLow < szHigh)
+    {
+        const PDsizei szMid = (szLow + szHigh) / 2;
+        const PDsizei szPair = m_Kern + 14 + 6 * szMid;
+        const PDuint32 uiPair = ReadU32(szPair);
+        if (uiKey < uiPair)
+            szHigh = szMid;
+        else if (uiKey > uiPair)
+            szLow = szMid + 1;
+        else
+            return ReadI16(szPair + 4);
+    }
+    return 0;
+}
+
+bool TrueTypeFont::GetGlyphRange(PDuint glyph, PDsizei& offset, PDsizei& length) const
+{
+    if (glyph >= m_GlyphCount)
+        return false;
+
+    PDsizei szStart, szEnd;
+    if (m_LongLoca)
+    {
+        szStart = ReadU32(m_Loca + 4 * (PDsizei) glyph);
+        szEnd = ReadU32(m_Loca + 4 * (PDsizei) glyph + 4);
+    }
+    else
+    {
+        szStart = 2 * (PDsizei) ReadU16(m_Loca + 2 * (PDsizei) glyph);
+        szEnd = 2 * (PDsizei) ReadU16(m_Loca + 2 * (PDsizei) glyph + 2);
+    }
+
+    if (szEnd <= szStart || m_Glyf + szEnd > m_Data.size())
+        return false;
+    offset = m_Glyf + szStart;
+    length = szEnd - szStart;
+    return true;
+}
+
+void TrueTypeFont::Flatten(PDuint glyph, const float (&matrix)[6], float tolerance,
+    std::vector<Point>& points, std::vector<PDsizei>& contourEnds, std::vector<Point>& numbered,
+    PDuint depth) const
+{
+    PDsizei szGlyph, szLength;
+    if (points.size() >= _MaxOutlinePoints || ! GetGlyphRange(glyph, szGlyph, szLength))
+        return;
+
+    const PDint iContourCount = ReadI16(szGlyph);
+    if (iContourCount < 0)
+    {
+        if (depth >= _MaxCompositeDepth)
+            return;
+
+        // Point numbers of matched components count the points of the components before them
+        const PDsizei szFirstPoint = numbered.size();
+        PDsizei szPos = szGlyph + 10;
+        PDuint16 uFlags;
+        do
+        {
+            uFlags = ReadU16(szPos);
+            const PDuint uComponent = ReadU16(szPos + 2);
+            szPos += 4;
+
+            PDuint16 uArg1, uArg2;
+            if (uFlags & ArgsAreWords)
+            {
+                uArg1 = ReadU16(szPos);
+                uArg2 = ReadU16(szPos + 2);
+                szPos += 4;
+            }
+            else
+            {
+                uArg1 = ReadU16(szPos) >> 8;
+                uArg2 = ReadU16(szPos) & 0xFF;
+                szPos += 2;
+            }
+
+            float a = 1.0f, b = 0.0f, c = 0.0f, d = 1.0f;
+            if (uFlags & HaveScale)
+            {
+                a = d = ReadI16(szPos) / 16384.0f;
+                szPos += 2;
+            }
+            else if (uFlags & HaveXYScale)
+            {
+                a = ReadI16(szPos) / 16384.0f;
+                d = ReadI16(szPos + 2) / 16384.0f;
+                szPos += 4;
+            }
+            else if (uFlags & HaveTwoByTwo)
+            {
+                a = ReadI16(szPos) / 16384.0f;
+                b = ReadI16(szPos + 2) / 16384.0f;
+                c = ReadI16(szPos + 4) / 16384.0f;
+                d = ReadI16(szPos + 6) / 16384.0f;
+                szPos += 8;
+            }
+
+            // The component transform applies first, then the parent's
+            const float (&m)[6] = matrix;
+            if (uFlags & ArgsAreXY)
+            {
+                const float fDx = (uFlags & ArgsAreWords) ? (PDint16) uArg1 : (PDint8) uArg1;
+                const float fDy = (uFlags & ArgsAreWords) ? (PDint16) uArg2 : (PDint8) uArg2;
+                const float child[6] = {
+                    m[0] * a + m[2] * b, m[1] * a + m[3] * b,
+                    m[0] * c + m[2] * d, m[1] * c + m[3] * d,
+                    m[0] * fDx + m[2] * fDy + m[4], m[1] * fDx + m[3] * fDy + m[5]
+                };
+                Flatten(uComponent, child, tolerance, points, contourEnds, numbered, depth + 1);
+            }
+            else
+            {
+                /*  The component is moved so that its point uArg2 lands on point uArg1 of the
+                    components before it. Both are transformed by the same linear map, so the
+                    offset can be taken after the transform. */
+                const float child[6] = {
+                    m[0] * a + m[2] * b, m[1] * a + m[3] * b,
+                    m[0] * c + m[2] * d, m[1] * c + m[3] * d,
+                    m[4], m[5]
+                };
+                std::vector<Point> componentPoints, componentNumbered;
+                std::vector<PDsizei> componentEnds;
+                Flatten(uComponent, child, tolerance, componentPoints, componentEnds, componentNumbered,
+                    depth + 1);
+
+                Point offset = {0.0f, 0.0f};
+                if (szFirstPoint + uArg1 < numbered.size() && uArg2 < componentNumbered.size())
+                {
+                    offset.x = numbered[szFirstPoint + uArg1].x - componentNumbered[uArg2].x;
+                    offset.y = numbered[szFirstPoint + uArg1].y - componentNumbered[uArg2].y;
+                }
+
+                const PDsizei szBase = points.size();
+                for (const Point& point : componentPoints)
+                    points.push_back({point.x + offset.x, point.y + offset.y});
+                for (PDsizei szEnd : componentEnds)
+                    contourEnds.push_back(szBase + szEnd);
+                for (const Point& point : componentNumbered)
+                    numbered.push_back({point.x + offset.x, point.y + offset.y});
+            }
+        }
+        while ((uFlags & MoreComponents) && szPos < szGlyph + szLength && points.size() < _MaxOutlinePoints);
+        return;
+    }
+
+    if (! iContourCount)
+        return;
+
+    // Simple glyph: contour ends, instructions, then flags and coordinates
+    const PDsizei szEnds = szGlyph + 10;
+    const PDuint uPointCount = (PDuint) ReadU16(szEnds + 2 * (PDsizei) (iContourCount - 1)) + 1;
+    const PDsizei szInstructions = ReadU16(szEnds + 2 * (PDsizei) iContourCount);
+    PDsizei szPos = szEnds + 2 * (PDsizei) iContourCount + 2 + szInstructions;
+
+    std::vector<PDuchar> flags(uPointCount);
+    for (PDuint i = 0; i < uPointCount && szPos < m_Data.size(); )
+    {
+        const PDuchar ucFlag = m_Data[szPos++];
+        PDuint uCount = 1;
+        if ((ucFlag & Repeat) && szPos < m_Data.size())
+            uCount += m_Data[szPos++];
+        for (; uCount && i < uPointCount; --uCount)
+            flags[i++] = ucFlag;
+    }
+
+    std::vector<Point> outline(uPointCount);
+    PDint iCoord = 0;
+    for (PDuint i = 0; i < uPointCount; ++i)
+    {
+        if (flags[i] & ShortX)
+        {
+            const PDint iDelta = (szPos < m_Data.size()) ? m_Data[szPos] : 0;
+            iCoord += (flags[i] & SameX) ? iDelta : -iDelta;
+            szPos += 1;
+        }
+        else if (! (flags[i] & SameX))
+        {
+            iCoord += ReadI16(szPos);
+            szPos += 2;
+        }
+        outline[i].x = (float) iCoord;
+    }
+    iCoord = 0;
+    for (PDuint i = 0; i < uPointCount; ++i)
+    {
+        if (flags[i] & ShortY)
+        {
+            const PDint iDelta = (szPos < m_Data.size()) ? m_Data[szPos] : 0;
+            iCoord += (flags[i] & SameY) ? iDelta : -iDelta;
+            szPos += 1;
+        }
+        else if (! (flags[i] & SameY))
+        {
+            iCoord += ReadI16(szPos);
+            szPos += 2;
+        }
+        outline[i].y = (float) iCoord;
+    }
+
+    for (Point& point : outline)
+    {
+        const Point p = point;
+        point.x = matrix[0] * p.x + matrix[2] * p.y + matrix[4];
+        point.y = matrix[1] * p.x + matrix[3] * p.y + matrix[5];
+    }
+    numbered.insert(numbered.end(), outline.begin(), outline.end());
+
+    auto Midpoint = [](const Point& p, const Point& q) {
+        return Point{(p.x + q.x) * 0.5f, (p.y + q.y) * 0.5f};
+    };
+
+    // Quadratic curves are split into segments short enough to stay within the tolerance
+    auto Curve = [&](const Point& p0, const Point& control, const Point& p1) {
+        const float fDx = p0.x - 2.0f * control.x + p1.x;
+        const float fDy = p0.y - 2.0f * control.y + p1.y;
+        const float fDeviation = std::sqrt(fDx * fDx + fDy * fDy) * 0.25f;
+        const PDint iSegments = std::min(16, 1 + (PDint) std::sqrt(fDeviation / tolerance));
+        for (PDint s = 1; s <= iSegments; ++s)
+        {
+            const float t = (float) s / (float) iSegments, u = 1.0f - t;
+            points.push_back({u * u * p0.x + 2.0f * u * t * control.x + t * t * p1.x,
+                u * u * p0.y + 2.0f * u * t * control.y + t * t * p1.y});
+        }
+    };
+
+    PDuint uFirst = 0;
+    for (PDint iContour = 0; iContour < iContourCount; ++iContour)
+    {
+        const PDuint uLast = std::min((PDuint) ReadU16(szEnds + 2 * (PDsizei) iContour), uPointCount - 1);
+        if (uLast < uFirst)
+            continue;
+        const PDuint uCount = uLast - uFirst + 1;
+
+        // Start on a point on the curve; if there is none, between the last and first points
+        PDuint uStart = uCount;
+        for (PDuint i = 0; i < uCount; ++i)
+        {
+            if (flags[uFirst + i] & OnCurve)
+            {
+                uStart = i;
+                break;
+            }
+        }
+
+        const Point start = (uStart < uCount) ? outline[uFirst + uStart]
+            : Midpoint(outline[uLast], outline[uFirst]);
+        points.push_back(start);
+
+        Point current = start, control = {};
+        bool bControl = false;
+        const PDuint uSteps = (uStart < uCount) ? uCount : uCount + 1;
+        for (PDuint s = 1; s <= uSteps; ++s)
+        {
+            // The walk ends back on the start point, which is on the curve
+            const bool bEnd = s == uSteps;
+            const PDuint uIndex = uFirst + ((uStart < uCount ? uStart : uCount - 1) + s) % uCount;
+            const Point point = bEnd ? start : outline[uIndex];
+            const bool bOn = bEnd || (flags[uIndex] & OnCurve);
+
+            if (bOn)
+            {
+                if (bControl)
+                    Curve(current, control, point);
+                else
+                    points.push_back(point);
+                current = point;
+                bControl = false;
+            }
+            else
+            {
+                // Two controls in a row imply a point on the curve between them
+                if (bControl)
+                {
+                    const Point middle = Midpoint(control, point);
+                    Curve(current, control, middle);
+                    current = middle;
+                }
+                control = point;
+                bControl = true;
+            }
+        }
+
+        contourEnds.push_back(points.size());
+        uFirst = uLast + 1;
+    }
+}
+
+bool TrueTypeFont::Rasterize(PDuint glyph, float scale, PDint maxSize, Bitmap& bitmap) const
+{
+    bitmap.coverage.clear();
+    bitmap.width = bitmap.height = bitmap.left = bitmap.bottom = 0;
+
+    std::vector<Point> points;
+    std::vector<PDsizei> contourEnds;
+    const float matrix[6] = {scale, 0.0f, 0.0f, scale, 0.0f, 0.0f};
+    std::vector<Point> numbered;
+    Flatten(glyph, matrix, 0.2f, points, contourEnds, numbered, 0);
+    if (points.empty())
+        return false;
+
+    float fMinX = points[0].x, fMaxX = points[0].x, fMinY = points[0].y, fMaxY = points[0].y;
+    for (const Point& point : points)
+    {
+        fMinX = std::min(fMinX, point.x);
+        fMaxX = std::max(fMaxX, point.x);
+        fMinY = std::min(fMinY, point.y);
+        fMaxY = std::max(fMaxY, point.y);
+    }
+
+    // Component scales come from the font, so the size is checked before anything is allocated
+    if (! (std::fabs(fMinX) < _MaxCoordinate && std::fabs(fMaxX) < _MaxCoordinate
+        && std::fabs(fMinY) < _MaxCoordinate && std::fabs(fMaxY) < _MaxCoordinate))
+        return false;
+    const PDint iLeft = (PDint) std::floor(fMinX), iRight = (PDint) std::ceil(fMaxX);
+    const PDint iBottom = (PDint) std::floor(fMinY), iTop = (PDint) std::ceil(fMaxY);
+    const PDint w = iRight - iLeft, h = iTop - iBottom;
+    if (w <= 0 || h <= 0 || w >= maxSize || h >= maxSize)
+        return false;
+
+    /*  Every edge adds the signed area it covers to the cells it crosses, and the running
+        sum of a row is the coverage of each pixel. What an edge adds to the cell right of a
+        row lands on the first cell of the next row, which the sum carries over unchanged. */
+    std::vector<float> accumulation((PDsizei) w * h + 2, 0.0f);
+    PDsizei szFirst = 0;
+    for (PDsizei szEnd : contourEnds)
+    {
+        for (PDsizei i = szFirst; i + 1 < szEnd; ++i)
+        {
+            // Bitmap space: rows from the top
+            float fX0 = points[i].x - (float) iLeft, fY0 = (float) iTop - points[i].y;
+            float fX1 = points[i + 1].x - (float) iLeft, fY1 = (float) iTop - points[i + 1].y;
+            if (fY0 == fY1)
+                continue;
+
+            float fDirection = 1.0f;
+            if (fY0 > fY1)
+            {
+                std::swap(fX0, fX1);
+                std::swap(fY0, fY1);
+                fDirection = -1.0f;
+            }
+
+            const float fDxDy = (fX1 - fX0) / (fY1 - fY0);
+            float x = fX0;
+            const PDint iRowEnd = std::min(h, (PDint) std::ceil(fY1));
+            for (PDint y = std::max(0, (PDint) fY0); y < iRowEnd; ++y)
+            {
+                float* row = &accumulation[(PDsizei) y * w];
+                const float fDy = std::min((float) (y + 1), fY1) - std::max((float) y, fY0);
+                const float fNextX = x + fDxDy * fDy;
+                const float d = fDy * fDirection;
+
+                const float fLow = std::max(0.0f, std::min(x, fNextX));
+                const float fHigh = std::min((float) w, std::max(x, fNextX));
+                const float fLowFloor = std::floor(fLow);
+                const PDint iLow = (PDint) fLowFloor;
+                const PDint iHigh = (PDint) std::ceil(fHigh);
+                if (iHigh <= iLow + 1)
+                {
+                    // The edge stays within one cell
+                    const float fMid = 0.5f * (x + fNextX) - fLowFloor;
+                    row[iLow] += d - d * fMid;
+                    row[iLow + 1] += d * fMid;
+                }
+                else
+                {
+                    const float fInverse = 1.0f / (fHigh - fLow);
+                    const float fLowFrac = fLow - fLowFloor;
+                    const float fFirst = 0.5f * fInverse * (1.0f - fLowFrac) * (1.0f - fLowFrac);
+                    const float fHighFrac = fHigh - (float) iHigh + 1.0f;
+                    const float fLast = 0.5f * fInverse * fHighFrac * fHighFrac;
+
+                    row[iLow] += d * fFirst;
+                    if (iHigh == iLow + 2)
+                        row[iLow + 1] += d * (1.0f - fFirst - fLast);
+                    else
+                    {
+                        const float fSecond = fInverse * (1.5f - fLowFrac);
+                        row[iLow + 1] += d * (fSecond - fFirst);
+                        for (PDint xi = iLow + 2; xi < iHigh - 1; ++xi)
+                            row[xi] += d * fInverse;
+                        const float fBeforeLast = fSecond + (float) (iHigh - iLow - 3) * fInverse;
+                        row[iHigh - 1] += d * (1.0f - fBeforeLast - fLast);
+                    }
+                    row[iHigh] += d * fLast;
+                }
+                x = fNextX;
+            }
+        }
+        szFirst = szEnd;
+    }
+
+    bitmap.coverage.resize((PDsizei) w * h);
+    float fSum = 0.0f;
+    for (PDsizei i = 0; i < bitmap.coverage.size(); ++i)
+    {
+        fSum += accumulation[i];
+        const float fCoverage = std::min(1.0f, std::fabs(fSum));
+        bitmap.coverage[i] = (PDuchar) (fCoverage * 255.0f + 0.5f);
+    }
+
+    bitmap.width = w;
+    bitmap.height = h;
+    bitmap.left = iLeft;
+    bitmap.bottom = iBottom;
+    return true;
+}
+
+}
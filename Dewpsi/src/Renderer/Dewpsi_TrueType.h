@@ -0,0 +1,102 @@
+#ifndef DEWPSI_TRUETYPE_H
+#define DEWPSI_TRUETYPE_H
+
+/** @file Dewpsi_TrueType.h
+*   @ref core_renderer
+*/
+
+#include <Dewpsi_Core.h>
+#include <vector>
+
+namespace Dewpsi {
+    /** Reads glyph outlines and metrics out of a TrueType font and rasterizes them.
+    *   Only what text rendering needs is supported: the @c cmap formats 4 and 12, simple and
+    *   composite @c glyf outlines, horizontal metrics and @c kern format 0 pairs. Fonts with
+    *   CFF outlines (most .otf files) are rejected. The font data is copied, so the buffer
+    *   passed to Load() can be freed afterwards.
+    *   @ingroup core_renderer
+    */
+    class TrueTypeFont {
+    public:
+        /// A rasterized glyph; rows are stored top first.
+        struct Bitmap {
+            std::vector<PDuchar> coverage; ///< One byte per pixel, 255 is fully covered
+            PDint width;    ///< Width in pixels
+            PDint height;   ///< Height in pixels
+            PDint left;     ///< Offset of the left edge from the pen position, in pixels
+            PDint bottom;   ///< Offset of the bottom edge from the baseline, in pixels, y up
+        };
+
+        TrueTypeFont() = default;
+
+        /** Parses the font in @a data.
+        *   @param index  The font to use in a collection (.ttc), 0 otherwise
+        *   @return       @c false if the data is not a supported font; see SetError()
+        */
+        bool Load(const void* data, PDsizei size, PDuint index = 0);
+
+        /// Returns true if a font was loaded.
+        bool IsLoaded() const {return ! m_Data.empty();}
+
+        /// Returns the glyph of @a codepoint, or 0 (the missing glyph) if there is none.
+        PDuint FindGlyph(PDuint32 codepoint) const;
+
+        /// Returns the number of font units per em.
+        PDuint GetUnitsPerEm() const {return m_UnitsPerEm;}
+
+        /// Returns the scale that makes the distance from the descender to the ascender @a pixels tall.
+        float GetScaleForPixelHeight(float pixels) const
+        { return pixels / (float) (m_Ascent - m_Descent); }
+
+        /// Gets the ascender, descender (negative) and line gap in font units.
+        void GetVerticalMetrics(PDint& ascent, PDint& descent, PDint& lineGap) const;
+
+        /// Returns the horizontal advance of @a glyph in font units.
+        PDint GetAdvance(PDuint glyph) const;
+
+        /// Returns the kerning between @a left and @a right in font units.
+        PDint GetKerning(PDuint left, PDuint right) const;
+
+        /** Rasterizes @a glyph with antialiasing.
+        *   @param scale    Pixels per font unit, see GetScaleForPixelHeight()
+        *   @param maxSize  Glyphs at least this wide or tall are not rasterized; nothing is
+        *                   allocated for them
+        *   @return         @c false if the glyph is empty (e.g. a space) or too large; @a bitmap
+        *                   is then 0x0
+        */
+        bool Rasterize(PDuint glyph, float scale, PDint maxSize, Bitmap& bitmap) const;
+
+    private:
+        struct Point {
+            float x, y;
+        };
+
+        PDuint16 ReadU16(PDsizei offset) const;
+        PDint16 ReadI16(PDsizei offset) const {return (PDint16) ReadU16(offset);}
+        PDuint32 ReadU32(PDsizei offset) const;
+        PDsizei FindTable(PDsizei fontOffset, const char* tag) const;
+        bool GetGlyphRange(PDuint glyph, PDsizei& offset, PDsizei& length) const;
+
+        /* Appends the outline of @a glyph as closed polylines, in font units transformed by @a matrix.
+           The points of the outline itself are appended to @a numbered in point number order, for
+           components that are positioned by matching points. */
+        void Flatten(PDuint glyph, const float (&matrix)[6], float tolerance, std::vector<Point>& points,
+            std::vector<PDsizei>& contourEnds, std::vector<Point>& numbered, PDuint depth) const;
+
+        std::vector<PDuchar> m_Data;
+        PDsizei m_Cmap = 0;     // the chosen cmap subtable
+        PDsizei m_Loca = 0;
+        PDsizei m_Glyf = 0;
+        PDsizei m_Hmtx = 0;
+        PDsizei m_Kern = 0;
+        PDuint m_GlyphCount = 0;
+        PDuint m_HMetricCount = 0;
+        PDuint m_UnitsPerEm = 0;
+        PDint m_Ascent = 0;
+        PDint m_Descent = 0;
+        PDint m_LineGap = 0;
+        bool m_LongLoca = false;
+    };
+}
+
+#endif /* DEWPSI_TRUETYPE_H */
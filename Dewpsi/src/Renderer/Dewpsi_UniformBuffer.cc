@@ -0,0 +1,35 @@
+#include "Dewpsi_UniformBuffer.h"
+#include "Dewpsi_WhichOS.h"
+#include "Dewpsi_Except.h"
+#include "Dewpsi_Renderer.h"
+
+namespace Dewpsi {
+
+Ref<UniformBuffer> UniformBuffer::Create(PDsizei size, PDuint binding)
+{
+    #define _ERROR(msg) "UniformBuffer::Create: " msg
+
+    switch (Renderer::GetAPI())
+    {
+        case RendererAPI::API::None:
+            return CreateRef<NullUniformBuffer>(size, binding);
+            break;
+
+        case RendererAPI::API::OpenGL:
+            return CreateRef<OpenGLUniformBuffer>(size, binding);
+            break;
+
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareUniformBuffer>(size, binding);
+            break;
+
+        default: break;
+    }
+
+    throw DewpsiError(_ERROR("unrecognized API"));
+
+    return nullptr;
+    #undef _ERROR
+}
+
+}
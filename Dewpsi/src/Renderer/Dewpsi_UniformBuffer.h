@@ -0,0 +1,49 @@
+#ifndef DEWPSI_UNIFORMBUFFER_H
+#define DEWPSI_UNIFORMBUFFER_H
+
+/** @file Dewpsi_UniformBuffer.h
+*   @ref core_renderer
+*/
+
+#include <Dewpsi_Core.h>
+#include <Dewpsi_Memory.h>
+
+namespace Dewpsi {
+    /** Buffer of uniform data shared between shaders.
+    *   The buffer is attached to a fixed binding point; every shader that declares a
+    *   uniform block with the same binding reads from it, without any per-shader upload.
+    *   The data written must follow the std140 layout of the block.
+    *   @code{.cpp}
+        // layout(std140, binding = 0) uniform Camera { mat4 u_ViewProjection; };
+        auto ubo = Dewpsi::UniformBuffer::Create(sizeof(glm::mat4), 0);
+        ubo->SetData(&viewProjection, sizeof(glm::mat4));
+    *   @endcode
+    *   @ingroup core_renderer
+    */
+    class UniformBuffer {
+    public:
+        virtual ~UniformBuffer() {}
+
+        /// Attaches the buffer to its binding point.
+        virtual void Bind() const = 0;
+
+        /** Writes @a size bytes of @a data into the buffer.
+        *   @param data    The data to upload
+        *   @param size    The number of bytes to write
+        *   @param offset  The byte offset into the buffer to write to
+        */
+        virtual void SetData(const void* data, PDsizei size, PDsizei offset = 0) = 0;
+
+        /// Returns the binding point of the buffer.
+        virtual PDuint GetBinding() const = 0;
+
+        /** Creates a uniform buffer and attaches it to a binding point.
+        *   @param size     The size of the buffer in bytes
+        *   @param binding  The uniform block binding point
+        *   @return         A pointer to the API and platform-specific uniform buffer
+        */
+        static Ref<UniformBuffer> Create(PDsizei size, PDuint binding);
+    };
+}
+
+#endif /* DEWPSI_UNIFORMBUFFER_H */
@@ -13,13 +13,17 @@ Ref<VertexArray> VertexArray::Create()
     switch (Renderer::GetAPI())
     {
     case RendererAPI::API::None:
-        throw DewpsiError(_ERROR("Renderer API is set to none"));
+        return CreateRef<NullVertexArray>();
         break;
 
     case RendererAPI::API::OpenGL:
         return CreateRef<OpenGLVertexArray>();
         break;
 
+    case RendererAPI::API::Software:
+        return CreateRef<SoftwareVertexArray>();
+        break;
+
     default: break;
     }
 
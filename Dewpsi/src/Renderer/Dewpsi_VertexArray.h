@@ -37,6 +37,9 @@ namespace Dewpsi {
         /// Returns the registered index buffer.
         virtual const Ref<IndexBuffer>& GetIndexBuffer() const = 0;
 
+        /// Returns the API-specific ID of the vertex array.
+        virtual PDuint GetRendererID() const = 0;
+
         /** Creates a vertex array object.
         *   The vertex array is not bound by default. You can bind/unbind it
         *   with the Bind() and UnBind() functions, respectively.
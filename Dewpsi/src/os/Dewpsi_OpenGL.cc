@@ -1,5 +1,7 @@
 #include "Dewpsi_OpenGL.h"
+#include "Dewpsi_OpenGLStateCache.h"
 #include <DewpsiMath_Util.hpp>
+#include <cstring>
 
 static const char* _whatiserror(GLenum error)
 {
@@ -71,12 +73,64 @@ void GLPrintActiveUniforms(PDuint shader)
     }
 }
 
+#ifndef GL_VERSION_4_4
+PFNGLBUFFERSTORAGEPROC Dewpsi_glBufferStorage = nullptr;
+#endif
+
+#ifndef GL_KHR_parallel_shader_compile
+PFNGLMAXSHADERCOMPILERTHREADSKHRPROC Dewpsi_glMaxShaderCompilerThreadsKHR = nullptr;
+#endif
+
+bool GLHasExtension(const char* name)
+{
+    GLint iCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &iCount);
+    for (GLint i = 0; i < iCount; ++i)
+    {
+        const char* cpExtension = (const char*) glGetStringi(GL_EXTENSIONS, (GLuint) i);
+        if (cpExtension && std::strcmp(cpExtension, name) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+void GLLoadExtensions(GLADloadproc load)
+{
+#ifndef GL_VERSION_4_4
+    Dewpsi_glBufferStorage = (PFNGLBUFFERSTORAGEPROC) load("glBufferStorage");
+    if (! Dewpsi_glBufferStorage)
+        Dewpsi_glBufferStorage = (PFNGLBUFFERSTORAGEPROC) load("glBufferStorageARB");
+    if (! Dewpsi_glBufferStorage)
+        PD_CORE_WARN("glBufferStorage is not supported; stream buffers will not be persistently mapped");
+#endif
+
+#ifndef GL_KHR_parallel_shader_compile
+    if (GLHasExtension("GL_KHR_parallel_shader_compile"))
+        Dewpsi_glMaxShaderCompilerThreadsKHR = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)
+            load("glMaxShaderCompilerThreadsKHR");
+    else if (GLHasExtension("GL_ARB_parallel_shader_compile"))
+        Dewpsi_glMaxShaderCompilerThreadsKHR = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)
+            load("glMaxShaderCompilerThreadsARB");
+#endif
+
+    // Let the driver pick the number of compiler threads
+    if (glMaxShaderCompilerThreadsKHR)
+    {
+        glMaxShaderCompilerThreadsKHR(0xffffffff);
+        PD_CORE_TRACE("Parallel shader compilation is enabled");
+    }
+}
+
 #ifndef GL_VERSION_4_5
 #warning "[OPENGL] Using Dewpsi to implement glCreateTextures"
 void Dewpsi_glCreateTextures(GLenum target, GLsizei n, GLuint *textures)
 {
     glGenTextures(n, textures);
-    glBindTexture(target, *textures);
+    if (target == GL_TEXTURE_2D)
+        Dewpsi::OpenGLStateCache::BindTexture(*textures);
+    else
+        glBindTexture(target, *textures);
 }
 #endif
 
@@ -148,7 +202,7 @@ void Dewpsi_glTexStorage2D(GLenum target, GLsizei levels, GLenum internalformat,
 void Dewpsi_glTextureStorage2D(GLuint texture, GLsizei levels, GLenum internalformat,
     GLsizei width, GLsizei height)
 {
-    GLCall(glBindTexture(GL_TEXTURE_2D, texture));
+    GLCall(Dewpsi::OpenGLStateCache::BindTexture(texture));
     GLCall(glTexStorage2D(GL_TEXTURE_2D, levels, internalformat, width, height));
 }
 
@@ -157,8 +211,14 @@ void Dewpsi_glTextureSubImage2D(GLuint texture, GLsizei level, GLint xoffset,
     GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type,
     const void* pixels)
 {
-    GLCall(glBindTexture(GL_TEXTURE_2D, texture));
+    GLCall(Dewpsi::OpenGLStateCache::BindTexture(texture));
     GLCall(glTexSubImage2D(GL_TEXTURE_2D, level, xoffset, yoffset, width, height, format, type, pixels));
 }
 
+void Dewpsi_glGenerateTextureMipmap(GLuint texture)
+{
+    GLCall(Dewpsi::OpenGLStateCache::BindTexture(texture));
+    GLCall(glGenerateMipmap(GL_TEXTURE_2D));
+}
+
 #endif // GL_VERSION_4_5
@@ -24,6 +24,17 @@ bool GLGetProgramError(char** dst, PDuint shader);
 
 void GLPrintActiveUniforms(PDuint shader);
 
+/*
+Load the entry points that the GLAD loader does not provide. This is called once the context is
+created and GLAD is loaded. Entry points the driver does not support are left NULL.
+*/
+PD_CALL void GLLoadExtensions(GLADloadproc load);
+
+/*
+Returns true if the context supports the extension @a name. Only valid after GLLoadExtensions().
+*/
+PD_CALL bool GLHasExtension(const char* name);
+
 // Alias for glGenBuffers
 #ifndef glCreateBuffers
     #define glCreateBuffers(cnt, p) glGenBuffers(cnt, p)
@@ -41,6 +52,35 @@ a macro pointing to it.
         Dewpsi_glTexStorage2D(target, levels, intfmt, width, height)
 #endif
 
+#ifndef GL_VERSION_4_4
+    /*
+    glBufferStorage is core in OpenGL 4.4 (and ARB_buffer_storage). GLAD is generated for 4.3, so
+    the function is loaded by GLLoadExtensions() and is NULL if the driver does not support it.
+    Callers must check for that and fall back to glBufferData.
+    */
+    #define GL_MAP_PERSISTENT_BIT   0x0040
+    #define GL_MAP_COHERENT_BIT     0x0080
+    #define GL_DYNAMIC_STORAGE_BIT  0x0100
+    #define GL_CLIENT_STORAGE_BIT   0x0200
+    typedef void (APIENTRYP PFNGLBUFFERSTORAGEPROC)(GLenum target, GLsizeiptr size,
+        const void* data, GLbitfield flags);
+    PD_CALL PFNGLBUFFERSTORAGEPROC Dewpsi_glBufferStorage;
+    #define glBufferStorage Dewpsi_glBufferStorage
+#endif
+
+#ifndef GL_KHR_parallel_shader_compile
+    /*
+    KHR_parallel_shader_compile (or ARB_parallel_shader_compile) lets the driver compile and link
+    on its own threads, and adds a non-blocking completion query. glMaxShaderCompilerThreadsKHR is
+    loaded by GLLoadExtensions() and is NULL if neither extension is supported.
+    */
+    #define GL_MAX_SHADER_COMPILER_THREADS_KHR  0x91B0
+    #define GL_COMPLETION_STATUS_KHR            0x91B1
+    typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+    PD_CALL PFNGLMAXSHADERCOMPILERTHREADSKHRPROC Dewpsi_glMaxShaderCompilerThreadsKHR;
+    #define glMaxShaderCompilerThreadsKHR Dewpsi_glMaxShaderCompilerThreadsKHR
+#endif
+
 #ifndef GL_VERSION_4_5
     /*
     Expose glCreateTextures to the client. In OpenGL 4.5, it's automatically exposed by the GLAD
@@ -66,6 +106,11 @@ a macro pointing to it.
         const void* pixels);
     #define glTextureSubImage2D(texture, level, x, y, w, h, format, type, pixels) \
         Dewpsi_glTextureSubImage2D(texture, level, x, y, w, h, format, type, pixels)
+    /*
+    Implement glGenerateTextureMipmap with glGenerateMipmap on the bound texture.
+    */
+    PD_CALL void Dewpsi_glGenerateTextureMipmap(GLuint texture);
+    #define glGenerateTextureMipmap(texture) Dewpsi_glGenerateTextureMipmap(texture)
 #endif // !defined(GL_VERSION_4_5)
 
 #endif /* DEWPSI_OPENGL_H */
@@ -10,11 +10,32 @@
     #include <Dewpsi_OpenGLContext.h>
     #include <Dewpsi_OpenGLBuffer.h>
     #include <Dewpsi_OpenGLTexture.h>
+    #include <Dewpsi_OpenGLTextureLoader.h>
+    #include <Dewpsi_OpenGLFrameCapture.h>
     #include <Dewpsi_OpenGLVertexArray.h>
     #include <Dewpsi_OpenGLShader.h>
     #include <Dewpsi_OpenGLRendererAPI.h>
+    #include <Dewpsi_OpenGLUniformBuffer.h>
 #else
     #error Currently only Linux is supported
 #endif
 
+// The null API is available everywhere
+#include <Dewpsi_NullContext.h>
+#include <Dewpsi_NullBuffer.h>
+#include <Dewpsi_NullTexture.h>
+#include <Dewpsi_NullVertexArray.h>
+#include <Dewpsi_NullShader.h>
+#include <Dewpsi_NullRendererAPI.h>
+#include <Dewpsi_NullUniformBuffer.h>
+
+// So is the software API
+#include <Dewpsi_SoftwareContext.h>
+#include <Dewpsi_SoftwareBuffer.h>
+#include <Dewpsi_SoftwareTexture.h>
+#include <Dewpsi_SoftwareVertexArray.h>
+#include <Dewpsi_SoftwareShader.h>
+#include <Dewpsi_SoftwareRendererAPI.h>
+#include <Dewpsi_SoftwareUniformBuffer.h>
+
 #endif /* DEWPSI_WHICHOS_H */
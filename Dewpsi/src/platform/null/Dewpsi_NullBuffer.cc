@@ -0,0 +1,84 @@
+#include "Dewpsi_NullBuffer.h"
+#include "Dewpsi_NullRendererAPI.h"
+#include "Dewpsi_Log.h"
+#include <cstring>
+
+namespace Dewpsi {
+
+// ==============================================
+// Vertex buffer
+// ==============================================
+
+NullVertexBuffer::NullVertexBuffer(PDsizei size) : m_Size(size)
+{
+}
+
+void NullVertexBuffer::Bind() const
+{
+    ++NullRendererAPI::GetFrameCounters().bufferBinds;
+}
+
+void NullVertexBuffer::SetData(const void* data, PDsizei size)
+{
+    PD_CORE_ASSERT(size <= m_Size, "Data is larger than the buffer");
+    NullRendererAPI::GetFrameCounters().bytesUploaded += size;
+}
+
+// ==============================================
+// Stream buffer
+// ==============================================
+
+NullStreamBuffer::NullStreamBuffer(PDsizei regionSize, PDuint regionCount)
+    : m_Storage(regionSize * regionCount), m_RegionSize(regionSize), m_RegionCount(regionCount),
+      m_Region(0), m_Cursor(0), m_MappedOffset(0)
+{
+    PD_CORE_ASSERT(regionSize && regionCount, "Stream buffer cannot be empty");
+}
+
+void NullStreamBuffer::Bind() const
+{
+    ++NullRendererAPI::GetFrameCounters().bufferBinds;
+}
+
+void NullStreamBuffer::SetData(const void* data, PDsizei size)
+{
+    void* dst = Map(size);
+    PD_CORE_ASSERT(dst, "Stream buffer region is full");
+    if (dst)
+        std::memcpy(dst, data, size);
+}
+
+void* NullStreamBuffer::Map(PDsizei size, PDsizei alignment)
+{
+    PDsizei szCursor = m_Cursor;
+    if (alignment > 1)
+        szCursor = (szCursor + alignment - 1) / alignment * alignment;
+    if (szCursor + size > m_RegionSize)
+        return nullptr;
+
+    m_MappedOffset = m_Region * m_RegionSize + szCursor;
+    m_Cursor = szCursor + size;
+    NullRendererAPI::GetFrameCounters().bytesUploaded += size;
+    return m_Storage.data() + m_MappedOffset;
+}
+
+void NullStreamBuffer::NextFrame()
+{
+    m_Region = (m_Region + 1) % m_RegionCount;
+    m_Cursor = 0;
+}
+
+// ==============================================
+// Index buffer
+// ==============================================
+
+NullIndexBuffer::NullIndexBuffer(PDsizei count, IndexType type) : m_Count((PDuint32) count), m_Type(type)
+{
+}
+
+void NullIndexBuffer::Bind() const
+{
+    ++NullRendererAPI::GetFrameCounters().bufferBinds;
+}
+
+}
@@ -0,0 +1,88 @@
+#ifndef DEWPSI_NULLBUFFER_H
+#define DEWPSI_NULLBUFFER_H
+
+#include <Dewpsi_Buffer.h>
+#include <vector>
+
+namespace Dewpsi {
+    class NullVertexBuffer : public VertexBuffer {
+    public:
+        explicit NullVertexBuffer(PDsizei size);
+        virtual ~NullVertexBuffer() = default;
+
+        virtual void Bind() const override;
+        virtual void UnBind() const override {}
+        virtual void SetData(const void* data, PDsizei size) override;
+
+        virtual const BufferLayout& GetLayout() const override
+        {
+            return m_Layout;
+        }
+        virtual void SetLayout(const BufferLayout& layout) override
+        {
+            m_Layout = layout;
+        }
+
+        PDsizei GetSize() const {return m_Size;}
+
+    private:
+        PDsizei m_Size;
+        BufferLayout m_Layout;
+    };
+
+    /*
+    Stream buffer of the null API. Writers still need memory to write into, so the regions are
+    backed by system memory; nothing ever reads it.
+    */
+    class NullStreamBuffer : public StreamBuffer {
+    public:
+        NullStreamBuffer(PDsizei regionSize, PDuint regionCount);
+        virtual ~NullStreamBuffer() = default;
+
+        virtual void Bind() const override;
+        virtual void UnBind() const override {}
+        virtual void SetData(const void* data, PDsizei size) override;
+
+        virtual const BufferLayout& GetLayout() const override
+        {
+            return m_Layout;
+        }
+        virtual void SetLayout(const BufferLayout& layout) override
+        {
+            m_Layout = layout;
+        }
+
+        virtual void* Map(PDsizei size, PDsizei alignment = 1) override;
+        virtual void Unmap() override {}
+        virtual PDsizei GetMappedOffset() const override {return m_MappedOffset;}
+        virtual void NextFrame() override;
+        virtual PDsizei GetRegionSize() const override {return m_RegionSize;}
+        virtual PDuint GetRegionCount() const override {return m_RegionCount;}
+
+    private:
+        std::vector<PDuchar> m_Storage;
+        PDsizei m_RegionSize;
+        PDuint m_RegionCount;
+        PDuint m_Region;
+        PDsizei m_Cursor;
+        PDsizei m_MappedOffset;
+        BufferLayout m_Layout;
+    };
+
+    class NullIndexBuffer : public IndexBuffer {
+    public:
+        NullIndexBuffer(PDsizei count, IndexType type);
+        virtual ~NullIndexBuffer() = default;
+
+        virtual void Bind() const override;
+        virtual void UnBind() const override {}
+        virtual PDuint32 GetCount() const override {return m_Count;}
+        virtual IndexType GetIndexType() const override {return m_Type;}
+
+    private:
+        PDuint32 m_Count;
+        IndexType m_Type;
+    };
+}
+
+#endif /* DEWPSI_NULLBUFFER_H */
@@ -0,0 +1,21 @@
+#ifndef DEWPSI_NULLCONTEXT_H
+#define DEWPSI_NULLCONTEXT_H
+
+#include <Dewpsi_Core.h>
+#include <Dewpsi_RenderContext.h>
+
+namespace Dewpsi {
+    /// Context of the null API; there is nothing to present.
+    class NullContext : public RenderContext {
+    public:
+        NullContext() = default;
+        virtual ~NullContext() = default;
+
+        virtual int Init() override {return PD_OKAY;}
+        virtual void SwapBuffers() override {}
+        virtual void MakeCurrent() override {}
+        virtual void ReleaseCurrent() override {}
+    };
+}
+
+#endif /* DEWPSI_NULLCONTEXT_H */
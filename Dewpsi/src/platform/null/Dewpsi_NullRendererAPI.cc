@@ -0,0 +1,97 @@
+#include "Dewpsi_NullRendererAPI.h"
+#include "Dewpsi_Log.h"
+
+namespace Dewpsi {
+
+static NullRendererAPI::Statistics _Current = {};
+static NullRendererAPI::Statistics _Last = {};
+static NullRendererAPI::Statistics _Total = {};
+
+void NullRendererAPI::Init()
+{
+    _Current = _Last = _Total = {};
+    PD_CORE_TRACE("Initialized NullRendererAPI");
+}
+
+void NullRendererAPI::Shutdown()
+{
+}
+
+void NullRendererAPI::BeginFrame()
+{
+    _Total.drawCalls += _Current.drawCalls;
+    _Total.instances += _Current.instances;
+    _Total.vertices += _Current.vertices;
+    _Total.shaderBinds += _Current.shaderBinds;
+    _Total.vertexArrayBinds += _Current.vertexArrayBinds;
+    _Total.bufferBinds += _Current.bufferBinds;
+    _Total.textureBinds += _Current.textureBinds;
+    _Total.bytesUploaded += _Current.bytesUploaded;
+
+    _Last = _Current;
+    _Current = {};
+}
+
+void NullRendererAPI::SetClearColor(const Color& color)
+{
+    m_ClearColor = color;
+}
+
+void NullRendererAPI::Clear()
+{
+}
+
+void NullRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, PDuint32 indexCount)
+{
+    PDuint32 uiCount = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+    ++_Current.drawCalls;
+    ++_Current.instances;
+    _Current.vertices += uiCount;
+}
+
+void NullRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, PDuint32 instanceCount,
+    PDuint32 indexCount, PDuint32 baseInstance)
+{
+    PDuint32 uiCount = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+    ++_Current.drawCalls;
+    _Current.instances += instanceCount;
+    _Current.vertices += (PDuint64) uiCount * instanceCount;
+}
+
+void NullRendererAPI::DrawArrays(const Ref<VertexArray>& vertexArray, PDuint32 vertexCount, PrimitiveType type)
+{
+    ++_Current.drawCalls;
+    ++_Current.instances;
+    _Current.vertices += vertexCount;
+}
+
+void NullRendererAPI::BeginPass(const char* name)
+{
+}
+
+void NullRendererAPI::EndPass()
+{
+}
+
+void NullRendererAPI::GetFrameStats(RendererAPI::Statistics& stats)
+{
+    // Every bind is counted as issued; nothing is cached
+    stats.stateChanges += _Last.shaderBinds + _Last.vertexArrayBinds + _Last.bufferBinds + _Last.textureBinds;
+}
+
+NullRendererAPI::Statistics& NullRendererAPI::GetFrameCounters()
+{
+    return _Current;
+}
+
+const NullRendererAPI::Statistics& NullRendererAPI::GetStats()
+{
+    return _Last;
+}
+
+const NullRendererAPI::Statistics& NullRendererAPI::GetTotalStats()
+{
+    return _Total;
+}
+
+}
@@ -0,0 +1,50 @@
+#ifndef DEWPSI_NULLRENDERERAPI_H
+#define DEWPSI_NULLRENDERERAPI_H
+
+#include <Dewpsi_RendererAPI.h>
+
+namespace Dewpsi {
+    /*
+    Rendering API that draws nothing. The null objects keep only the metadata of what is created
+    (sizes, layouts, counts) and every draw, bind and upload is counted instead of executed, so the
+    application loop and the renderer front end can be run and timed without a GPU.
+    */
+    class NullRendererAPI : public RendererAPI {
+    public:
+        /// Counters of one frame, or of the whole run.
+        struct Statistics {
+            PDuint32 drawCalls;         ///< Number of draws
+            PDuint32 instances;         ///< Number of instances drawn
+            PDuint64 vertices;          ///< Number of vertices processed, over all instances
+            PDuint32 shaderBinds;       ///< Shader binds
+            PDuint32 vertexArrayBinds;  ///< Vertex array binds
+            PDuint32 bufferBinds;       ///< Vertex, index, stream and uniform buffer binds
+            PDuint32 textureBinds;      ///< Texture binds
+            PDuint64 bytesUploaded;     ///< Bytes passed to SetData() and SetSubData()
+        };
+
+        virtual void Init() override;
+        virtual void Shutdown() override;
+        virtual void BeginFrame() override;
+        virtual void SetClearColor(const Color& color) override;
+        virtual void Clear() override;
+        virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, PDuint32 indexCount) override;
+        virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, PDuint32 instanceCount,
+            PDuint32 indexCount, PDuint32 baseInstance) override;
+        virtual void DrawArrays(const Ref<VertexArray>& vertexArray, PDuint32 vertexCount, PrimitiveType type) override;
+        virtual void BeginPass(const char* name) override;
+        virtual void EndPass() override;
+        virtual void GetFrameStats(RendererAPI::Statistics& stats) override;
+
+        /// Returns the counters of the frame in progress; the null objects add to these.
+        static Statistics& GetFrameCounters();
+
+        /// Returns the counters of the previous frame.
+        static const Statistics& GetStats();
+
+        /// Returns the counters since Init(), up to the previous frame.
+        static const Statistics& GetTotalStats();
+    };
+}
+
+#endif /* DEWPSI_NULLRENDERERAPI_H */
@@ -0,0 +1,19 @@
+#include "Dewpsi_NullShader.h"
+#include "Dewpsi_NullRendererAPI.h"
+
+namespace Dewpsi {
+
+// IDs only need to be distinct, for sort keys
+static PDuint32 _NextID = 1;
+
+NullShader::NullShader() : m_ShaderID(_NextID++)
+{
+}
+
+bool NullShader::Bind() const
+{
+    ++NullRendererAPI::GetFrameCounters().shaderBinds;
+    return true;
+}
+
+}
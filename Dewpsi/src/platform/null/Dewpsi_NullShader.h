@@ -0,0 +1,63 @@
+#ifndef DEWPSI_NULLSHADER_H
+#define DEWPSI_NULLSHADER_H
+
+#include "Dewpsi_Core.h"
+#include "Dewpsi_Shader.h"
+
+namespace Dewpsi {
+    /*
+    Shader of the null API. The sources are never compiled, so every shader is ready right away
+    and uniforms are accepted and dropped.
+    */
+    class NullShader : public Shader {
+    public:
+        NullShader();
+        virtual ~NullShader() = default;
+
+        virtual bool Bind() const override;
+        virtual void UnBind() const override {}
+        virtual bool IsReady() const override {return true;}
+        virtual PDuint GetRendererID() const override {return m_ShaderID;}
+
+        virtual void SetInt1(const PDstring&, PDint) override {}
+        virtual void SetInt2(const PDstring&, PDint, PDint) override {}
+        virtual void SetInt3(const PDstring&, PDint, PDint, PDint) override {}
+        virtual void SetInt4(const PDstring&, PDint, PDint, PDint, PDint) override {}
+        virtual void SetIntArray(const PDstring&, const PDint*, PDsizei) override {}
+
+        virtual void SetUInt1(const PDstring&, PDuint) override {}
+        virtual void SetUInt2(const PDstring&, PDuint, PDuint) override {}
+        virtual void SetUInt3(const PDstring&, PDuint, PDuint, PDuint) override {}
+        virtual void SetUInt4(const PDstring&, PDuint, PDuint, PDuint, PDuint) override {}
+
+        virtual void SetFloat1(const PDstring&, PDfloat) override {}
+        virtual void SetFloat2(const PDstring&, PDfloat, PDfloat) override {}
+        virtual void SetFloat3(const PDstring&, PDfloat, PDfloat, PDfloat) override {}
+        virtual void SetFloat4(const PDstring&, PDfloat, PDfloat, PDfloat, PDfloat) override {}
+
+        virtual void SetMat4(const PDstring&, PDsizei, const glm::mat4*, bool = false) override {}
+
+        virtual void SetInt1(UniformId, PDint) override {}
+        virtual void SetInt2(UniformId, PDint, PDint) override {}
+        virtual void SetInt3(UniformId, PDint, PDint, PDint) override {}
+        virtual void SetInt4(UniformId, PDint, PDint, PDint, PDint) override {}
+        virtual void SetIntArray(UniformId, const PDint*, PDsizei) override {}
+
+        virtual void SetUInt1(UniformId, PDuint) override {}
+        virtual void SetUInt2(UniformId, PDuint, PDuint) override {}
+        virtual void SetUInt3(UniformId, PDuint, PDuint, PDuint) override {}
+        virtual void SetUInt4(UniformId, PDuint, PDuint, PDuint, PDuint) override {}
+
+        virtual void SetFloat1(UniformId, PDfloat) override {}
+        virtual void SetFloat2(UniformId, PDfloat, PDfloat) override {}
+        virtual void SetFloat3(UniformId, PDfloat, PDfloat, PDfloat) override {}
+        virtual void SetFloat4(UniformId, PDfloat, PDfloat, PDfloat, PDfloat) override {}
+
+        virtual void SetMat4(UniformId, PDsizei, const glm::mat4*, bool = false) override {}
+
+    private:
+        PDuint32 m_ShaderID;
+    };
+}
+
+#endif /* DEWPSI_NULLSHADER_H */
@@ -0,0 +1,64 @@
+#include "Dewpsi_NullTexture.h"
+#include "Dewpsi_NullRendererAPI.h"
+#include "Dewpsi_Log.h"
+
+#define RESET_ERROR() m_IsError = false;
+
+namespace Dewpsi {
+
+// IDs only need to be distinct, for sort keys
+static PDuint32 _NextID = 1;
+
+NullTexture2D::NullTexture2D(const PDstring& file, const TextureProperties& props)
+    : m_TextureID(_NextID++), m_Width(0), m_Height(0), m_Levels(1), m_Properties(props)
+{
+    RESET_ERROR();
+
+    int iWidth, iHeight, iChannels;
+    if (! stbi_info(file.c_str(), &iWidth, &iHeight, &iChannels))
+    {
+        SetError("Failed to read %s", file.c_str());
+        m_IsError = true;
+        return;
+    }
+
+    m_Width = (PDuint) iWidth;
+    m_Height = (PDuint) iHeight;
+    if (m_Properties.mipmaps != MipmapFilter::None)
+        m_Levels = Mipmap::GetLevelCount(m_Width, m_Height);
+}
+
+NullTexture2D::NullTexture2D(PDuint width, PDuint height, const TextureProperties& props)
+    : m_TextureID(_NextID++), m_Width(width), m_Height(height), m_Levels(1), m_Properties(props)
+{
+    RESET_ERROR();
+    if (m_Properties.mipmaps != MipmapFilter::None)
+        m_Levels = Mipmap::GetLevelCount(m_Width, m_Height);
+}
+
+void NullTexture2D::Bind(PDuint slot) const
+{
+    ++NullRendererAPI::GetFrameCounters().textureBinds;
+}
+
+void NullTexture2D::SetData(const void* data, PDsizei size)
+{
+    PD_CORE_ASSERT(size == m_Width * m_Height * 4, "Data must cover the entire texture");
+    NullRendererAPI::GetFrameCounters().bytesUploaded += size;
+}
+
+void NullTexture2D::SetSubData(const void* data, PDuint x, PDuint y, PDuint width, PDuint height)
+{
+    PD_CORE_ASSERT(x + width <= m_Width && y + height <= m_Height, "Rectangle is outside the texture");
+    NullRendererAPI::GetFrameCounters().bytesUploaded += (PDuint64) width * height * 4;
+}
+
+PDsizei NullTexture2D::GetMemorySize() const
+{
+    PDsizei szTotal = 0;
+    for (PDuint i = 0; i < m_Levels; ++i)
+        szTotal += (PDsizei) Mipmap::GetLevelSize(m_Width, i) * Mipmap::GetLevelSize(m_Height, i) * 4;
+    return szTotal;
+}
+
+}
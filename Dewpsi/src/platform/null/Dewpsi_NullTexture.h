@@ -0,0 +1,42 @@
+#ifndef DEWPSI_NULLTEXTURE_H
+#define DEWPSI_NULLTEXTURE_H
+
+#include "Dewpsi_Core.h"
+#include "Dewpsi_Texture.h"
+
+namespace Dewpsi {
+    /*
+    Texture of the null API. Files are only probed for their size, not decoded, so asynchronous
+    loads are complete right away.
+    */
+    class NullTexture2D : public Texture2D {
+    public:
+        NullTexture2D() = delete;
+        explicit NullTexture2D(const PDstring& file, const TextureProperties& props = {});
+        NullTexture2D(PDuint width, PDuint height, const TextureProperties& props = {});
+        virtual ~NullTexture2D() = default;
+
+        virtual void Bind(PDuint slot) const override;
+        virtual void UnBind() const override {}
+        virtual PDuint GetWidth() const override {return m_Width;}
+        virtual PDuint GetHeight() const override {return m_Height;}
+        virtual const PDuchar* GetData() const override {return nullptr;}
+        virtual void SetData(const void* data, PDsizei size) override;
+        virtual void SetSubData(const void* data, PDuint x, PDuint y, PDuint width, PDuint height) override;
+        virtual void GenerateMipmaps() override {}
+        virtual PDuint GetMipLevelCount() const override {return m_Levels;}
+        virtual const TextureProperties& GetProperties() const override {return m_Properties;}
+        virtual PDsizei GetMemorySize() const override;
+        virtual PDuint GetRendererID() const override {return m_TextureID;}
+        virtual bool IsLoaded() const override {return true;}
+
+    private:
+        PDuint32 m_TextureID;
+        PDuint m_Width;
+        PDuint m_Height;
+        PDuint m_Levels;
+        TextureProperties m_Properties;
+    };
+}
+
+#endif /* DEWPSI_NULLTEXTURE_H */
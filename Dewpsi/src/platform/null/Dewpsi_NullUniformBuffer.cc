@@ -0,0 +1,23 @@
+#include "Dewpsi_NullUniformBuffer.h"
+#include "Dewpsi_NullRendererAPI.h"
+#include "Dewpsi_Log.h"
+
+namespace Dewpsi {
+
+NullUniformBuffer::NullUniformBuffer(PDsizei size, PDuint binding)
+    : m_Binding(binding), m_Size(size)
+{
+}
+
+void NullUniformBuffer::Bind() const
+{
+    ++NullRendererAPI::GetFrameCounters().bufferBinds;
+}
+
+void NullUniformBuffer::SetData(const void* data, PDsizei size, PDsizei offset)
+{
+    PD_CORE_ASSERT(offset + size <= m_Size, "Write goes past the end of the uniform buffer");
+    NullRendererAPI::GetFrameCounters().bytesUploaded += size;
+}
+
+}
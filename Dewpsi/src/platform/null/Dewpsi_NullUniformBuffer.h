@@ -0,0 +1,22 @@
+#ifndef DEWPSI_NULLUNIFORMBUFFER_H
+#define DEWPSI_NULLUNIFORMBUFFER_H
+
+#include <Dewpsi_UniformBuffer.h>
+
+namespace Dewpsi {
+    class NullUniformBuffer : public UniformBuffer {
+    public:
+        NullUniformBuffer(PDsizei size, PDuint binding);
+        virtual ~NullUniformBuffer() = default;
+
+        virtual void Bind() const override;
+        virtual void SetData(const void* data, PDsizei size, PDsizei offset = 0) override;
+        virtual PDuint GetBinding() const override {return m_Binding;}
+
+    private:
+        PDuint m_Binding;
+        PDsizei m_Size;
+    };
+}
+
+#endif /* DEWPSI_NULLUNIFORMBUFFER_H */
@@ -0,0 +1,30 @@
+#include "Dewpsi_NullVertexArray.h"
+#include "Dewpsi_NullRendererAPI.h"
+#include "Dewpsi_Log.h"
+
+namespace Dewpsi {
+
+// IDs only need to be distinct, for sort keys
+static PDuint32 _NextID = 1;
+
+NullVertexArray::NullVertexArray() : m_ArrayID(_NextID++)
+{
+}
+
+void NullVertexArray::Bind() const
+{
+    ++NullRendererAPI::GetFrameCounters().vertexArrayBinds;
+}
+
+void NullVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
+{
+    PD_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "No layout defined");
+    m_VertexBuffers.push_back(vertexBuffer);
+}
+
+void NullVertexArray::SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer)
+{
+    m_IndexBuffer = indexBuffer;
+}
+
+}
@@ -0,0 +1,36 @@
+#ifndef DEWPSI_NULLVERTEXARRAY_H
+#define DEWPSI_NULLVERTEXARRAY_H
+
+#include <Dewpsi_VertexArray.h>
+
+namespace Dewpsi {
+    class NullVertexArray : public VertexArray {
+    public:
+        NullVertexArray();
+        virtual ~NullVertexArray() = default;
+
+        virtual void Bind() const override;
+        virtual void UnBind() const override {}
+        virtual void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) override;
+        virtual void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) override;
+        virtual const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const override
+        {
+            return m_VertexBuffers;
+        }
+        virtual const Ref<IndexBuffer>& GetIndexBuffer() const override
+        {
+            return m_IndexBuffer;
+        }
+        virtual PDuint GetRendererID() const override
+        {
+            return m_ArrayID;
+        }
+
+    private:
+        PDuint32 m_ArrayID;
+        std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+        Ref<IndexBuffer> m_IndexBuffer;
+    };
+}
+
+#endif /* DEWPSI_NULLVERTEXARRAY_H */
@@ -1,4 +1,6 @@
 #include "Dewpsi_OpenGLBuffer.h"
+#include "Dewpsi_OpenGLStateCache.h"
+#include <cstring>
 
 namespace Dewpsi {
 
@@ -8,51 +10,214 @@ namespace Dewpsi {
 
 OpenGLVertexBuffer::OpenGLVertexBuffer(PDsizei size, const PDfloat* data)
 {
+    PD_GL_THREAD_ASSERT();
     glCreateBuffers(1, &m_BufferID);
-    glBindBuffer(GL_ARRAY_BUFFER, m_BufferID);
+    OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_BufferID);
     glBufferData(GL_ARRAY_BUFFER, sizeof(PDfloat) * size, data, GL_STATIC_DRAW);
 }
 
+OpenGLVertexBuffer::OpenGLVertexBuffer(PDsizei size)
+{
+    PD_GL_THREAD_ASSERT();
+    glCreateBuffers(1, &m_BufferID);
+    OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_BufferID);
+    glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+}
+
 OpenGLVertexBuffer::~OpenGLVertexBuffer()
 {
+    PD_GL_THREAD_ASSERT();
+    OpenGLStateCache::ForgetBuffer(m_BufferID);
     glDeleteBuffers(1, &m_BufferID);
 }
 
 void OpenGLVertexBuffer::Bind() const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, m_BufferID);
+    OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_BufferID);
 }
 
 void OpenGLVertexBuffer::UnBind() const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void OpenGLVertexBuffer::SetData(const void* data, PDsizei size)
+{
+    OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_BufferID);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Stream Buffer ///////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+OpenGLStreamBuffer::OpenGLStreamBuffer(PDsizei regionSize, PDuint regionCount, GLenum target)
+    : m_BufferID(0), m_Target(target), m_RegionSize(regionSize), m_RegionCount(regionCount),
+      m_Region(0), m_Cursor(0), m_MappedOffset(0), m_Persistent(nullptr), m_Mapped(false),
+      m_Fences(regionCount, nullptr)
+{
+    PD_GL_THREAD_ASSERT();
+    PD_CORE_ASSERT(regionSize && regionCount, "Stream buffer cannot be empty");
+    const GLsizeiptr szTotal = (GLsizeiptr) (regionSize * regionCount);
+
+    glCreateBuffers(1, &m_BufferID);
+    OpenGLStateCache::BindBuffer(GL_COPY_WRITE_BUFFER, m_BufferID);
+
+    if (glBufferStorage)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, szTotal, nullptr, flags);
+        m_Persistent = (PDuchar*) glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, szTotal, flags);
+        PD_CORE_ASSERT(m_Persistent, "Failed to persistently map a stream buffer");
+    }
+    else
+    {
+        glBufferData(GL_COPY_WRITE_BUFFER, szTotal, nullptr, GL_STREAM_DRAW);
+    }
+
+    OpenGLStateCache::BindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+OpenGLStreamBuffer::~OpenGLStreamBuffer()
+{
+    PD_GL_THREAD_ASSERT();
+    for (GLsync fence : m_Fences)
+    {
+        if (fence)
+            glDeleteSync(fence);
+    }
+
+    if (m_Persistent || m_Mapped)
+    {
+        OpenGLStateCache::BindBuffer(GL_COPY_WRITE_BUFFER, m_BufferID);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    }
+    OpenGLStateCache::ForgetBuffer(m_BufferID);
+    glDeleteBuffers(1, &m_BufferID);
+}
+
+void OpenGLStreamBuffer::Bind() const
+{
+    OpenGLStateCache::BindBuffer(m_Target, m_BufferID);
+}
+
+void OpenGLStreamBuffer::UnBind() const
+{
+    OpenGLStateCache::BindBuffer(m_Target, 0);
+}
+
+void OpenGLStreamBuffer::SetData(const void* data, PDsizei size)
+{
+    void* dst = Map(size);
+    PD_CORE_ASSERT(dst, "Stream buffer region is full");
+    if (dst)
+    {
+        std::memcpy(dst, data, size);
+        Unmap();
+    }
+}
+
+void* OpenGLStreamBuffer::Map(PDsizei size, PDsizei alignment)
+{
+    PD_CORE_ASSERT(! m_Mapped, "Stream buffer is already mapped");
+
+    PDsizei szCursor = m_Cursor;
+    if (alignment > 1)
+        szCursor = (szCursor + alignment - 1) / alignment * alignment;
+    if (szCursor + size > m_RegionSize)
+        return nullptr;
+
+    m_MappedOffset = m_Region * m_RegionSize + szCursor;
+    m_Cursor = szCursor + size;
+
+    if (m_Persistent)
+        return m_Persistent + m_MappedOffset;
+
+    // The fence of this region was waited on in NextFrame(), so no implicit sync is needed
+    OpenGLStateCache::BindBuffer(GL_COPY_WRITE_BUFFER, m_BufferID);
+    void* ptr = glMapBufferRange(GL_COPY_WRITE_BUFFER, m_MappedOffset, size,
+        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+    m_Mapped = (ptr != nullptr);
+    return ptr;
+}
+
+void OpenGLStreamBuffer::Unmap()
+{
+    if (m_Mapped)
+    {
+        OpenGLStateCache::BindBuffer(GL_COPY_WRITE_BUFFER, m_BufferID);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        OpenGLStateCache::BindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        m_Mapped = false;
+    }
+}
+
+void OpenGLStreamBuffer::NextFrame()
+{
+    PD_CORE_ASSERT(! m_Mapped, "Stream buffer is still mapped");
+
+    if (m_Fences[m_Region])
+        glDeleteSync(m_Fences[m_Region]);
+    m_Fences[m_Region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    m_Region = (m_Region + 1) % m_RegionCount;
+    m_Cursor = 0;
+    WaitForRegion(m_Region);
+}
+
+void OpenGLStreamBuffer::WaitForRegion(PDuint region)
+{
+    GLsync fence = m_Fences[region];
+    if (! fence)
+        return;
+
+    // Flush on the first wait so the fence is guaranteed to signal
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    for (;;)
+    {
+        GLenum result = glClientWaitSync(fence, flags, 1000000); // 1 ms
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+            break;
+        if (result == GL_WAIT_FAILED)
+        {
+            PD_CORE_ERROR("glClientWaitSync failed on a stream buffer fence");
+            break;
+        }
+        flags = 0;
+    }
+
+    glDeleteSync(fence);
+    m_Fences[region] = nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 // Index Buffer ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-OpenGLIndexBuffer::OpenGLIndexBuffer(PDsizei count, const PDuint32* data)
-    : m_Count(count)
+OpenGLIndexBuffer::OpenGLIndexBuffer(PDsizei count, const void* data, IndexType type)
+    : m_Count(count), m_Type(type)
 {
+    PD_GL_THREAD_ASSERT();
     glCreateBuffers(1, &m_BufferID);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_BufferID);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(PDuint32) * count, data, GL_STATIC_DRAW);
+    OpenGLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_BufferID);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, IndexTypeSize(type) * count, data, GL_STATIC_DRAW);
 }
 
 OpenGLIndexBuffer::~OpenGLIndexBuffer()
 {
+    PD_GL_THREAD_ASSERT();
+    OpenGLStateCache::ForgetBuffer(m_BufferID);
     glDeleteBuffers(1, &m_BufferID);
 }
 
 void OpenGLIndexBuffer::Bind() const
 {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_BufferID);
+    OpenGLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_BufferID);
 }
 
 void OpenGLIndexBuffer::UnBind() const
 {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    OpenGLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
 }
@@ -8,10 +8,12 @@ namespace Dewpsi {
     class OpenGLVertexBuffer : public VertexBuffer {
     public:
         OpenGLVertexBuffer(PDsizei size, const PDfloat* data);
+        explicit OpenGLVertexBuffer(PDsizei size);
         virtual ~OpenGLVertexBuffer();
 
         virtual void Bind() const override;
         virtual void UnBind() const override;
+        virtual void SetData(const void* data, PDsizei size) override;
 
         virtual const BufferLayout& GetLayout() const override
         {
@@ -27,9 +29,63 @@ namespace Dewpsi {
         BufferLayout m_Layout;
     };
 
+    /*
+    Ring of frame regions in one buffer object. With glBufferStorage the buffer is persistently
+    and coherently mapped at construction; otherwise each Map() maps its range unsynchronized,
+    which is safe because the region's fence has already been waited on.
+    The target is used for Bind(); the buffer is bound to GL_COPY_WRITE_BUFFER for anything else so
+    that creating or mapping a stream never disturbs the element buffer of the bound vertex array.
+    */
+    class OpenGLStreamBuffer : public StreamBuffer {
+    public:
+        OpenGLStreamBuffer(PDsizei regionSize, PDuint regionCount, GLenum target = GL_ARRAY_BUFFER);
+        virtual ~OpenGLStreamBuffer();
+
+        virtual void Bind() const override;
+        virtual void UnBind() const override;
+        virtual void SetData(const void* data, PDsizei size) override;
+
+        virtual const BufferLayout& GetLayout() const override
+        {
+            return m_Layout;
+        }
+        virtual void SetLayout(const BufferLayout& layout) override
+        {
+            m_Layout = layout;
+        }
+
+        virtual void* Map(PDsizei size, PDsizei alignment = 1) override;
+        virtual void Unmap() override;
+        virtual PDsizei GetMappedOffset() const override {return m_MappedOffset;}
+        virtual void NextFrame() override;
+        virtual PDsizei GetRegionSize() const override {return m_RegionSize;}
+        virtual PDuint GetRegionCount() const override {return m_RegionCount;}
+
+        /// Returns the buffer object.
+        GLuint GetBufferID() const {return m_BufferID;}
+
+        /// Returns true if the buffer is persistently mapped.
+        bool IsPersistent() const {return m_Persistent != nullptr;}
+
+    private:
+        void WaitForRegion(PDuint region);
+
+        GLuint m_BufferID;
+        GLenum m_Target;
+        PDsizei m_RegionSize;
+        PDuint m_RegionCount;
+        PDuint m_Region;
+        PDsizei m_Cursor;
+        PDsizei m_MappedOffset;
+        PDuchar* m_Persistent;
+        bool m_Mapped;
+        std::vector<GLsync> m_Fences;
+        BufferLayout m_Layout;
+    };
+
     class OpenGLIndexBuffer : public IndexBuffer {
     public:
-        OpenGLIndexBuffer(PDsizei count, const PDuint32* data);
+        OpenGLIndexBuffer(PDsizei count, const void* data, IndexType type);
         virtual ~OpenGLIndexBuffer();
 
         virtual void Bind() const override;
@@ -40,9 +96,15 @@ namespace Dewpsi {
             return m_Count;
         }
 
+        virtual IndexType GetIndexType() const override
+        {
+            return m_Type;
+        }
+
     private:
         PDuint32 m_BufferID;
         PDuint32 m_Count;
+        IndexType m_Type;
     };
 
     
@@ -1,4 +1,5 @@
 #include "Dewpsi_OpenGLContext.h"
+#include "Dewpsi_OpenGLFrameCapture.h"
 #include "Dewpsi_WhichOS.h"
 
 namespace Dewpsi {
@@ -33,6 +34,7 @@ int OpenGLContext::Init()
         Dewpsi::SetError("GLAD loader returned an error status");
         return PD_INVALID;
     }
+    GLLoadExtensions(SDL_GL_GetProcAddress);
     /*PD_CORE_INFO(
         "OpenGL context\n  vendor: {0}\n  renderer: {1}\n  version: {2}",
         glGetString(GL_VENDOR),
@@ -45,7 +47,23 @@ int OpenGLContext::Init()
 
 void OpenGLContext::SwapBuffers()
 {
+    // The back buffer is complete here, ImGui included
+    int iWidth, iHeight;
+    SDL_GL_GetDrawableSize(m_WindowHandle, &iWidth, &iHeight);
+    OpenGLFrameCapture::Update(iWidth, iHeight);
+
     SDL_GL_SwapWindow(m_WindowHandle);
 }
 
+void OpenGLContext::MakeCurrent()
+{
+    if (SDL_GL_MakeCurrent(m_WindowHandle, m_Context))
+        PD_CORE_ERROR("Failed to make the OpenGL context current: {0}", SDL_GetError());
+}
+
+void OpenGLContext::ReleaseCurrent()
+{
+    SDL_GL_MakeCurrent(m_WindowHandle, nullptr);
+}
+
 }
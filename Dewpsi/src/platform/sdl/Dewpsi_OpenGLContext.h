@@ -13,6 +13,8 @@ namespace Dewpsi {
 
         virtual int Init() override;
         virtual void SwapBuffers() override;
+        virtual void MakeCurrent() override;
+        virtual void ReleaseCurrent() override;
 
     private:
         SDL_Window* m_WindowHandle;
@@ -0,0 +1,135 @@
+#include "Dewpsi_OpenGLFrameCapture.h"
+#include "Dewpsi_OpenGLStateCache.h"
+#include "Dewpsi_FrameCapture.h"
+#include "Dewpsi_Log.h"
+#include <array>
+#include <cstring>
+
+namespace Dewpsi {
+
+// Number of reads that can be in flight; a read is usually mapped one or two frames later
+static constexpr PDuint _RingSize = 3;
+
+struct Readback {
+    GLuint buffer;
+    GLsizeiptr capacity;
+    GLsync fence;       // NULL if the buffer is free
+    GLsizei width;
+    GLsizei height;
+    std::vector<FrameCapture::Target> targets;
+};
+
+static std::array<Readback, _RingSize> _Ring = {};
+static PDuint _Oldest = 0; // oldest read in flight
+static PDuint _InFlight = 0;
+
+// Waits for the read in @a readback if @a wait is true; returns false if it is not finished
+static bool Finish(Readback& readback, bool wait)
+{
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    for (;;)
+    {
+        const GLenum result = glClientWaitSync(readback.fence, flags, wait ? 1000000 : 0); // 1 ms
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+            break;
+        if (result == GL_WAIT_FAILED)
+        {
+            PD_CORE_ERROR("glClientWaitSync failed on a frame capture fence");
+            break;
+        }
+        if (! wait)
+            return false;
+        flags = 0;
+    }
+    glDeleteSync(readback.fence);
+    readback.fence = nullptr;
+
+    const GLsizeiptr szSize = (GLsizeiptr) readback.width * readback.height * 4;
+    std::vector<PDuchar> pixels;
+
+    OpenGLStateCache::BindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+    const void* source = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, szSize, GL_MAP_READ_BIT);
+    if (source)
+    {
+        pixels.resize((PDsizei) szSize);
+        std::memcpy(pixels.data(), source, (PDsizei) szSize);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    OpenGLStateCache::BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    FrameCapture::Submit(PD_MOVE(readback.targets), (PDuint) readback.width, (PDuint) readback.height,
+        PD_MOVE(pixels));
+    readback.targets.clear();
+    return true;
+}
+
+// Hands over the finished reads, oldest first so frames are written in order
+static void Collect(bool wait)
+{
+    while (_InFlight)
+    {
+        if (! Finish(_Ring[_Oldest], wait))
+            break;
+        _Oldest = (_Oldest + 1) % _RingSize;
+        --_InFlight;
+    }
+}
+
+void OpenGLFrameCapture::Update(GLsizei width, GLsizei height)
+{
+    Collect(false);
+
+    std::vector<FrameCapture::Target> targets;
+    if (! FrameCapture::TakeTargets(targets))
+        return;
+
+    // Every buffer is in flight; the oldest read has to finish before its buffer is reused
+    if (_InFlight == _RingSize)
+    {
+        Finish(_Ring[_Oldest], true);
+        _Oldest = (_Oldest + 1) % _RingSize;
+        --_InFlight;
+    }
+
+    Readback& readback = _Ring[(_Oldest + _InFlight) % _RingSize];
+    const GLsizeiptr szSize = (GLsizeiptr) width * height * 4;
+    if (! readback.buffer)
+        glCreateBuffers(1, &readback.buffer);
+
+    OpenGLStateCache::BindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+    if (readback.capacity < szSize)
+    {
+        glBufferData(GL_PIXEL_PACK_BUFFER, szSize, nullptr, GL_STREAM_READ);
+        readback.capacity = szSize;
+    }
+
+    GLCall(glPixelStorei(GL_PACK_ALIGNMENT, 4));
+    GLCall(glReadBuffer(GL_BACK));
+    GLCall(glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+    OpenGLStateCache::BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    readback.width = width;
+    readback.height = height;
+    readback.targets = PD_MOVE(targets);
+    ++_InFlight;
+}
+
+void OpenGLFrameCapture::Shutdown()
+{
+    Collect(true);
+
+    for (Readback& readback : _Ring)
+    {
+        if (readback.buffer)
+        {
+            OpenGLStateCache::ForgetBuffer(readback.buffer);
+            glDeleteBuffers(1, &readback.buffer);
+        }
+        readback = Readback();
+    }
+    _Oldest = 0;
+    _InFlight = 0;
+}
+
+}
@@ -0,0 +1,26 @@
+#ifndef DEWPSI_OPENGLFRAMECAPTURE_H
+#define DEWPSI_OPENGLFRAMECAPTURE_H
+
+#include <Dewpsi_Core.h>
+#include <Dewpsi_OpenGL.h>
+
+namespace Dewpsi {
+    /*
+    Reads back the frames taken by FrameCapture. Each frame is read into the next buffer of a
+    small ring of pixel pack buffers and a fence is put behind the read. Buffers are mapped and
+    handed to FrameCapture in order, once their fence is signaled, which is usually a frame or two
+    later. A frame only waits for a read if every buffer of the ring is still in flight.
+
+    Everything happens on the thread that owns the GL context.
+    */
+    class OpenGLFrameCapture {
+    public:
+        /// Hands over finished reads and reads the back buffer if the frame is captured.
+        static void Update(GLsizei width, GLsizei height);
+
+        /// Waits for every read in flight, hands them over and frees the buffers.
+        static void Shutdown();
+    };
+}
+
+#endif /* DEWPSI_OPENGLFRAMECAPTURE_H */
@@ -0,0 +1,148 @@
+#include "Dewpsi_OpenGLPassTimer.h"
+#include "Dewpsi_OpenGL.h"
+#include "Dewpsi_Log.h"
+#include <cstring>
+
+namespace Dewpsi {
+
+// Number of frames whose queries can wait for results at the same time
+static constexpr PDuint _Sets = 3;
+
+struct TimedPass {
+    PDstring name;
+    std::vector<GLuint> queries[_Sets];
+    PDuint used[_Sets]; // queries issued in the frame of each set
+    float milliseconds; // most recent complete result
+    bool ran;           // the pass ran in the frame of that result
+};
+
+static std::vector<TimedPass> _Passes;
+static PDuint _Set = 0;     // set of the current frame
+static PDuint _Oldest = 0;  // oldest set waiting for results
+static PDuint _Pending = 0; // sets waiting for results, not counting the current frame
+static bool _Skip = false;  // every set is waiting, so the current frame is not timed
+static PDint _Active = -1;
+
+// Returns true if every query of @a set is available
+static bool IsAvailable(const TimedPass& pass, PDuint set)
+{
+    for (PDuint i = 0; i < pass.used[set]; ++i)
+    {
+        GLint iAvailable = GL_FALSE;
+        glGetQueryObjectiv(pass.queries[set][i], GL_QUERY_RESULT_AVAILABLE, &iAvailable);
+        if (! iAvailable)
+            return false;
+    }
+    return true;
+}
+
+// Returns the summed time of the queries of @a set, which must be available
+static float ReadSet(const TimedPass& pass, PDuint set)
+{
+    GLuint64 uiTotal = 0;
+    for (PDuint i = 0; i < pass.used[set]; ++i)
+    {
+        GLuint64 uiElapsed = 0;
+        glGetQueryObjectui64v(pass.queries[set][i], GL_QUERY_RESULT, &uiElapsed);
+        uiTotal += uiElapsed;
+    }
+    return (float) ((double) uiTotal / 1000000.0);
+}
+
+void OpenGLPassTimer::BeginPass(const char* name)
+{
+    PD_CORE_ASSERT(_Active < 0, "Render passes cannot be nested");
+    if (_Active >= 0 || _Skip)
+        return;
+
+    PDsizei szIndex = 0;
+    while (szIndex < _Passes.size() && std::strcmp(_Passes[szIndex].name.c_str(), name))
+        ++szIndex;
+    if (szIndex == _Passes.size())
+        _Passes.push_back({name, {}, {}, 0.0f, false});
+
+    TimedPass& pass = _Passes[szIndex];
+    std::vector<GLuint>& queries = pass.queries[_Set];
+    if (pass.used[_Set] == queries.size())
+    {
+        GLuint uQuery;
+        glGenQueries(1, &uQuery);
+        queries.push_back(uQuery);
+    }
+
+    GLCall(glBeginQuery(GL_TIME_ELAPSED, queries[pass.used[_Set]++]));
+    _Active = (PDint) szIndex;
+}
+
+void OpenGLPassTimer::EndPass()
+{
+    if (_Active < 0)
+        return;
+
+    GLCall(glEndQuery(GL_TIME_ELAPSED));
+    _Active = -1;
+}
+
+void OpenGLPassTimer::NextFrame()
+{
+    PD_CORE_ASSERT(_Active < 0, "Render pass still running at the end of the frame");
+    EndPass();
+
+    if (! _Skip)
+        ++_Pending;
+
+    // Sets are read oldest first, and one keeps its queries until all of its results are available
+    while (_Pending)
+    {
+        bool bAvailable = true;
+        for (PDsizei i = 0; bAvailable && i < _Passes.size(); ++i)
+            bAvailable = IsAvailable(_Passes[i], _Oldest);
+        if (! bAvailable)
+            break;
+
+        for (TimedPass& pass : _Passes)
+        {
+            pass.ran = pass.used[_Oldest] != 0;
+            if (pass.ran)
+                pass.milliseconds = ReadSet(pass, _Oldest);
+            pass.used[_Oldest] = 0;
+        }
+        _Oldest = (_Oldest + 1) % _Sets;
+        --_Pending;
+    }
+
+    // With no free set the frame goes untimed rather than overwrite queries still in flight
+    _Skip = _Pending == _Sets;
+    _Set = (_Oldest + _Pending) % _Sets;
+}
+
+void OpenGLPassTimer::GetTimings(RendererAPI::Statistics& stats)
+{
+    for (const TimedPass& pass : _Passes)
+    {
+        if (! pass.ran)
+            continue;
+        stats.passes.push_back({pass.name, pass.milliseconds});
+        stats.gpuMilliseconds += pass.milliseconds;
+    }
+}
+
+void OpenGLPassTimer::Shutdown()
+{
+    EndPass();
+    for (TimedPass& pass : _Passes)
+    {
+        for (std::vector<GLuint>& queries : pass.queries)
+        {
+            if (! queries.empty())
+                glDeleteQueries((GLsizei) queries.size(), queries.data());
+        }
+    }
+    _Passes.clear();
+    _Set = 0;
+    _Oldest = 0;
+    _Pending = 0;
+    _Skip = false;
+}
+
+}
@@ -0,0 +1,30 @@
+#ifndef DEWPSI_OPENGLPASSTIMER_H
+#define DEWPSI_OPENGLPASSTIMER_H
+
+#include <Dewpsi_Core.h>
+#include <Dewpsi_RendererAPI.h>
+
+namespace Dewpsi {
+    /*
+    Times render passes with GL_TIME_ELAPSED queries. Every pass has three sets of query objects
+    and each frame issues its queries into a free set. At the end of a frame the waiting sets are
+    read oldest first, and a set stays waiting until every one of its results is available; if all
+    sets are waiting, the next frame is not timed. Reading the results never waits for the GPU.
+    */
+    class OpenGLPassTimer {
+    public:
+        static void BeginPass(const char* name);
+        static void EndPass();
+
+        /// Reads the results of the sets that are complete and starts a new frame.
+        static void NextFrame();
+
+        /// Adds the most recent times of the passes to @a stats.
+        static void GetTimings(RendererAPI::Statistics& stats);
+
+        /// Deletes the query objects.
+        static void Shutdown();
+    };
+}
+
+#endif /* DEWPSI_OPENGLPASSTIMER_H */
@@ -1,20 +1,40 @@
 #include "Dewpsi_OpenGLRendererAPI.h"
+#include "Dewpsi_OpenGLStateCache.h"
+#include "Dewpsi_OpenGLFrameCapture.h"
+#include "Dewpsi_OpenGLPassTimer.h"
+#include "Dewpsi_OpenGLTextureLoader.h"
 
 namespace Dewpsi {
 
 void OpenGLRendererAPI::Init()
 {
-    glEnable(GL_BLEND);
-    glEnable(GL_SCISSOR_TEST);
+    OpenGLStateCache::Invalidate();
+    OpenGLStateCache::SetBlend(true);
+    OpenGLStateCache::SetScissorTest(true);
     glDisable(GL_CULL_FACE);
     glDisable(GL_DEPTH_TEST);
     glBlendEquation(GL_FUNC_ADD);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    OpenGLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     glFrontFace(GL_CCW);
 
     PD_CORE_TRACE("Initialized OpenGLRendererAPI");
 }
 
+void OpenGLRendererAPI::Shutdown()
+{
+    OpenGLFrameCapture::Shutdown();
+    OpenGLPassTimer::Shutdown();
+    OpenGLTextureLoader::Shutdown();
+}
+
+void OpenGLRendererAPI::BeginFrame()
+{
+    // The previous frame ended with the ImGui renderer, which changes state behind the cache
+    OpenGLStateCache::NextFrame();
+    OpenGLPassTimer::NextFrame();
+    OpenGLTextureLoader::Update();
+}
+
 void OpenGLRendererAPI::SetClearColor(const Color& color)
 {
     m_ClearColor = color;
@@ -27,11 +47,52 @@ void OpenGLRendererAPI::Clear()
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
-void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray)
+// Element type of the indices in @a indexBuffer
+static GLenum GetGLIndexType(const IndexBuffer& indexBuffer)
+{
+    return (indexBuffer.GetIndexType() == IndexType::UInt16) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+}
+
+void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, PDuint32 indexCount)
+{
+    const IndexBuffer& indexBuffer = *vertexArray->GetIndexBuffer();
+    PDuint32 uiCount = indexCount ? indexCount : indexBuffer.GetCount();
+    glDrawElements(GL_TRIANGLES, uiCount, GetGLIndexType(indexBuffer), nullptr);
+}
+
+void OpenGLRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, PDuint32 instanceCount,
+    PDuint32 indexCount, PDuint32 baseInstance)
 {
-    glDrawElements(GL_TRIANGLES, vertexArray->GetIndexBuffer()->GetCount(),
-                  GL_UNSIGNED_INT, nullptr);
+    const IndexBuffer& indexBuffer = *vertexArray->GetIndexBuffer();
+    PDuint32 uiCount = indexCount ? indexCount : indexBuffer.GetCount();
+    const GLenum type = GetGLIndexType(indexBuffer);
+    if (baseInstance)
+        glDrawElementsInstancedBaseInstance(GL_TRIANGLES, uiCount, type, nullptr, instanceCount, baseInstance);
+    else
+        glDrawElementsInstanced(GL_TRIANGLES, uiCount, type, nullptr, instanceCount);
 }
 
+void OpenGLRendererAPI::DrawArrays(const Ref<VertexArray>& vertexArray, PDuint32 vertexCount, PrimitiveType type)
+{
+    glDrawArrays((type == PrimitiveType::Lines) ? GL_LINES : GL_TRIANGLES, 0, vertexCount);
+}
+
+void OpenGLRendererAPI::BeginPass(const char* name)
+{
+    OpenGLPassTimer::BeginPass(name);
+}
+
+void OpenGLRendererAPI::EndPass()
+{
+    OpenGLPassTimer::EndPass();
+}
+
+void OpenGLRendererAPI::GetFrameStats(Statistics& stats)
+{
+    const OpenGLStateCache::Statistics& cache = OpenGLStateCache::GetStats();
+    stats.stateChanges += cache.issued;
+    stats.stateChangesElided += cache.elided;
+    OpenGLPassTimer::GetTimings(stats);
+}
 
 }
@@ -8,9 +8,17 @@ namespace Dewpsi {
     class OpenGLRendererAPI : public RendererAPI {
 	public:
         virtual void Init() override;
+        virtual void Shutdown() override;
+        virtual void BeginFrame() override;
         virtual void SetClearColor(const Color& color) override;
 		virtual void Clear() override;
-		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray) override;
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, PDuint32 indexCount) override;
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, PDuint32 instanceCount,
+			PDuint32 indexCount, PDuint32 baseInstance) override;
+		virtual void DrawArrays(const Ref<VertexArray>& vertexArray, PDuint32 vertexCount, PrimitiveType type) override;
+		virtual void BeginPass(const char* name) override;
+		virtual void EndPass() override;
+		virtual void GetFrameStats(Statistics& stats) override;
 	};
 }
 
@@ -1,6 +1,7 @@
 #define GLCall_IMPL
 #include "Dewpsi_Shader.h"
 #include "Dewpsi_OpenGLShader.h"
+#include "Dewpsi_OpenGLStateCache.h"
 #include "Dewpsi_Memory.h"
 #include "Dewpsi_String.h"
 #include "_Dewpsi_Int_Shader.h"
@@ -9,18 +10,21 @@
 
 #include <glm/gtc/type_ptr.hpp>
 #include <fstream>
+#include <algorithm>
+#include <filesystem>
 
 using Dewpsi::Internal::ShaderProgramSource;
 using Dewpsi::Internal::ShaderType;
 
 namespace Dewpsi {
 
-OpenGLShader::OpenGLShader(const PDstring& vertexSrc, const PDstring& fragmentSrc)
+OpenGLShader::OpenGLShader(const PDstring& vertexSrc, const PDstring& fragmentSrc, bool deferred)
 {
+    PD_GL_THREAD_ASSERT();
     SourceMap sources;
     sources[GL_VERTEX_SHADER] = vertexSrc;
     sources[GL_FRAGMENT_SHADER] = fragmentSrc;
-    bool success = CompileShader(sources);
+    bool success = LoadProgram(sources, deferred);
     PD_CORE_ASSERT(success, "Unable to compile a shader: {}", GetError());
     /*if (! success)
     {
@@ -29,136 +33,239 @@ OpenGLShader::OpenGLShader(const PDstring& vertexSrc, const PDstring& fragmentSr
     }*/
 }
 
-OpenGLShader::OpenGLShader(const PDstring& file)
+OpenGLShader::OpenGLShader(const PDstring& file, bool deferred)
 {
+    PD_GL_THREAD_ASSERT();
     SourceMap sources = PreProcess(ReadFile(file));
-    CompileShader(sources);
+    LoadProgram(sources, deferred);
 }
 
 OpenGLShader::~OpenGLShader()
 {
+    PD_GL_THREAD_ASSERT();
+    for (GLuint shader : m_PendingShaders)
+    {
+        if (shader)
+            glDeleteShader(shader);
+    }
+
+    OpenGLStateCache::ForgetProgram(m_ShaderID);
     glDeleteProgram(m_ShaderID);
 }
 
-void OpenGLShader::Bind() const
+bool OpenGLShader::Bind() const
 {
-    glUseProgram(m_ShaderID);
+    return Use();
 }
 
 void OpenGLShader::UnBind() const
 {
-    glUseProgram(0);
+    OpenGLStateCache::UseProgram(0);
 }
 
 void OpenGLShader::SetInt1(const PDstring& name, int v0)
 {
-    GLCall(glUseProgram(m_ShaderID));
+    SetInt1(UniformId(name.c_str(), name.size()), v0);
+}
+
+void OpenGLShader::SetInt2(const PDstring& name, int v0, int v1)
+{
+    SetInt2(UniformId(name.c_str(), name.size()), v0, v1);
+}
+
+void OpenGLShader::SetInt3(const PDstring& name, int v0, int v1, int v2)
+{
+    SetInt3(UniformId(name.c_str(), name.size()), v0, v1, v2);
+}
+
+void OpenGLShader::SetInt4(const PDstring& name, int v0, int v1, int v2, int v3)
+{
+    SetInt4(UniformId(name.c_str(), name.size()), v0, v1, v2, v3);
+}
+
+void OpenGLShader::SetIntArray(const PDstring& name, const PDint* value, PDsizei count)
+{
+    SetIntArray(UniformId(name.c_str(), name.size()), value, count);
+}
+
+void OpenGLShader::SetUInt1(const PDstring& name, PDuint v0)
+{
+    SetUInt1(UniformId(name.c_str(), name.size()), v0);
+}
+
+void OpenGLShader::SetUInt2(const PDstring& name, PDuint v0, PDuint v1)
+{
+    SetUInt2(UniformId(name.c_str(), name.size()), v0, v1);
+}
+
+void OpenGLShader::SetUInt3(const PDstring& name, PDuint v0, PDuint v1, PDuint v2)
+{
+    SetUInt3(UniformId(name.c_str(), name.size()), v0, v1, v2);
+}
+
+void OpenGLShader::SetUInt4(const PDstring& name, PDuint v0, PDuint v1, PDuint v2, PDuint v3)
+{
+    SetUInt4(UniformId(name.c_str(), name.size()), v0, v1, v2, v3);
+}
+
+void OpenGLShader::SetFloat1(const PDstring& name, float v1)
+{
+    SetFloat1(UniformId(name.c_str(), name.size()), v1);
+}
 
-    GLint iLocation = GetUniformLocation(name);
-    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", name);
+void OpenGLShader::SetFloat2(const PDstring& name, float v1, float v2)
+{
+    SetFloat2(UniformId(name.c_str(), name.size()), v1, v2);
+}
+
+void OpenGLShader::SetFloat3(const PDstring& name, float v1, float v2, float v3)
+{
+    SetFloat3(UniformId(name.c_str(), name.size()), v1, v2, v3);
+}
+
+void OpenGLShader::SetFloat4(const PDstring& name, float v1, float v2, float v3, float v4)
+{
+    SetFloat4(UniformId(name.c_str(), name.size()), v1, v2, v3, v4);
+}
+
+void OpenGLShader::SetMat4(const PDstring& name, PDsizei count, const glm::mat4* value,
+    bool transpose)
+{
+    SetMat4(UniformId(name.c_str(), name.size()), count, value, transpose);
+}
+
+void OpenGLShader::SetInt1(UniformId id, int v0)
+{
+    if (! Use())
+        return;
+
+    GLint iLocation = GetUniformLocation(id);
+    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", id.GetName());
     GLCall(glUniform1i(iLocation, v0));
 }
 
-void OpenGLShader::SetInt2(const PDstring& name, int v0, int v1)
+void OpenGLShader::SetInt2(UniformId id, int v0, int v1)
 {
-    GLCall(glUseProgram(m_ShaderID));
+    if (! Use())
+        return;
 
-    GLint iLocation = GetUniformLocation(name);
-    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", name);
+    GLint iLocation = GetUniformLocation(id);
+    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", id.GetName());
     GLCall(glUniform2i(iLocation, v0, v1));
 }
 
-void OpenGLShader::SetInt3(const PDstring& name, int v0, int v1, int v2)
+void OpenGLShader::SetInt3(UniformId id, int v0, int v1, int v2)
 {
-    GLCall(glUseProgram(m_ShaderID));
+    if (! Use())
+        return;
 
-    GLint iLocation = GetUniformLocation(name);
-    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", name);
+    GLint iLocation = GetUniformLocation(id);
+    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", id.GetName());
     GLCall(glUniform3i(iLocation, v0, v1, v2));
 }
 
-void OpenGLShader::SetInt4(const PDstring& name, int v0, int v1, int v2, int v3)
+void OpenGLShader::SetInt4(UniformId id, int v0, int v1, int v2, int v3)
 {
-    GLCall(glUseProgram(m_ShaderID));
+    if (! Use())
+        return;
 
-    GLint iLocation = GetUniformLocation(name);
-    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", name);
+    GLint iLocation = GetUniformLocation(id);
+    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", id.GetName());
     GLCall(glUniform4i(iLocation, v0, v1, v2, v3));
 }
 
-void OpenGLShader::SetUInt1(const PDstring& name, PDuint v0)
+void OpenGLShader::SetIntArray(UniformId id, const PDint* value, PDsizei count)
 {
-    GLCall(glUseProgram(m_ShaderID));
+    PD_CORE_ASSERT(value, "NULL 'value' parameter");
+    if (! Use())
+        return;
+
+    GLint iLocation = GetUniformLocation(id);
+    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", id.GetName());
+    GLCall(glUniform1iv(iLocation, count, value));
+}
+
+void OpenGLShader::SetUInt1(UniformId id, PDuint v0)
+{
+    if (! Use())
+        return;
 
-    GLint iLocation = GetUniformLocation(name);
-    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", name);
+    GLint iLocation = GetUniformLocation(id);
+    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", id.GetName());
     GLCall(glUniform1ui(iLocation, v0));
 }
 
-void OpenGLShader::SetUInt2(const PDstring& name, PDuint v0, PDuint v1)
+void OpenGLShader::SetUInt2(UniformId id, PDuint v0, PDuint v1)
 {
-    GLCall(glUseProgram(m_ShaderID));
+    if (! Use())
+        return;
 
-    GLint iLocation = GetUniformLocation(name);
-    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", name);
+    GLint iLocation = GetUniformLocation(id);
+    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", id.GetName());
     GLCall(glUniform2ui(iLocation, v0, v1));
 }
 
-void OpenGLShader::SetUInt3(const PDstring& name, PDuint v0, PDuint v1, PDuint v2)
+void OpenGLShader::SetUInt3(UniformId id, PDuint v0, PDuint v1, PDuint v2)
 {
-    GLCall(glUseProgram(m_ShaderID));
+    if (! Use())
+        return;
 
-    GLint iLocation = GetUniformLocation(name);
-    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", name);
+    GLint iLocation = GetUniformLocation(id);
+    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", id.GetName());
     GLCall(glUniform3ui(iLocation, v0, v1, v2));
 }
 
-void OpenGLShader::SetUInt4(const PDstring& name, PDuint v0, PDuint v1, PDuint v2, PDuint v3)
+void OpenGLShader::SetUInt4(UniformId id, PDuint v0, PDuint v1, PDuint v2, PDuint v3)
 {
-    GLCall(glUseProgram(m_ShaderID));
+    if (! Use())
+        return;
 
-    GLint iLocation = GetUniformLocation(name);
-    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", name);
+    GLint iLocation = GetUniformLocation(id);
+    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", id.GetName());
     GLCall(glUniform4ui(iLocation, v0, v1, v2, v3));
 }
 
-void OpenGLShader::SetFloat1(const PDstring& name, float v1)
+void OpenGLShader::SetFloat1(UniformId id, float v1)
 {
-    GLCall(glUseProgram(m_ShaderID));
+    if (! Use())
+        return;
 
-    GLint iLocation = GetUniformLocation(name);
-    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", name);
+    GLint iLocation = GetUniformLocation(id);
+    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", id.GetName());
     GLCall(glUniform1f(iLocation, v1));
 }
 
-void OpenGLShader::SetFloat2(const PDstring& name, float v1, float v2)
+void OpenGLShader::SetFloat2(UniformId id, float v1, float v2)
 {
-    GLCall(glUseProgram(m_ShaderID));
+    if (! Use())
+        return;
 
-    GLint iLocation = GetUniformLocation(name);
-    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", name);
+    GLint iLocation = GetUniformLocation(id);
+    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", id.GetName());
     GLCall(glUniform2f(iLocation, v1, v2));
 }
 
-void OpenGLShader::SetFloat3(const PDstring& name, float v1, float v2, float v3)
+void OpenGLShader::SetFloat3(UniformId id, float v1, float v2, float v3)
 {
-    GLCall(glUseProgram(m_ShaderID));
+    if (! Use())
+        return;
 
-    GLint iLocation = GetUniformLocation(name);
-    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", name);
+    GLint iLocation = GetUniformLocation(id);
+    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", id.GetName());
     GLCall(glUniform3f(iLocation, v1, v2, v3));
 }
 
-void OpenGLShader::SetFloat4(const PDstring& name, float v1, float v2, float v3, float v4)
+void OpenGLShader::SetFloat4(UniformId id, float v1, float v2, float v3, float v4)
 {
-    GLCall(glUseProgram(m_ShaderID));
+    if (! Use())
+        return;
 
-    GLint iLocation = GetUniformLocation(name);
-    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", name);
+    GLint iLocation = GetUniformLocation(id);
+    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", id.GetName());
     GLCall(glUniform4f(iLocation, v1, v2, v3, v4));
 }
 
-void OpenGLShader::SetMat4(const PDstring& name, PDsizei count, const glm::mat4* value,
+void OpenGLShader::SetMat4(UniformId id, PDsizei count, const glm::mat4* value,
     bool transpose)
 {
     PD_CORE_ASSERT(value, "NULL 'values' parameter");
@@ -168,28 +275,74 @@ void OpenGLShader::SetMat4(const PDstring& name, PDsizei count, const glm::mat4*
         PD_BADPARAM("value");
         return;
     }
-    GLCall(glUseProgram(m_ShaderID));
+    if (! Use())
+        return;
 
-    GLint iLocation = GetUniformLocation(name);
-    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", name);
+    GLint iLocation = GetUniformLocation(id);
+    PD_CORE_ASSERT(iLocation >= 0, "Could not find uniform '{0}'", id.GetName());
     glUniformMatrix4fv(iLocation, count, (transpose ? GL_TRUE : GL_FALSE), glm::value_ptr(*value));
 }
 
-int OpenGLShader::GetUniformLocation(const PDstring& name)
+GLint OpenGLShader::GetUniformLocation(UniformId id) const
 {
     PD_CORE_ASSERT(m_ShaderID, "Shader program not initialized!");
-    glUseProgram(m_ShaderID);
 
-    int result = -1;
-    auto found = m_UniformCache.find(name);
+    const PDuint32 uHash = id.GetHash();
+    auto found = std::lower_bound(m_Uniforms.begin(), m_Uniforms.end(), uHash,
+        [](const UniformEntry& entry, PDuint32 hash) { return entry.hash < hash; });
 
-    if (found != m_UniformCache.end())
-        return found->second;
+    // Names that hash alike sit next to each other
+    for (; found != m_Uniforms.end() && found->hash == uHash; ++found)
+    {
+        if (found->name.compare(0, PDstring::npos, id.GetName(), id.GetLength()) == 0)
+            return found->location;
+    }
 
-    int iLocation = glGetUniformLocation(m_ShaderID, name.c_str());
-    m_UniformCache[name] = iLocation;
+    return -1;
+}
 
-    return iLocation;
+void OpenGLShader::BuildUniformTable()
+{
+    m_Uniforms.clear();
+
+    GLint iCount = 0, iMaxLength = 0;
+    glGetProgramiv(m_ShaderID, GL_ACTIVE_UNIFORMS, &iCount);
+    glGetProgramiv(m_ShaderID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &iMaxLength);
+
+    std::vector<char> name(static_cast<PDsizei>(iMaxLength) + 1);
+    m_Uniforms.reserve(iCount);
+
+    for (GLint i = 0; i < iCount; ++i)
+    {
+        GLsizei iLength = 0;
+        GLint iSize = 0;
+        GLenum type = 0;
+        glGetActiveUniform(m_ShaderID, (GLuint) i, iMaxLength, &iLength, &iSize, &type, name.data());
+
+        // Uniforms in blocks have no location; they are set through uniform buffers
+        GLint iLocation = glGetUniformLocation(m_ShaderID, name.data());
+        if (iLocation < 0)
+            continue;
+
+        m_Uniforms.push_back({String::Hash(name.data(), iLength), iLocation, PDstring(name.data(), iLength)});
+
+        // Arrays are reported as "name[0]"; they are also looked up as "name" and by element
+        if (iLength > 3 && std::strcmp(name.data() + iLength - 3, "[0]") == 0)
+        {
+            const PDstring base(name.data(), iLength - 3);
+            m_Uniforms.push_back({String::Hash(base.data(), base.size()), iLocation, base});
+            for (GLint k = 1; k < iSize; ++k)
+            {
+                PDstring element = base + '[' + std::to_string(k) + ']';
+                const GLint iElement = glGetUniformLocation(m_ShaderID, element.c_str());
+                if (iElement >= 0)
+                    m_Uniforms.push_back({String::Hash(element.data(), element.size()), iElement, PD_MOVE(element)});
+            }
+        }
+    }
+
+    std::sort(m_Uniforms.begin(), m_Uniforms.end(),
+        [](const UniformEntry& a, const UniformEntry& b) { return a.hash < b.hash; });
 }
 
 PDstring OpenGLShader::ReadFile(const PDstring& path) const
@@ -268,49 +421,217 @@ const char* OpenGLShader::GetShaderType(GLenum type) const
         return "fragment";
 }
 
-bool OpenGLShader::CompileShader(const OpenGLShader::SourceMap& sources)
+// Header of a cached program binary
+struct ProgramBinaryHeader {
+    PDuint32 magic;
+    PDuint32 version;
+    PDuint32 format;
+    PDuint32 length;
+};
+
+static constexpr PDuint32 _BinaryMagic = 0x42535044; // "PDSB"
+static constexpr PDuint32 _BinaryVersion = 1;
+
+// 64-bit FNV-1a, continued from @a hash
+static PDuint64 HashBytes(PDuint64 hash, const void* data, PDsizei size)
 {
-    PD_CORE_ASSERT(sources.size() <= 2, "Only two shaders supported");
+    const PDuchar* bytes = static_cast<const PDuchar*>(data);
+    for (PDsizei i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
 
-    Dewpsi::Array<GLuint, 2> shaderIds = {0, 0};
-    short int iShaderIdIndex = 0;
-    bool result = true;
+static PDuint64 HashString(PDuint64 hash, const char* str)
+{
+    return str ? HashBytes(hash, str, std::strlen(str) + 1) : hash;
+}
 
-    auto clearShaders = [&shaderIds](GLuint program) -> void {
-        for (auto& val : shaderIds)
-        {
-            if (val)
-            {
-                glDetachShader(program, val);
-                glDeleteShader(val);
-                val = 0;
-            }
-        }
-    };
+bool OpenGLShader::LoadProgram(const OpenGLShader::SourceMap& sources, bool deferred)
+{
+    GLint iFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &iFormats);
+
+    if (iFormats > 0 && ! Shader::GetCacheDirectory().empty())
+    {
+        m_BinaryPath = GetBinaryPath(sources);
+        if (LoadBinary(m_BinaryPath))
+            return true;
+    }
+
+    BeginCompile(sources);
+    return deferred ? true : FinishCompile();
+}
+
+bool OpenGLShader::Use() const
+{
+    // Finishing the compile is part of construction; it is only postponed until first use.
+    // A failure is logged by FinishCompile(); the program is then 0 and is never bound.
+    if (m_Pending)
+        const_cast<OpenGLShader*>(this)->FinishCompile();
+    if (! m_ShaderID)
+        return false;
+
+    OpenGLStateCache::UseProgram(m_ShaderID);
+    return true;
+}
+
+bool OpenGLShader::IsReady() const
+{
+    if (! m_Pending)
+        return true;
+
+    // Without the extension there is no way to ask without blocking
+    if (! glMaxShaderCompilerThreadsKHR)
+        return true;
+
+    GLint iDone = GL_FALSE;
+    glGetProgramiv(m_ShaderID, GL_COMPLETION_STATUS_KHR, &iDone);
+    return iDone == GL_TRUE;
+}
+
+PDstring OpenGLShader::GetBinaryPath(const OpenGLShader::SourceMap& sources) const
+{
+    // The map is unordered; hash the stages in a fixed order
+    std::vector<GLenum> stages;
+    for (const auto& src : sources)
+        stages.push_back(src.first);
+    std::sort(stages.begin(), stages.end());
+
+    PDuint64 hash = 14695981039346656037ull;
+    for (GLenum stage : stages)
+    {
+        hash = HashBytes(hash, &stage, sizeof(stage));
+        const PDstring& source = sources.at(stage);
+        hash = HashBytes(hash, source.data(), source.size());
+    }
+
+    // A binary is only valid for the driver that produced it
+    hash = HashString(hash, (const char*) glGetString(GL_VENDOR));
+    hash = HashString(hash, (const char*) glGetString(GL_RENDERER));
+    hash = HashString(hash, (const char*) glGetString(GL_VERSION));
+
+    char caName[32];
+    std::snprintf(caName, sizeof(caName), "%016llx.bin", (unsigned long long) hash);
+    return (std::filesystem::path(Shader::GetCacheDirectory()) / caName).string();
+}
+
+bool OpenGLShader::LoadBinary(const PDstring& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (! in)
+        return false;
+
+    ProgramBinaryHeader header;
+    if (! in.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != _BinaryMagic
+        || header.version != _BinaryVersion || ! header.length)
+    {
+        PD_CORE_WARN("Ignoring invalid shader cache file {0}", path);
+        return false;
+    }
+
+    std::vector<char> binary(header.length);
+    if (! in.read(binary.data(), header.length))
+    {
+        PD_CORE_WARN("Ignoring truncated shader cache file {0}", path);
+        return false;
+    }
 
-    // compile each shader
     GLuint program = glCreateProgram();
+    glProgramBinary(program, (GLenum) header.format, binary.data(), (GLsizei) header.length);
 
-    for (auto& src : sources)
+    // The driver rejects binaries it cannot use, e.g. after an update; compile from source then
+    GLint iStatus = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &iStatus);
+    if (iStatus != GL_TRUE)
+    {
+        PD_CORE_TRACE("Shader cache file {0} was rejected by the driver", path);
+        glDeleteProgram(program);
+        return false;
+    }
+
+    m_ShaderID = program;
+    BuildUniformTable();
+    return true;
+}
+
+void OpenGLShader::SaveBinary(const PDstring& path) const
+{
+    GLint iLength = 0;
+    glGetProgramiv(m_ShaderID, GL_PROGRAM_BINARY_LENGTH, &iLength);
+    if (iLength <= 0)
+        return;
+
+    std::vector<char> binary(static_cast<PDsizei>(iLength));
+    GLenum format = 0;
+    glGetProgramBinary(m_ShaderID, iLength, &iLength, &format, binary.data());
+
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+    if (error)
     {
-        const char* cpShaderType = GetShaderType(src.first);
+        PD_CORE_WARN("Failed to create shader cache directory: {0}", error.message());
+        return;
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (! out)
+    {
+        PD_CORE_WARN("Failed to open {0} for writing", path);
+        return;
+    }
 
+    ProgramBinaryHeader header = {_BinaryMagic, _BinaryVersion, (PDuint32) format, (PDuint32) iLength};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(binary.data(), iLength);
+}
+
+void OpenGLShader::BeginCompile(const OpenGLShader::SourceMap& sources)
+{
+    PD_CORE_ASSERT(sources.size() <= 2, "Only two shaders supported");
+
+    short int iShaderIdIndex = 0;
+    GLuint program = glCreateProgram();
+
+    // compile each shader
+    for (auto& src : sources)
+    {
         // src: pair: first=GLenum, second=PDstring
         GLuint shader = glCreateShader(src.first);
-        PD_CORE_ASSERT(shader, "Failed to create {} shader", cpShaderType);
+        PD_CORE_ASSERT(shader, "Failed to create {} shader", GetShaderType(src.first));
 
-        // compile source code
         const char* cpShaderSource = src.second.c_str();
         GLCall(glShaderSource(shader, 1, &cpShaderSource, nullptr));
         GLCall(glCompileShader(shader));
+        glAttachShader(program, shader);
+        m_PendingShaders[iShaderIdIndex++] = shader;
+    }
 
-        // error check
-        if (CheckShader(shader, cpShaderType))
-        {
-            glAttachShader(program, shader);
-            shaderIds[iShaderIdIndex++] = shader;
-        }
-        else
+    // Link without waiting for the compile; no status is queried until FinishCompile(), so a
+    // driver with KHR_parallel_shader_compile keeps working on it in the background
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(program);
+
+    m_ShaderID = program;
+    m_Pending = true;
+}
+
+bool OpenGLShader::FinishCompile()
+{
+    bool result = true;
+    m_Pending = false;
+
+    // error check
+    for (GLuint shader : m_PendingShaders)
+    {
+        if (! shader)
+            continue;
+
+        GLint iType = 0;
+        glGetShaderiv(shader, GL_SHADER_TYPE, &iType);
+        if (! CheckShader(shader, GetShaderType((GLenum) iType)))
         {
             result = false;
             SetError("%s", m_ErrorLog.data());
@@ -318,25 +639,34 @@ bool OpenGLShader::CompileShader(const OpenGLShader::SourceMap& sources)
         }
     }
 
+    if (result && ! CheckProgram(m_ShaderID))
+    {
+        result = false;
+        SetError("%s", m_ErrorLog.data());
+    }
+
+    for (auto& shader : m_PendingShaders)
+    {
+        if (shader)
+        {
+            glDetachShader(m_ShaderID, shader);
+            glDeleteShader(shader);
+            shader = 0;
+        }
+    }
+
     // delete program if this fails
     if (! result)
     {
-        glDeleteProgram(program);
-        clearShaders(program);
+        OpenGLStateCache::ForgetProgram(m_ShaderID);
+        glDeleteProgram(m_ShaderID);
+        m_ShaderID = 0;
     }
     else
     {
-        // link shader objects into program object
-        m_ShaderID = program;
-        program = 0;
-        glLinkProgram(m_ShaderID);
-        if (! CheckProgram(m_ShaderID))
-        {
-            clearShaders(m_ShaderID);
-            glDeleteProgram(m_ShaderID);
-            m_ShaderID = 0;
-        }
-        clearShaders(m_ShaderID);
+        BuildUniformTable();
+        if (! m_BinaryPath.empty())
+            SaveBinary(m_BinaryPath);
     }
 
     m_ErrorLog.clear();
@@ -356,13 +686,11 @@ bool OpenGLShader::CheckShader(GLuint shader, const char* desc)
     // there is an error
     if (iStatus == GL_FALSE)
     {
-        // print the error
+        // print the error; some drivers give no log
+        m_ErrorLog.assign(static_cast<PDuint>(std::max(iLogLen, 1) + 1), '\0');
         if (iLogLen > 1)
-        {
-            m_ErrorLog.resize(static_cast<PDuint>(iLogLen + 1));
             glGetShaderInfoLog(shader, iLogLen, nullptr, m_ErrorLog.data());
-            PD_CORE_ERROR("Failed to compile {0} shader: {1}", desc, m_ErrorLog.data());
-        }
+        PD_CORE_ERROR("Failed to compile {0} shader: {1}", desc, m_ErrorLog.data());
     }
 
     return (bool) iStatus == GL_TRUE;
@@ -379,13 +707,11 @@ bool OpenGLShader::CheckProgram(PDuint program)
     // there is an error
     if (iStatus == GL_FALSE)
     {
-        // print the error
+        // print the error; some drivers give no log
+        m_ErrorLog.assign(static_cast<PDuint>(std::max(iLogLen, 1) + 1), '\0');
         if (iLogLen > 1)
-        {
-            m_ErrorLog.resize(static_cast<PDuint>(iLogLen + 1));
             glGetProgramInfoLog(program, iLogLen, nullptr, m_ErrorLog.data());
-            PD_CORE_ERROR("ERROR: failed to link shader program: {1}", m_ErrorLog.data());
-        }
+        PD_CORE_ERROR("Failed to link shader program: {0}", m_ErrorLog.data());
     }
 
     return (bool) iStatus == GL_TRUE;
@@ -4,23 +4,27 @@
 #include "Dewpsi_Core.h"
 #include "Dewpsi_Shader.h"
 #include "Dewpsi_OpenGL.h"
+#include "Dewpsi_Array.h"
 
 #include <unordered_map>
 
 namespace Dewpsi {
     class OpenGLShader : public Shader {
     public:
-        OpenGLShader(const PDstring& vertexSrc, const PDstring& fragmentSrc);
-        OpenGLShader(const PDstring& file);
+        OpenGLShader(const PDstring& vertexSrc, const PDstring& fragmentSrc, bool deferred = false);
+        OpenGLShader(const PDstring& file, bool deferred = false);
         virtual ~OpenGLShader();
 
-        virtual void Bind() const override;
+        virtual bool Bind() const override;
         virtual void UnBind() const override;
+        virtual bool IsReady() const override;
+        virtual PDuint GetRendererID() const override {return m_ShaderID;}
 
         virtual void SetInt1(const PDstring& name, PDint v0) override;
         virtual void SetInt2(const PDstring& name, PDint v1, PDint v2) override;
         virtual void SetInt3(const PDstring& name, PDint v1, PDint v2, PDint v3) override;
         virtual void SetInt4(const PDstring& name, PDint v1, PDint v2, PDint v3, PDint v4) override;
+        virtual void SetIntArray(const PDstring& name, const PDint* value, PDsizei count) override;
 
         virtual void SetUInt1(const PDstring& name, PDuint v0) override;
         virtual void SetUInt2(const PDstring& name, PDuint v1, PDuint v2) override;
@@ -35,20 +39,56 @@ namespace Dewpsi {
         virtual void SetMat4(const PDstring& name, PDsizei count, const glm::mat4* value,
             bool transpose = false) override;
 
+        virtual void SetInt1(UniformId id, PDint v0) override;
+        virtual void SetInt2(UniformId id, PDint v1, PDint v2) override;
+        virtual void SetInt3(UniformId id, PDint v1, PDint v2, PDint v3) override;
+        virtual void SetInt4(UniformId id, PDint v1, PDint v2, PDint v3, PDint v4) override;
+        virtual void SetIntArray(UniformId id, const PDint* value, PDsizei count) override;
+
+        virtual void SetUInt1(UniformId id, PDuint v0) override;
+        virtual void SetUInt2(UniformId id, PDuint v1, PDuint v2) override;
+        virtual void SetUInt3(UniformId id, PDuint v1, PDuint v2, PDuint v3) override;
+        virtual void SetUInt4(UniformId id, PDuint v1, PDuint v2, PDuint v3, PDuint v4) override;
+
+        virtual void SetFloat1(UniformId id, PDfloat v1) override;
+        virtual void SetFloat2(UniformId id, PDfloat v1, PDfloat v2) override;
+        virtual void SetFloat3(UniformId id, PDfloat v1, PDfloat v2, PDfloat v3) override;
+        virtual void SetFloat4(UniformId id, PDfloat v1, PDfloat v2, PDfloat v3, PDfloat v4) override;
+
+        virtual void SetMat4(UniformId id, PDsizei count, const glm::mat4* value,
+            bool transpose = false) override;
+
     private:
         typedef std::unordered_map<GLenum, PDstring> SourceMap;
 
+        // Location of an active uniform, keyed by the hash of its name; the name settles collisions
+        struct UniformEntry {
+            PDuint32 hash;
+            GLint location;
+            PDstring name;
+        };
+
         PDstring ReadFile(const PDstring& path) const;
         SourceMap PreProcess(const PDstring& source) const;
         GLenum GetShaderType(const PDstring& name) const;
         const char* GetShaderType(GLenum type) const;
-        bool CompileShader(const SourceMap& sources);
-        int GetUniformLocation(const PDstring& name);
+        bool LoadProgram(const SourceMap& sources, bool deferred);
+        PDstring GetBinaryPath(const SourceMap& sources) const;
+        bool LoadBinary(const PDstring& path);
+        void SaveBinary(const PDstring& path) const;
+        void BeginCompile(const SourceMap& sources);
+        bool FinishCompile();
+        bool Use() const;
+        GLint GetUniformLocation(UniformId id) const;
+        void BuildUniformTable();
         bool CheckShader(GLuint shader, const char* desc);
         bool CheckProgram(PDuint program);
 
         PDuint m_ShaderID = 0;
-        std::unordered_map<PDstring, int> m_UniformCache;
+        std::vector<UniformEntry> m_Uniforms; // sorted by hash
+        PDstring m_BinaryPath;
+        Array<GLuint, 2> m_PendingShaders = {0, 0}; // compiled, status not yet checked
+        bool m_Pending = false;
         std::vector<char> m_ErrorLog;
     };
 }
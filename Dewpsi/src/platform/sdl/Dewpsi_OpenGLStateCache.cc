@@ -0,0 +1,328 @@
+#include "Dewpsi_OpenGLStateCache.h"
+#include "Dewpsi_Array.h"
+
+// Gathered in every build; they feed Renderer::GetStats()
+#define COUNT_ISSUED() ++_Current.issued
+#define COUNT_ELIDED(field) (++_Current.elided, ++_Current.field)
+
+namespace Dewpsi {
+
+// Binding whose value is not known; the next bind is always issued
+static constexpr GLuint _Unknown = 0xffffffff;
+
+// Generic buffer binding points that are tracked
+enum BufferSlot : PDuint {
+    SlotArray,
+    SlotCopyRead,
+    SlotCopyWrite,
+    SlotUniform,
+    SlotPixelPack,
+    SlotPixelUnpack,
+    SlotCount
+};
+
+struct GLState {
+    GLuint program;
+    GLuint vertexArray;
+    Array<GLuint, SlotCount> buffers;
+    Array<GLuint, OpenGLStateCache::MaxBufferBindings> uniformBindings;
+    PDuint activeUnit;
+    Array<GLuint, OpenGLStateCache::MaxTextureUnits> textures;
+    Array<GLuint, OpenGLStateCache::MaxTextureUnits> samplers;
+    GLint blend; // -1 = unknown
+    GLenum blendSrc, blendDst;
+    GLint scissorTest;
+    GLint scissor[4];
+    bool scissorKnown;
+};
+
+static GLState _State;
+static OpenGLStateCache::Statistics _Current = {};
+static OpenGLStateCache::Statistics _Last = {};
+static bool _Initialized = false;
+
+static PDuint GetBufferSlot(GLenum target)
+{
+    switch (target)
+    {
+        case GL_ARRAY_BUFFER:           return SlotArray;
+        case GL_COPY_READ_BUFFER:       return SlotCopyRead;
+        case GL_COPY_WRITE_BUFFER:      return SlotCopyWrite;
+        case GL_UNIFORM_BUFFER:         return SlotUniform;
+        case GL_PIXEL_PACK_BUFFER:      return SlotPixelPack;
+        case GL_PIXEL_UNPACK_BUFFER:    return SlotPixelUnpack;
+        default: break;
+    }
+
+    return SlotCount;
+}
+
+static void EnsureInitialized()
+{
+    if (! _Initialized)
+        OpenGLStateCache::Invalidate();
+}
+
+void OpenGLStateCache::UseProgram(GLuint program)
+{
+    EnsureInitialized();
+    if (_State.program == program)
+    {
+        COUNT_ELIDED(programsElided);
+        return;
+    }
+
+    glUseProgram(program);
+    _State.program = program;
+    COUNT_ISSUED();
+}
+
+void OpenGLStateCache::BindVertexArray(GLuint vertexArray)
+{
+    EnsureInitialized();
+    if (_State.vertexArray == vertexArray)
+    {
+        COUNT_ELIDED(vertexArraysElided);
+        return;
+    }
+
+    glBindVertexArray(vertexArray);
+    _State.vertexArray = vertexArray;
+    COUNT_ISSUED();
+}
+
+void OpenGLStateCache::BindBuffer(GLenum target, GLuint buffer)
+{
+    EnsureInitialized();
+    const PDuint uSlot = GetBufferSlot(target);
+    if (uSlot < SlotCount)
+    {
+        if (_State.buffers[uSlot] == buffer)
+        {
+            COUNT_ELIDED(buffersElided);
+            return;
+        }
+        _State.buffers[uSlot] = buffer;
+    }
+
+    glBindBuffer(target, buffer);
+    COUNT_ISSUED();
+}
+
+void OpenGLStateCache::BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+    EnsureInitialized();
+    if (target == GL_UNIFORM_BUFFER && index < MaxBufferBindings)
+    {
+        if (_State.uniformBindings[index] == buffer)
+        {
+            COUNT_ELIDED(buffersElided);
+            return;
+        }
+        _State.uniformBindings[index] = buffer;
+    }
+
+    // glBindBufferBase also binds the buffer to the generic binding point
+    glBindBufferBase(target, index, buffer);
+    const PDuint uSlot = GetBufferSlot(target);
+    if (uSlot < SlotCount)
+        _State.buffers[uSlot] = buffer;
+    COUNT_ISSUED();
+}
+
+void OpenGLStateCache::ActiveTexture(PDuint unit)
+{
+    EnsureInitialized();
+    if (_State.activeUnit == unit)
+    {
+        COUNT_ELIDED(texturesElided);
+        return;
+    }
+
+    glActiveTexture(GL_TEXTURE0 + unit);
+    _State.activeUnit = unit;
+    COUNT_ISSUED();
+}
+
+void OpenGLStateCache::BindTexture(PDuint unit, GLuint texture)
+{
+    EnsureInitialized();
+    PD_CORE_ASSERT(unit < MaxTextureUnits, "Texture unit {0} is out of range", unit);
+    if (_State.textures[unit] == texture)
+    {
+        COUNT_ELIDED(texturesElided);
+        return;
+    }
+
+    ActiveTexture(unit);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    _State.textures[unit] = texture;
+    COUNT_ISSUED();
+}
+
+void OpenGLStateCache::BindTexture(GLuint texture)
+{
+    EnsureInitialized();
+    if (_State.activeUnit >= MaxTextureUnits)
+    {
+        // Active unit unknown; bind without recording
+        glBindTexture(GL_TEXTURE_2D, texture);
+        COUNT_ISSUED();
+        return;
+    }
+
+    BindTexture(_State.activeUnit, texture);
+}
+
+void OpenGLStateCache::BindSampler(PDuint unit, GLuint sampler)
+{
+    EnsureInitialized();
+    PD_CORE_ASSERT(unit < MaxTextureUnits, "Texture unit {0} is out of range", unit);
+    if (_State.samplers[unit] == sampler)
+    {
+        COUNT_ELIDED(texturesElided);
+        return;
+    }
+
+    glBindSampler(unit, sampler);
+    _State.samplers[unit] = sampler;
+    COUNT_ISSUED();
+}
+
+void OpenGLStateCache::SetBlend(bool enable)
+{
+    EnsureInitialized();
+    if (_State.blend == (GLint) enable)
+    {
+        COUNT_ELIDED(stateElided);
+        return;
+    }
+
+    if (enable)
+        glEnable(GL_BLEND);
+    else
+        glDisable(GL_BLEND);
+    _State.blend = (GLint) enable;
+    COUNT_ISSUED();
+}
+
+void OpenGLStateCache::SetBlendFunc(GLenum src, GLenum dst)
+{
+    EnsureInitialized();
+    if (_State.blendSrc == src && _State.blendDst == dst)
+    {
+        COUNT_ELIDED(stateElided);
+        return;
+    }
+
+    glBlendFunc(src, dst);
+    _State.blendSrc = src;
+    _State.blendDst = dst;
+    COUNT_ISSUED();
+}
+
+void OpenGLStateCache::SetScissorTest(bool enable)
+{
+    EnsureInitialized();
+    if (_State.scissorTest == (GLint) enable)
+    {
+        COUNT_ELIDED(stateElided);
+        return;
+    }
+
+    if (enable)
+        glEnable(GL_SCISSOR_TEST);
+    else
+        glDisable(GL_SCISSOR_TEST);
+    _State.scissorTest = (GLint) enable;
+    COUNT_ISSUED();
+}
+
+void OpenGLStateCache::SetScissor(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    EnsureInitialized();
+    if (_State.scissorKnown && _State.scissor[0] == x && _State.scissor[1] == y
+        && _State.scissor[2] == width && _State.scissor[3] == height)
+    {
+        COUNT_ELIDED(stateElided);
+        return;
+    }
+
+    glScissor(x, y, width, height);
+    _State.scissor[0] = x;
+    _State.scissor[1] = y;
+    _State.scissor[2] = width;
+    _State.scissor[3] = height;
+    _State.scissorKnown = true;
+    COUNT_ISSUED();
+}
+
+void OpenGLStateCache::ForgetProgram(GLuint program)
+{
+    // A deleted program stays in use until another one is, so its state is unknown
+    if (_State.program == program)
+        _State.program = _Unknown;
+}
+
+void OpenGLStateCache::ForgetVertexArray(GLuint vertexArray)
+{
+    if (_State.vertexArray == vertexArray)
+        _State.vertexArray = 0;
+}
+
+void OpenGLStateCache::ForgetBuffer(GLuint buffer)
+{
+    for (auto& binding : _State.buffers)
+    {
+        if (binding == buffer)
+            binding = 0;
+    }
+    for (auto& binding : _State.uniformBindings)
+    {
+        if (binding == buffer)
+            binding = 0;
+    }
+}
+
+void OpenGLStateCache::ForgetTexture(GLuint texture)
+{
+    for (auto& binding : _State.textures)
+    {
+        if (binding == texture)
+            binding = 0;
+    }
+}
+
+void OpenGLStateCache::Invalidate()
+{
+    _State.program = _Unknown;
+    _State.vertexArray = _Unknown;
+    for (auto& binding : _State.buffers)
+        binding = _Unknown;
+    for (auto& binding : _State.uniformBindings)
+        binding = _Unknown;
+    _State.activeUnit = _Unknown;
+    for (auto& binding : _State.textures)
+        binding = _Unknown;
+    for (auto& binding : _State.samplers)
+        binding = _Unknown;
+    _State.blend = -1;
+    _State.blendSrc = _State.blendDst = _Unknown;
+    _State.scissorTest = -1;
+    _State.scissorKnown = false;
+    _Initialized = true;
+}
+
+void OpenGLStateCache::NextFrame()
+{
+    Invalidate();
+    _Last = _Current;
+    _Current = {};
+}
+
+const OpenGLStateCache::Statistics& OpenGLStateCache::GetStats()
+{
+    return _Last;
+}
+
+}
@@ -0,0 +1,72 @@
+#ifndef DEWPSI_OPENGLSTATECACHE_H
+#define DEWPSI_OPENGLSTATECACHE_H
+
+#include <Dewpsi_Core.h>
+#include <Dewpsi_OpenGL.h>
+#include <Dewpsi_RenderThread.h>
+
+/*
+OpenGL objects belong to the context, which is only current on the render thread while that thread
+runs. The constructors and destructors of the backend's objects check that they run there.
+*/
+#define PD_GL_THREAD_ASSERT() PD_CORE_ASSERT(! ::Dewpsi::RenderThread::IsRecording(), \
+    "OpenGL objects must be created and destroyed on the render thread")
+
+namespace Dewpsi {
+    /*
+    Shadow copy of the OpenGL binding state of the context. Every bind in the OpenGL backend goes
+    through here and is skipped if the object is already bound. Anything that changes GL state
+    behind the cache's back (e.g., the ImGui renderer) must be followed by Invalidate(), which
+    OpenGLRendererAPI::BeginFrame() does at the start of every frame.
+
+    Only GL_TEXTURE_2D bindings are tracked per unit. GL_ELEMENT_ARRAY_BUFFER is part of the
+    vertex array state, so binds to it are always issued.
+    */
+    class OpenGLStateCache {
+    public:
+        /// Call counters of one frame.
+        struct Statistics {
+            PDuint32 issued;                ///< Calls passed on to OpenGL
+            PDuint32 elided;                ///< Calls skipped in total
+            PDuint32 programsElided;        ///< Skipped glUseProgram calls
+            PDuint32 vertexArraysElided;    ///< Skipped glBindVertexArray calls
+            PDuint32 buffersElided;         ///< Skipped glBindBuffer/glBindBufferBase calls
+            PDuint32 texturesElided;        ///< Skipped glActiveTexture/glBindTexture/glBindSampler calls
+            PDuint32 stateElided;           ///< Skipped blend and scissor calls
+        };
+
+        static constexpr PDuint MaxTextureUnits = 32;
+        static constexpr PDuint MaxBufferBindings = 16;
+
+        static void UseProgram(GLuint program);
+        static void BindVertexArray(GLuint vertexArray);
+        static void BindBuffer(GLenum target, GLuint buffer);
+        static void BindBufferBase(GLenum target, GLuint index, GLuint buffer);
+        static void ActiveTexture(PDuint unit);
+        static void BindTexture(PDuint unit, GLuint texture);
+        static void BindTexture(GLuint texture); // on the active unit
+        static void BindSampler(PDuint unit, GLuint sampler);
+
+        static void SetBlend(bool enable);
+        static void SetBlendFunc(GLenum src, GLenum dst);
+        static void SetScissorTest(bool enable);
+        static void SetScissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+        // Must be called when an object is deleted; GL unbinds deleted objects and reuses names
+        static void ForgetProgram(GLuint program);
+        static void ForgetVertexArray(GLuint vertexArray);
+        static void ForgetBuffer(GLuint buffer);
+        static void ForgetTexture(GLuint texture);
+
+        /// Marks every cached binding as unknown, so the next bind of each is issued.
+        static void Invalidate();
+
+        /// Invalidates the cache and starts counting calls for a new frame.
+        static void NextFrame();
+
+        /// Returns the counters of the previous frame.
+        static const Statistics& GetStats();
+    };
+}
+
+#endif /* DEWPSI_OPENGLSTATECACHE_H */
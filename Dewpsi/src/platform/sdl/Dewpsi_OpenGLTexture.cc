@@ -1,4 +1,5 @@
 #include "Dewpsi_OpenGLTexture.h"
+#include "Dewpsi_OpenGLStateCache.h"
 #include "Dewpsi_Log.h"
 #include <limits>
 
@@ -6,30 +7,63 @@
 
 namespace Dewpsi {
 
-OpenGLTexture2D::OpenGLTexture2D(const PDstring& file) : m_TextureID(0)
+static GLenum GetMinFilter(TextureFilter filter, GLuint levels)
 {
+    if (levels == 1)
+        return filter == TextureFilter::Nearest ? GL_NEAREST : GL_LINEAR;
+
+    switch (filter)
+    {
+        case TextureFilter::Nearest:    return GL_NEAREST_MIPMAP_NEAREST;
+        case TextureFilter::Linear:     return GL_LINEAR_MIPMAP_NEAREST;
+        default: break;
+    }
+
+    return GL_LINEAR_MIPMAP_LINEAR;
+}
+
+OpenGLTexture2D::OpenGLTexture2D(const PDstring& file, const TextureProperties& props)
+    : m_TextureID(0), m_Width(0), m_Height(0), m_Levels(1), m_Properties(props), m_Loaded(true)
+{
+    PD_GL_THREAD_ASSERT();
     RESET_ERROR();
-    GLCall(glCreateTextures(GL_TEXTURE_2D, 1, &m_TextureID));
     Add(file);
 }
 
+OpenGLTexture2D::OpenGLTexture2D(PDuint width, PDuint height, const TextureProperties& props)
+    : m_TextureID(0), m_Width(width), m_Height(height), m_Properties(props), m_Loaded(true)
+{
+    PD_GL_THREAD_ASSERT();
+    RESET_ERROR();
+    m_Levels = GetLevelCount(m_Width, m_Height, m_Properties);
+    m_TextureID = CreateStorage(m_Width, m_Height, GL_RGBA8, m_Levels, m_Properties);
+}
+
+OpenGLTexture2D::OpenGLTexture2D(const TextureProperties& props)
+    : m_TextureID(0), m_Width(1), m_Height(1), m_Levels(1), m_Properties(props), m_Loaded(false)
+{
+    RESET_ERROR();
+}
+
 OpenGLTexture2D::~OpenGLTexture2D()
 {
-    GLCall(glDeleteTextures(1, &m_TextureID));
+    PD_GL_THREAD_ASSERT();
+    OpenGLStateCache::ForgetTexture(m_TextureID);
+    const GLuint uTexture = m_TextureID;
+    GLCall(glDeleteTextures(1, &uTexture));
 }
 
 void OpenGLTexture2D::Bind(PDuint slot) const
 {
-    glActiveTexture(GL_TEXTURE0 + slot);
-    glBindTexture(GL_TEXTURE_2D, m_TextureID);
+    OpenGLStateCache::BindTexture(slot, m_TextureID);
 #ifdef GL_SAMPLER_BINDING
-    glBindSampler(0, 0); // We use combined texture/sampler state. Applications using GL 3.3 may set that otherwise.
+    OpenGLStateCache::BindSampler(slot, 0); // We use combined texture/sampler state. Applications using GL 3.3 may set that otherwise.
 #endif
 }
 
 void OpenGLTexture2D::UnBind() const
 {
-    GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+    GLCall(OpenGLStateCache::BindTexture(0));
 }
 
 const PDuchar* OpenGLTexture2D::GetData() const
@@ -37,6 +71,99 @@ const PDuchar* OpenGLTexture2D::GetData() const
     return nullptr;
 }
 
+void OpenGLTexture2D::SetData(const void* data, PDsizei size)
+{
+    PD_CORE_ASSERT(size == m_Width * m_Height * 4, "Data must cover the entire texture");
+    GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+    GLCall(glTextureSubImage2D(m_TextureID, 0, 0, 0, m_Width, m_Height, GL_RGBA,
+        GL_UNSIGNED_BYTE, data));
+    BuildMipChain(static_cast<const PDuchar*>(data), 4, GL_RGBA);
+}
+
+void OpenGLTexture2D::SetSubData(const void* data, PDuint x, PDuint y, PDuint width, PDuint height)
+{
+    PD_CORE_ASSERT(x + width <= m_Width && y + height <= m_Height, "Rectangle is outside the texture");
+    GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+    GLCall(glTextureSubImage2D(m_TextureID, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, data));
+}
+
+void OpenGLTexture2D::GenerateMipmaps()
+{
+    if (m_Levels > 1)
+        GLCall(glGenerateTextureMipmap(m_TextureID));
+}
+
+PDsizei OpenGLTexture2D::GetMemorySize() const
+{
+    // Drivers pad RGB8 texels to four bytes as well
+    PDsizei szTotal = 0;
+    for (GLuint i = 0; i < m_Levels; ++i)
+        szTotal += (PDsizei) Mipmap::GetLevelSize(m_Width, i) * Mipmap::GetLevelSize(m_Height, i) * 4;
+    return szTotal;
+}
+
+GLuint OpenGLTexture2D::GetLevelCount(GLuint width, GLuint height, const TextureProperties& props)
+{
+    return props.mipmaps == MipmapFilter::None ? 1 : Mipmap::GetLevelCount(width, height);
+}
+
+GLuint OpenGLTexture2D::CreateStorage(GLuint width, GLuint height, GLenum internalFormat, GLuint levels,
+    const TextureProperties& props)
+{
+    GLuint textureID = 0;
+    GLCall(glCreateTextures(GL_TEXTURE_2D, 1, &textureID));
+    GLCall(glTextureStorage2D(textureID, levels, internalFormat, width, height));
+
+    OpenGLStateCache::BindTexture(textureID);
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GetMinFilter(props.minFilter, levels)));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
+        props.magFilter == TextureFilter::Nearest ? GL_NEAREST : GL_LINEAR));
+    return textureID;
+}
+
+void OpenGLTexture2D::BuildMipChain(const PDuchar* base, PDuint channels, GLenum dataFormat)
+{
+    if (m_Levels == 1)
+        return;
+
+    if (m_Properties.mipmaps == MipmapFilter::GPU)
+    {
+        GLCall(glGenerateTextureMipmap(m_TextureID));
+        return;
+    }
+
+    std::vector<PDuchar> chain;
+    Mipmap::BuildChain(base, m_Width, m_Height, channels, m_Properties.mipmaps, chain);
+
+    // Rows of small levels are not 4-byte aligned
+    GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+    const PDuchar* ucpLevel = chain.data();
+    for (GLuint i = 1; i < m_Levels; ++i)
+    {
+        const GLuint uWidth = Mipmap::GetLevelSize(m_Width, i);
+        const GLuint uHeight = Mipmap::GetLevelSize(m_Height, i);
+        GLCall(glTextureSubImage2D(m_TextureID, i, 0, 0, uWidth, uHeight, dataFormat,
+            GL_UNSIGNED_BYTE, ucpLevel));
+        ucpLevel += (PDsizei) uWidth * uHeight * channels;
+    }
+    GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+}
+
+void OpenGLTexture2D::Adopt(GLuint textureID, GLuint width, GLuint height, GLuint levels)
+{
+    OpenGLStateCache::ForgetTexture(m_TextureID);
+    const GLuint uTexture = m_TextureID;
+    GLCall(glDeleteTextures(1, &uTexture));
+
+    m_TextureID = textureID;
+    m_Width = width;
+    m_Height = height;
+    m_Levels = levels;
+
+    // Last, so the size and levels are complete once IsLoaded() returns true
+    m_Loaded = true;
+}
+
 void OpenGLTexture2D::Add(const PDstring& file)
 {
     GLint iWidth, iHeight, iChannels;
@@ -75,18 +202,22 @@ void OpenGLTexture2D::Add(const PDstring& file)
 
     PD_CORE_TRACE("This texture will have {0} channels", iChannels);
 
-    // Preallocate storage
-    GLCall(glTextureStorage2D(m_TextureID, 1, internalFormat, m_Width, m_Height));
-
-    // Texture parameters
-    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
-    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
-    //GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
-    //GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    // Storage is immutable, so reloading replaces the texture object
+    if (m_TextureID)
+    {
+        OpenGLStateCache::ForgetTexture(m_TextureID);
+        const GLuint uTexture = m_TextureID;
+        GLCall(glDeleteTextures(1, &uTexture));
+    }
+    m_Levels = GetLevelCount(m_Width, m_Height, m_Properties);
+    m_TextureID = CreateStorage(m_Width, m_Height, internalFormat, m_Levels, m_Properties);
 
-    // Upload pixel data to the current subtexture
+    // Upload pixel data to the base level; RGB rows are not necessarily 4-byte aligned
+    GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, iChannels == 4 ? 4 : 1));
     GLCall(glTextureSubImage2D(m_TextureID, 0, 0, 0, m_Width, m_Height, dataFormat,
         GL_UNSIGNED_BYTE, ucpBuffer));
+    BuildMipChain(ucpBuffer, (PDuint) iChannels, dataFormat);
+    GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
     stbi_image_free(ucpBuffer);
 }
 
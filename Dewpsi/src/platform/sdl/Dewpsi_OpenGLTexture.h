@@ -4,6 +4,7 @@
 #include "Dewpsi_Core.h"
 #include "Dewpsi_Texture.h"
 #include "Dewpsi_OpenGL.h"
+#include <atomic>
 
 namespace Dewpsi {
     /*struct OpenGLTextureAttributes {
@@ -43,7 +44,8 @@ namespace Dewpsi {
     class OpenGLTexture2D : public Texture2D {
     public:
         OpenGLTexture2D() = delete;
-        explicit OpenGLTexture2D(const PDstring& file);
+        explicit OpenGLTexture2D(const PDstring& file, const TextureProperties& props = {});
+        OpenGLTexture2D(PDuint width, PDuint height, const TextureProperties& props = {});
         virtual ~OpenGLTexture2D();
 
         virtual void Bind(PDuint slot) const override;
@@ -51,12 +53,42 @@ namespace Dewpsi {
         virtual PDuint GetWidth() const override {return static_cast<GLuint>(m_Width);}
         virtual PDuint GetHeight() const override {return static_cast<GLuint>(m_Height);}
         virtual const PDuchar* GetData() const override;
+        virtual void SetData(const void* data, PDsizei size) override;
+        virtual void SetSubData(const void* data, PDuint x, PDuint y, PDuint width, PDuint height) override;
+        virtual void GenerateMipmaps() override;
+        virtual PDuint GetMipLevelCount() const override {return m_Levels;}
+        virtual const TextureProperties& GetProperties() const override {return m_Properties;}
+        virtual PDsizei GetMemorySize() const override;
+        virtual PDuint GetRendererID() const override {return m_TextureID;}
+        virtual bool IsLoaded() const override {return m_Loaded;}
 
         void Add(const PDstring& file);
+
+        /// Returns the number of levels a texture of the given size gets with @a props.
+        static GLuint GetLevelCount(GLuint width, GLuint height, const TextureProperties& props);
     private:
-        GLuint m_TextureID;
-        GLuint m_Width;
-        GLuint m_Height;
+        friend class OpenGLTextureLoader;
+
+        // A 1x1 texture that is not loaded and has no texture object yet; makes no GL calls
+        explicit OpenGLTexture2D(const TextureProperties& props);
+
+        // Creates a texture object with immutable storage and the sampling state of @a props
+        static GLuint CreateStorage(GLuint width, GLuint height, GLenum internalFormat, GLuint levels,
+            const TextureProperties& props);
+
+        // Fills every level below the base level from @a base, which has the size of the texture
+        void BuildMipChain(const PDuchar* base, PDuint channels, GLenum dataFormat);
+
+        // Replaces the texture object with @a textureID, which is owned from now on
+        void Adopt(GLuint textureID, GLuint width, GLuint height, GLuint levels);
+
+        // Replaced by Adopt() on the render thread while the main thread reads them
+        std::atomic<GLuint> m_TextureID;
+        std::atomic<GLuint> m_Width;
+        std::atomic<GLuint> m_Height;
+        std::atomic<GLuint> m_Levels;
+        TextureProperties m_Properties;
+        std::atomic<bool> m_Loaded;
     };
 }
 
@@ -0,0 +1,309 @@
+#include "Dewpsi_OpenGLTextureLoader.h"
+#include "Dewpsi_OpenGLBuffer.h"
+#include "Dewpsi_OpenGLStateCache.h"
+#include "Dewpsi_RenderThread.h"
+#include "Dewpsi_Log.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Dewpsi {
+
+// Number of frames the upload ring spans
+static constexpr PDuint _RingRegions = 3;
+
+// The placeholder is a single transparent texel, so nothing pops in before the real image
+static constexpr PDuint32 _Placeholder = 0x00000000;
+
+struct DecodeJob {
+    std::weak_ptr<OpenGLTexture2D> texture;
+    PDstring file;
+    TextureProperties props;
+};
+
+struct PendingUpload {
+    std::weak_ptr<OpenGLTexture2D> texture;
+    PDstring file;
+    TextureProperties props;
+    PDuchar* pixels;            // NULL if decoding failed
+    std::vector<PDuchar> chain; // levels below the base level, if built on the CPU
+    GLuint width;
+    GLuint height;
+    GLuint levels;
+    GLuint textureID;           // zero until storage is allocated
+    GLuint level;               // level being uploaded
+    GLuint row;                 // next row of that level
+    PDsizei levelOffset;        // offset of that level in chain
+};
+
+// Shared with the workers
+static std::mutex _Mutex;
+static std::condition_variable _Wake;
+static std::deque<DecodeJob> _Jobs;
+static std::deque<PendingUpload> _Decoded;
+static std::vector<std::thread> _Workers;
+static bool _Stop = false;
+static PDsizei _Decoding = 0; // jobs taken by a worker
+
+// Owned by the GL thread
+static std::deque<PendingUpload> _Uploads;
+static Scope<OpenGLStreamBuffer> _Ring;
+
+// Size of _Uploads, for GetPendingCount() on other threads
+static std::atomic<PDsizei> _Uploading{0};
+
+static void DecodeThread()
+{
+    for (;;)
+    {
+        DecodeJob job;
+        {
+            std::unique_lock<std::mutex> lock(_Mutex);
+            _Wake.wait(lock, []{return _Stop || ! _Jobs.empty();});
+            if (_Stop)
+                return;
+            job = PD_MOVE(_Jobs.front());
+            _Jobs.pop_front();
+            ++_Decoding;
+        }
+
+        PendingUpload upload = {job.texture, PD_MOVE(job.file), job.props, nullptr, {}, 0, 0, 1, 0, 0, 0, 0};
+
+        // Skip the decoding if nobody holds the texture anymore
+        if (! job.texture.expired())
+        {
+            GLint iWidth, iHeight, iChannels;
+            upload.pixels = stbi_load(upload.file.c_str(), &iWidth, &iHeight, &iChannels, 4);
+            if (upload.pixels)
+            {
+                upload.width  = (GLuint) iWidth;
+                upload.height = (GLuint) iHeight;
+                upload.levels = OpenGLTexture2D::GetLevelCount(upload.width, upload.height, upload.props);
+
+                if (upload.levels > 1 && upload.props.mipmaps != MipmapFilter::GPU)
+                    Mipmap::BuildChain(upload.pixels, upload.width, upload.height, 4,
+                        upload.props.mipmaps, upload.chain);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(_Mutex);
+        _Decoded.push_back(PD_MOVE(upload));
+        --_Decoding;
+    }
+}
+
+static void StartWorkers()
+{
+    const PDuint uCores = std::thread::hardware_concurrency();
+    const PDuint uCount = std::min(std::max(uCores, 2u) - 1, 4u);
+
+    _Stop = false;
+    for (PDuint i = 0; i < uCount; ++i)
+        _Workers.emplace_back(DecodeThread);
+    PD_CORE_TRACE("Started {0} texture decoding threads", uCount);
+}
+
+static void FreeUpload(PendingUpload& upload)
+{
+    if (upload.pixels)
+        stbi_image_free(upload.pixels);
+    if (upload.textureID)
+    {
+        OpenGLStateCache::ForgetTexture(upload.textureID);
+        GLCall(glDeleteTextures(1, &upload.textureID));
+    }
+    upload.pixels = nullptr;
+    upload.textureID = 0;
+}
+
+// Returns true once every level of @a upload that is not generated by GL is uploaded
+static bool IsComplete(const PendingUpload& upload)
+{
+    return upload.level == (upload.chain.empty() ? 1 : upload.levels);
+}
+
+// Uploads rows of the current level of @a upload, at most @a budget bytes; returns the number of bytes uploaded
+static PDsizei UploadRows(PendingUpload& upload, PDsizei budget)
+{
+    const GLuint uWidth = Mipmap::GetLevelSize(upload.width, upload.level);
+    const GLuint uHeight = Mipmap::GetLevelSize(upload.height, upload.level);
+    const PDsizei szRowSize = (PDsizei) uWidth * 4;
+    const GLuint uRemaining = uHeight - upload.row;
+    GLuint uRows = (GLuint) std::min<PDsizei>(uRemaining, budget / szRowSize);
+    if (! uRows)
+        return 0;
+
+    const PDuchar* ucpLevel = upload.level ? upload.chain.data() + upload.levelOffset : upload.pixels;
+    const PDuchar* ucpSource = ucpLevel + upload.row * szRowSize;
+
+    GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+    if (szRowSize > _Ring->GetRegionSize())
+    {
+        // A single row does not fit into the ring; upload it straight from client memory
+        uRows = 1;
+        GLCall(glTextureSubImage2D(upload.textureID, upload.level, 0, upload.row, uWidth, uRows,
+            GL_RGBA, GL_UNSIGNED_BYTE, ucpSource));
+    }
+    else
+    {
+        uRows = (GLuint) std::min<PDsizei>(uRows, _Ring->GetRegionSize() / szRowSize);
+        void* dst = _Ring->Map(uRows * szRowSize, 4);
+        if (! dst)
+            return 0; // the region is full until the next frame
+
+        std::memcpy(dst, ucpSource, uRows * szRowSize);
+        _Ring->Unmap();
+
+        // Unbind right away; other uploads would read from the buffer otherwise
+        _Ring->Bind();
+        GLCall(glTextureSubImage2D(upload.textureID, upload.level, 0, upload.row, uWidth, uRows,
+            GL_RGBA, GL_UNSIGNED_BYTE, (const void*) _Ring->GetMappedOffset()));
+        _Ring->UnBind();
+    }
+
+    upload.row += uRows;
+    if (upload.row == uHeight)
+    {
+        if (upload.level)
+            upload.levelOffset += szRowSize * uHeight;
+        ++upload.level;
+        upload.row = 0;
+    }
+    return uRows * szRowSize;
+}
+
+Ref<OpenGLTexture2D> OpenGLTextureLoader::Load(const PDstring& file, const TextureProperties& props)
+{
+    // The texture object is created by the render thread; until then the texture has no ID
+    Ref<OpenGLTexture2D> texture = Ref<OpenGLTexture2D>(new OpenGLTexture2D(props));
+    RenderThread::Enqueue([texture, props]{
+        texture->m_TextureID = OpenGLTexture2D::CreateStorage(1, 1, GL_RGBA8, 1, props);
+        texture->SetData(&_Placeholder, sizeof(_Placeholder));
+    });
+
+    // stb_image keeps this flag globally, so it is set here rather than by the workers
+    stbi_set_flip_vertically_on_load(1);
+
+    {
+        std::lock_guard<std::mutex> lock(_Mutex);
+        if (_Workers.empty())
+            StartWorkers();
+        _Jobs.push_back({texture, file, props});
+    }
+    _Wake.notify_one();
+
+    return texture;
+}
+
+void OpenGLTextureLoader::Update()
+{
+    {
+        std::lock_guard<std::mutex> lock(_Mutex);
+        while (! _Decoded.empty())
+        {
+            _Uploads.push_back(PD_MOVE(_Decoded.front()));
+            _Decoded.pop_front();
+            ++_Uploading;
+        }
+    }
+
+    if (_Uploads.empty())
+        return;
+
+    // A region holds one frame's budget, so the ring is replaced when the budget changes
+    const PDsizei szBudget = Texture2D::GetUploadBudget();
+    if (! _Ring || _Ring->GetRegionSize() != szBudget)
+        _Ring = CreateScope<OpenGLStreamBuffer>(szBudget, _RingRegions, GL_PIXEL_UNPACK_BUFFER);
+
+    PDsizei szSpent = 0;
+    while (! _Uploads.empty())
+    {
+        PendingUpload& upload = _Uploads.front();
+        Ref<OpenGLTexture2D> texture = upload.texture.lock();
+        if (! texture)
+        {
+            FreeUpload(upload);
+            _Uploads.pop_front();
+            --_Uploading;
+            continue;
+        }
+
+        if (! upload.pixels)
+        {
+            PD_CORE_ERROR("Failed to load {0}", upload.file);
+            SetError("Failed to read %s", upload.file.c_str());
+            texture->m_IsError = true;
+            _Uploads.pop_front();
+            --_Uploading;
+            continue;
+        }
+
+        if (! upload.textureID)
+            upload.textureID = OpenGLTexture2D::CreateStorage(upload.width, upload.height, GL_RGBA8,
+                upload.levels, upload.props);
+
+        // Always upload at least one row so that rows larger than the budget still make progress
+        PDsizei szAllowed = szBudget > szSpent ? szBudget - szSpent : 0;
+        if (! szSpent)
+            szAllowed = std::max<PDsizei>(szAllowed, (PDsizei) upload.width * 4);
+
+        const PDsizei szUploaded = UploadRows(upload, szAllowed);
+        szSpent += szUploaded;
+
+        if (! IsComplete(upload))
+        {
+            if (! szUploaded)
+                break;
+            continue; // the next level may still fit
+        }
+
+        if (upload.levels > 1 && upload.chain.empty())
+            GLCall(glGenerateTextureMipmap(upload.textureID));
+
+        texture->Adopt(upload.textureID, upload.width, upload.height, upload.levels);
+        upload.textureID = 0;
+        FreeUpload(upload);
+        _Uploads.pop_front();
+        --_Uploading;
+    }
+
+    // Fence this frame's region; the next one is reused once the GPU has read it
+    if (szSpent)
+        _Ring->NextFrame();
+}
+
+void OpenGLTextureLoader::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(_Mutex);
+        _Stop = true;
+        _Jobs.clear();
+    }
+    _Wake.notify_all();
+
+    for (std::thread& worker : _Workers)
+        worker.join();
+    _Workers.clear();
+
+    for (PendingUpload& upload : _Decoded)
+        FreeUpload(upload);
+    for (PendingUpload& upload : _Uploads)
+        FreeUpload(upload);
+    _Decoded.clear();
+    _Uploads.clear();
+    _Decoding = 0;
+    _Uploading = 0;
+    _Ring.reset();
+}
+
+PDsizei OpenGLTextureLoader::GetPendingCount()
+{
+    std::lock_guard<std::mutex> lock(_Mutex);
+    return _Jobs.size() + _Decoding + _Decoded.size() + _Uploading;
+}
+
+}
@@ -0,0 +1,35 @@
+#ifndef DEWPSI_OPENGLTEXTURELOADER_H
+#define DEWPSI_OPENGLTEXTURELOADER_H
+
+#include <Dewpsi_Core.h>
+#include <Dewpsi_Memory.h>
+#include <Dewpsi_OpenGLTexture.h>
+
+namespace Dewpsi {
+    /*
+    Loads textures for Texture2D::CreateAsync(). Files are decoded by a pool of worker threads
+    that is started on the first load. The decoded pixels are copied into a ring of pixel unpack
+    buffers (an OpenGLStreamBuffer) and uploaded from there a few rows at a time, so a frame never
+    uploads more than Texture2D::GetUploadBudget() bytes. Each image is uploaded into a new
+    texture object, which replaces the placeholder once the last row is uploaded. Mip chains built
+    on the CPU are filtered by the workers as well, and their levels are uploaded like the base level.
+
+    Everything but the decoding happens on the thread that owns the GL context.
+    */
+    class OpenGLTextureLoader {
+    public:
+        /// Returns a placeholder texture and queues @a file for decoding.
+        static Ref<OpenGLTexture2D> Load(const PDstring& file, const TextureProperties& props);
+
+        /// Uploads decoded images within the budget; called once per frame.
+        static void Update();
+
+        /// Stops the worker threads and drops every pending load.
+        static void Shutdown();
+
+        /// Returns the number of textures that are not loaded yet.
+        static PDsizei GetPendingCount();
+    };
+}
+
+#endif /* DEWPSI_OPENGLTEXTURELOADER_H */
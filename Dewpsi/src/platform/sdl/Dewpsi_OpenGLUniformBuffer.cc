@@ -0,0 +1,35 @@
+#include "Dewpsi_OpenGLUniformBuffer.h"
+#include "Dewpsi_OpenGLStateCache.h"
+
+namespace Dewpsi {
+
+OpenGLUniformBuffer::OpenGLUniformBuffer(PDsizei size, PDuint binding)
+    : m_BufferID(0), m_Binding(binding), m_Size(size)
+{
+    PD_GL_THREAD_ASSERT();
+    glCreateBuffers(1, &m_BufferID);
+    OpenGLStateCache::BindBuffer(GL_UNIFORM_BUFFER, m_BufferID);
+    glBufferData(GL_UNIFORM_BUFFER, (GLsizeiptr) size, nullptr, GL_DYNAMIC_DRAW);
+    OpenGLStateCache::BindBufferBase(GL_UNIFORM_BUFFER, m_Binding, m_BufferID);
+}
+
+OpenGLUniformBuffer::~OpenGLUniformBuffer()
+{
+    PD_GL_THREAD_ASSERT();
+    OpenGLStateCache::ForgetBuffer(m_BufferID);
+    glDeleteBuffers(1, &m_BufferID);
+}
+
+void OpenGLUniformBuffer::Bind() const
+{
+    OpenGLStateCache::BindBufferBase(GL_UNIFORM_BUFFER, m_Binding, m_BufferID);
+}
+
+void OpenGLUniformBuffer::SetData(const void* data, PDsizei size, PDsizei offset)
+{
+    PD_CORE_ASSERT(offset + size <= m_Size, "Write goes past the end of the uniform buffer");
+    OpenGLStateCache::BindBuffer(GL_UNIFORM_BUFFER, m_BufferID);
+    glBufferSubData(GL_UNIFORM_BUFFER, (GLintptr) offset, (GLsizeiptr) size, data);
+}
+
+}
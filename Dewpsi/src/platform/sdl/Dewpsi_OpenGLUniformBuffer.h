@@ -0,0 +1,24 @@
+#ifndef DEWPSI_OPENGLUNIFORMBUFFER_H
+#define DEWPSI_OPENGLUNIFORMBUFFER_H
+
+#include <Dewpsi_UniformBuffer.h>
+#include <Dewpsi_OpenGL.h>
+
+namespace Dewpsi {
+    class OpenGLUniformBuffer : public UniformBuffer {
+    public:
+        OpenGLUniformBuffer(PDsizei size, PDuint binding);
+        virtual ~OpenGLUniformBuffer();
+
+        virtual void Bind() const override;
+        virtual void SetData(const void* data, PDsizei size, PDsizei offset = 0) override;
+        virtual PDuint GetBinding() const override {return m_Binding;}
+
+    private:
+        GLuint m_BufferID;
+        PDuint m_Binding;
+        PDsizei m_Size;
+    };
+}
+
+#endif /* DEWPSI_OPENGLUNIFORMBUFFER_H */
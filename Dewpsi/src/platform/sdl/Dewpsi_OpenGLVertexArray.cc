@@ -1,4 +1,5 @@
 #include "Dewpsi_OpenGLVertexArray.h"
+#include "Dewpsi_OpenGLStateCache.h"
 
 static GLenum ShaderType2OpenGLEnum(Dewpsi::ShaderDataType type);
 
@@ -6,22 +7,25 @@ namespace Dewpsi {
 
 OpenGLVertexArray::OpenGLVertexArray()
 {
+    PD_GL_THREAD_ASSERT();
     glGenVertexArrays(1, &m_ArrayID);
 }
 
 OpenGLVertexArray::~OpenGLVertexArray()
 {
-    glDeleteBuffers(1, &m_ArrayID);
+    PD_GL_THREAD_ASSERT();
+    OpenGLStateCache::ForgetVertexArray(m_ArrayID);
+    glDeleteVertexArrays(1, &m_ArrayID);
 }
 
 void OpenGLVertexArray::Bind() const
 {
-    glBindVertexArray(m_ArrayID);
+    OpenGLStateCache::BindVertexArray(m_ArrayID);
 }
 
 void OpenGLVertexArray::UnBind() const
 {
-    glBindVertexArray(0);
+    OpenGLStateCache::BindVertexArray(0);
 }
 
 void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
@@ -29,19 +33,42 @@ void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
     const BufferLayout& layout = vertexBuffer->GetLayout();
     PD_CORE_ASSERT(layout.GetElements().size(), "No layout defined");
 
-    glBindVertexArray(m_ArrayID);
+    OpenGLStateCache::BindVertexArray(m_ArrayID);
     vertexBuffer->Bind();
 
-    PDuint32 uiOffset = 0;
-
+    // Attribute indices continue from the previous buffer so that per-vertex and
+    // per-instance buffers can share the vertex array
     for (const auto& element : layout)
     {
-        glEnableVertexAttribArray(uiOffset);
-        glVertexAttribPointer(uiOffset, element.GetComponentCount(),
-                              ShaderType2OpenGLEnum(element.type),
-                              element.normalized ? GL_TRUE : GL_FALSE, layout.GetStride(),
-                              (void*) element.offset);
-        ++uiOffset;
+        // A matrix takes up one attribute per column
+        PDuint32 uiColumns = 1;
+        PDuint32 uiComponents = element.GetComponentCount();
+        if (element.type == ShaderDataType::Mat3 || element.type == ShaderDataType::Mat4)
+        {
+            uiColumns = (element.type == ShaderDataType::Mat3) ? 3 : 4;
+            uiComponents = uiColumns;
+        }
+
+        for (PDuint32 i = 0; i < uiColumns; ++i)
+        {
+            const PDsizei szOffset = element.offset + i * uiComponents * sizeof(float);
+            glEnableVertexAttribArray(m_AttribIndex);
+            if (element.IsInteger())
+            {
+                // Without the I variant, integers would reach the shader converted to floats
+                glVertexAttribIPointer(m_AttribIndex, uiComponents, ShaderType2OpenGLEnum(element.type),
+                                       layout.GetStride(), (void*) szOffset);
+            }
+            else
+            {
+                glVertexAttribPointer(m_AttribIndex, uiComponents,
+                                      ShaderType2OpenGLEnum(element.type),
+                                      element.normalized ? GL_TRUE : GL_FALSE, layout.GetStride(),
+                                      (void*) szOffset);
+            }
+            glVertexAttribDivisor(m_AttribIndex, layout.GetDivisor());
+            ++m_AttribIndex;
+        }
     }
     m_VertexBuffers.push_back(vertexBuffer);
     vertexBuffer->UnBind();
@@ -49,7 +76,7 @@ void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
 
 void OpenGLVertexArray::SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer)
 {
-    glBindVertexArray(m_ArrayID);
+    OpenGLStateCache::BindVertexArray(m_ArrayID);
     indexBuffer->Bind();
     m_IndexBuffer = indexBuffer;
 }
@@ -76,6 +103,15 @@ GLenum ShaderType2OpenGLEnum(Dewpsi::ShaderDataType type)
             return GL_INT;
         case ShaderDataType::Bool:
             return GL_BOOL;
+        case ShaderDataType::UByte4Norm:
+            return GL_UNSIGNED_BYTE;
+        case ShaderDataType::Short2Norm:
+            return GL_SHORT;
+        case ShaderDataType::Half2:
+        case ShaderDataType::Half4:
+            return GL_HALF_FLOAT;
+        case ShaderDataType::UInt10_10_10_2:
+            return GL_UNSIGNED_INT_2_10_10_10_REV;
     }
 
     return (GLenum) 0;
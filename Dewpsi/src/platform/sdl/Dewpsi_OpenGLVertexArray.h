@@ -22,9 +22,14 @@ namespace Dewpsi {
         {
             return m_IndexBuffer;
         }
+        virtual PDuint GetRendererID() const override
+        {
+            return m_ArrayID;
+        }
 
     private:
         PDuint32 m_ArrayID;
+        PDuint32 m_AttribIndex = 0;
         std::vector<Ref<VertexBuffer>> m_VertexBuffers;
         Ref<IndexBuffer> m_IndexBuffer;
     };
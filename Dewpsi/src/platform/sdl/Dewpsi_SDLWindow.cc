@@ -10,6 +10,8 @@
 #include "Dewpsi_Debug.h"
 #include "Dewpsi_Except.h"
 #include "Dewpsi_OpenGLContext.h"
+#include "Dewpsi_RendererAPI.h"
+#include "Dewpsi_RenderThread.h"
 
 #include <SDL.h>
 #include <csignal>
@@ -63,10 +65,15 @@ SDL2Window::~SDL2Window()
 
 void SDL2Window::OnUpdate()
 {
-    SDL_PumpEvents();
+    PollEvents();
     m_Context->SwapBuffers();
 }
 
+void SDL2Window::PollEvents()
+{
+    SDL_PumpEvents();
+}
+
 bool SDL2Window::IsValid() const
 {
     return ((m_Window != nullptr) && m_Context);
@@ -74,10 +81,13 @@ bool SDL2Window::IsValid() const
 
 void SDL2Window::SetVSync(bool bEnable)
 {
-    if (bEnable)
-        SDL_GL_SetSwapInterval(1);
-    else
-        SDL_GL_SetSwapInterval(0);
+    // The swap interval belongs to the context, which may be current on the render thread
+    RenderThread::Enqueue([bEnable]{
+        if (bEnable)
+            SDL_GL_SetSwapInterval(1);
+        else
+            SDL_GL_SetSwapInterval(0);
+    });
 
     m_data.vsync = bEnable;
 }
@@ -97,6 +107,11 @@ void SDL2Window::Init(const WindowProps& props)
 
     m_data = props;
 
+    // Without a GPU API there is nothing to show; use SDL's dummy video driver so no display is needed
+    const bool bHeadless = (RendererAPI::GetAPI() != RendererAPI::API::OpenGL);
+    if (bHeadless)
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+
     // initialize SDL2 video
     if (SDL_Init(uiSDLFlags) != 0)
     {
@@ -183,6 +198,8 @@ void SDL2Window::Init(const WindowProps& props)
                 uiFlags |= *itrSDLFlag;
             ++itrSDLFlag;
         }
+        if (bHeadless)
+            uiFlags &= ~(SDL_WINDOW_OPENGL | SDL_WINDOW_VULKAN);
 
         // create a window (SDL_WINDOWPOS_CENTERED = center)
         m_Window = SDL_CreateWindow(props.title.c_str(), props.x, props.y,
@@ -214,7 +231,7 @@ void SDL2Window::Init(const WindowProps& props)
     }
 
     // enable vsync
-    if (m_data.vsync)
+    if (m_data.vsync && ! bHeadless)
     {
         if (props.flags & WindowOpenGL)
             SDL_GL_SetSwapInterval(1);
@@ -227,7 +244,8 @@ void SDL2Window::Init(const WindowProps& props)
         int w, h;
         SDL_GetWindowSize(m_Window, &w, &h);
         PD_CORE_ASSERT(w && h, "Failed to get window size: {0}", SDL_GetError());
-        glViewport(0, 0, w, h);
+        if (! bHeadless)
+            glViewport(0, 0, w, h);
         m_data.width = w;
         m_data.height = h;
     }
@@ -264,7 +282,9 @@ int SDL2Window::OnEvent(void* udata, SDL_Event* event)
 {
     WindowData* const pWinData = reinterpret_cast<WindowData*>(udata);
 
-    ImGui_ImplSDL2_ProcessEvent(event);
+    // There is no ImGui context with the null API
+    if (ImGui::GetCurrentContext())
+        ImGui_ImplSDL2_ProcessEvent(event);
 
     switch (event->type)
     {
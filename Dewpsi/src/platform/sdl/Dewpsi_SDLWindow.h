@@ -45,6 +45,15 @@ namespace Dewpsi {
         /// Update the SDL2 window.
         virtual void OnUpdate() override;
 
+        /// Pumps the SDL event queue.
+        virtual void PollEvents() override;
+
+        /// Returns the rendering context of the window.
+        virtual RenderContext& GetContext() override
+        {
+            return *m_Context;
+        }
+
         /// Returns true if the window is valid, false otherwise.
         virtual bool IsValid() const override;
 
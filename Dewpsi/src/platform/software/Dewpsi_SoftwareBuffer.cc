@@ -0,0 +1,80 @@
+#include "Dewpsi_SoftwareBuffer.h"
+#include "Dewpsi_Log.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Dewpsi {
+
+// ==============================================
+// Vertex buffer
+// ==============================================
+
+SoftwareVertexBuffer::SoftwareVertexBuffer(PDsizei size, const PDfloat* data)
+{
+    m_Storage.resize(size);
+    if (data)
+        std::memcpy(m_Storage.data(), data, size);
+}
+
+SoftwareVertexBuffer::SoftwareVertexBuffer(PDsizei size)
+{
+    m_Storage.resize(size);
+}
+
+void SoftwareVertexBuffer::SetData(const void* data, PDsizei size)
+{
+    PD_CORE_ASSERT(size <= m_Storage.size(), "Data is larger than the buffer");
+    std::memcpy(m_Storage.data(), data, std::min(size, m_Storage.size()));
+}
+
+// ==============================================
+// Stream buffer
+// ==============================================
+
+SoftwareStreamBuffer::SoftwareStreamBuffer(PDsizei regionSize, PDuint regionCount)
+    : m_RegionSize(regionSize), m_RegionCount(regionCount), m_Region(0), m_Cursor(0),
+      m_MappedOffset(0)
+{
+    PD_CORE_ASSERT(regionSize && regionCount, "Stream buffer cannot be empty");
+    m_Storage.resize(regionSize * regionCount);
+}
+
+void SoftwareStreamBuffer::SetData(const void* data, PDsizei size)
+{
+    void* dst = Map(size);
+    PD_CORE_ASSERT(dst, "Stream buffer region is full");
+    if (dst)
+        std::memcpy(dst, data, size);
+}
+
+void* SoftwareStreamBuffer::Map(PDsizei size, PDsizei alignment)
+{
+    PDsizei szCursor = m_Cursor;
+    if (alignment > 1)
+        szCursor = (szCursor + alignment - 1) / alignment * alignment;
+    if (szCursor + size > m_RegionSize)
+        return nullptr;
+
+    m_MappedOffset = m_Region * m_RegionSize + szCursor;
+    m_Cursor = szCursor + size;
+    return m_Storage.data() + m_MappedOffset;
+}
+
+void SoftwareStreamBuffer::NextFrame()
+{
+    m_Region = (m_Region + 1) % m_RegionCount;
+    m_Cursor = 0;
+}
+
+// ==============================================
+// Index buffer
+// ==============================================
+
+SoftwareIndexBuffer::SoftwareIndexBuffer(PDsizei count, const void* data, IndexType type)
+    : m_Storage(count * IndexTypeSize(type)), m_Count((PDuint32) count), m_Type(type)
+{
+    if (data)
+        std::memcpy(m_Storage.data(), data, m_Storage.size());
+}
+
+}
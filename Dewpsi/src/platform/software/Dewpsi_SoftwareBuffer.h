@@ -0,0 +1,99 @@
+#ifndef DEWPSI_SOFTWAREBUFFER_H
+#define DEWPSI_SOFTWAREBUFFER_H
+
+#include <Dewpsi_Buffer.h>
+#include <vector>
+
+namespace Dewpsi {
+    /// System memory the vertex stage of the software API reads vertices from.
+    class SoftwareBufferStorage {
+    public:
+        const PDuchar* GetStorage() const {return m_Storage.data();}
+        PDsizei GetStorageSize() const {return m_Storage.size();}
+
+    protected:
+        std::vector<PDuchar> m_Storage;
+    };
+
+    class SoftwareVertexBuffer : public VertexBuffer, public SoftwareBufferStorage {
+    public:
+        SoftwareVertexBuffer(PDsizei size, const PDfloat* data);
+        explicit SoftwareVertexBuffer(PDsizei size);
+        virtual ~SoftwareVertexBuffer() = default;
+
+        virtual void Bind() const override {}
+        virtual void UnBind() const override {}
+        virtual void SetData(const void* data, PDsizei size) override;
+
+        virtual const BufferLayout& GetLayout() const override
+        {
+            return m_Layout;
+        }
+        virtual void SetLayout(const BufferLayout& layout) override
+        {
+            m_Layout = layout;
+        }
+
+    private:
+        BufferLayout m_Layout;
+    };
+
+    /*
+    Stream buffer of the software API. Vertices are read by the time a draw call returns, so the
+    regions only exist to keep the offsets returned by GetMappedOffset() the same as other APIs.
+    */
+    class SoftwareStreamBuffer : public StreamBuffer, public SoftwareBufferStorage {
+    public:
+        SoftwareStreamBuffer(PDsizei regionSize, PDuint regionCount);
+        virtual ~SoftwareStreamBuffer() = default;
+
+        virtual void Bind() const override {}
+        virtual void UnBind() const override {}
+        virtual void SetData(const void* data, PDsizei size) override;
+
+        virtual const BufferLayout& GetLayout() const override
+        {
+            return m_Layout;
+        }
+        virtual void SetLayout(const BufferLayout& layout) override
+        {
+            m_Layout = layout;
+        }
+
+        virtual void* Map(PDsizei size, PDsizei alignment = 1) override;
+        virtual void Unmap() override {}
+        virtual PDsizei GetMappedOffset() const override {return m_MappedOffset;}
+        virtual void NextFrame() override;
+        virtual PDsizei GetRegionSize() const override {return m_RegionSize;}
+        virtual PDuint GetRegionCount() const override {return m_RegionCount;}
+
+    private:
+        PDsizei m_RegionSize;
+        PDuint m_RegionCount;
+        PDuint m_Region;
+        PDsizei m_Cursor;
+        PDsizei m_MappedOffset;
+        BufferLayout m_Layout;
+    };
+
+    class SoftwareIndexBuffer : public IndexBuffer {
+    public:
+        SoftwareIndexBuffer(PDsizei count, const void* data, IndexType type);
+        virtual ~SoftwareIndexBuffer() = default;
+
+        virtual void Bind() const override {}
+        virtual void UnBind() const override {}
+        virtual PDuint32 GetCount() const override {return m_Count;}
+        virtual IndexType GetIndexType() const override {return m_Type;}
+
+        /// Returns the indices, GetCount() values of GetIndexType().
+        const void* GetIndices() const {return m_Storage.data();}
+
+    private:
+        std::vector<PDuchar> m_Storage;
+        PDuint32 m_Count;
+        IndexType m_Type;
+    };
+}
+
+#endif /* DEWPSI_SOFTWAREBUFFER_H */
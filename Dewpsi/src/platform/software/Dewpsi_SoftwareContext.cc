@@ -0,0 +1,35 @@
+#include "Dewpsi_SoftwareContext.h"
+#include "Dewpsi_SoftwareRendererAPI.h"
+#include "Dewpsi_FrameCapture.h"
+#include <cstring>
+
+namespace Dewpsi {
+
+int SoftwareContext::Init()
+{
+    int iWidth, iHeight;
+    SDL_GetWindowSize(m_WindowHandle, &iWidth, &iHeight);
+    if (iWidth > 0 && iHeight > 0)
+        SoftwareRendererAPI::SetFramebufferSize((PDuint) iWidth, (PDuint) iHeight);
+    return PD_OKAY;
+}
+
+void SoftwareContext::SwapBuffers()
+{
+    SoftwareRendererAPI::Flush();
+
+    // The framebuffer is in memory already, so captures are copied right away
+    std::vector<FrameCapture::Target> targets;
+    if (FrameCapture::TakeTargets(targets))
+    {
+        std::vector<PDuint32> pixels;
+        SoftwareRendererAPI::ReadPixels(pixels);
+
+        std::vector<PDuchar> bytes(pixels.size() * 4);
+        std::memcpy(bytes.data(), pixels.data(), bytes.size());
+        FrameCapture::Submit(PD_MOVE(targets), SoftwareRendererAPI::GetFramebufferWidth(),
+            SoftwareRendererAPI::GetFramebufferHeight(), PD_MOVE(bytes));
+    }
+}
+
+}
@@ -0,0 +1,27 @@
+#ifndef DEWPSI_SOFTWARECONTEXT_H
+#define DEWPSI_SOFTWARECONTEXT_H
+
+#include <Dewpsi_Core.h>
+#include <Dewpsi_RenderContext.h>
+#include <SDL.h>
+
+namespace Dewpsi {
+    /// Context of the software API; the framebuffer stays in memory, so presenting only finishes it.
+    class SoftwareContext : public RenderContext {
+    public:
+        explicit SoftwareContext(SDL_Window* windowHandle) : m_WindowHandle(windowHandle) {}
+        virtual ~SoftwareContext() = default;
+
+        virtual int Init() override;
+        virtual void SwapBuffers() override;
+
+        // The framebuffer is plain memory, which any thread may draw into
+        virtual void MakeCurrent() override {}
+        virtual void ReleaseCurrent() override {}
+
+    private:
+        SDL_Window* m_WindowHandle;
+    };
+}
+
+#endif /* DEWPSI_SOFTWARECONTEXT_H */
@@ -0,0 +1,496 @@
+#include "Dewpsi_SoftwareRasterizer.h"
+#include "Dewpsi_Log.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef __SSE2__
+    #include <emmintrin.h>
+    #define PD_SOFTWARE_SSE2
+#endif
+
+// GCC and Clang can compile AVX2 functions without enabling AVX2 for the whole library
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+    #define PD_SOFTWARE_AVX2
+#endif
+
+namespace Dewpsi {
+
+typedef SoftwareRasterizer::Triangle Triangle;
+
+// Room for the edge functions of one row of a tile, plus the lanes past its end
+static constexpr PDuint _EdgeSpan = SoftwareRasterizer::TileSize + 8;
+
+/* Finds the pixels of row y in [x0, x1] that are inside a triangle, at most 64 of them; bit i of
+   the result is pixel x0 + i. The edge functions opposite vertices 1 and 2 are stored for every
+   pixel in edges[0] and edges[1], for the barycentrics. */
+typedef PDuint64 (*CoverageFunction)(const Triangle& tri, int y, int x0, int x1, float (*edges)[_EdgeSpan]);
+
+static inline PDuint32 PackColor(const float* color)
+{
+    PDuint32 uColor = 0;
+    for (PDuint i = 0; i < 4; ++i)
+    {
+        const float fValue = std::min(std::max(color[i], 0.0f), 1.0f);
+        uColor |= (PDuint32) (fValue * 255.0f + 0.5f) << (i * 8);
+    }
+    return uColor;
+}
+
+static inline void UnpackColor(PDuint32 color, float* out)
+{
+    for (PDuint i = 0; i < 4; ++i)
+        out[i] = ((color >> (i * 8)) & 0xff) * (1.0f / 255.0f);
+}
+
+// Wraps a texture coordinate into [0, 1) for repeating textures
+static inline float Wrap(float coord)
+{
+    const float fWrapped = coord - std::floor(coord);
+    return (fWrapped < 1.0f) ? fWrapped : 0.0f;
+}
+
+static void Sample(const SoftwareImage& image, float u, float v, float* out)
+{
+    // An unbound slot reads like an incomplete texture in OpenGL
+    if (! image.pixels || ! image.width || ! image.height)
+    {
+        out[0] = out[1] = out[2] = 0.0f;
+        out[3] = 1.0f;
+        return;
+    }
+
+    const PDuint32* uipTexels = image.pixels->data();
+    const int iWidth = (int) image.width;
+    const int iHeight = (int) image.height;
+    const float fX = Wrap(u) * iWidth;
+    const float fY = Wrap(v) * iHeight;
+
+    if (! image.bilinear)
+    {
+        const int iX = std::min((int) fX, iWidth - 1);
+        const int iY = std::min((int) fY, iHeight - 1);
+        UnpackColor(uipTexels[iY * iWidth + iX], out);
+        return;
+    }
+
+    // Texel centers are at half coordinates; neighbours wrap around the edges
+    const float fLeft = fX - 0.5f;
+    const float fBottom = fY - 0.5f;
+    const float fLeftFloor = std::floor(fLeft);
+    const float fBottomFloor = std::floor(fBottom);
+    const float fFracX = fLeft - fLeftFloor;
+    const float fFracY = fBottom - fBottomFloor;
+
+    const int iX0 = ((int) fLeftFloor + iWidth) % iWidth;
+    const int iY0 = ((int) fBottomFloor + iHeight) % iHeight;
+    const int iX1 = (iX0 + 1) % iWidth;
+    const int iY1 = (iY0 + 1) % iHeight;
+
+    float f00[4], f10[4], f01[4], f11[4];
+    UnpackColor(uipTexels[iY0 * iWidth + iX0], f00);
+    UnpackColor(uipTexels[iY0 * iWidth + iX1], f10);
+    UnpackColor(uipTexels[iY1 * iWidth + iX0], f01);
+    UnpackColor(uipTexels[iY1 * iWidth + iX1], f11);
+
+    for (PDuint i = 0; i < 4; ++i)
+    {
+        const float fBottomRow = f00[i] + (f10[i] - f00[i]) * fFracX;
+        const float fTopRow = f01[i] + (f11[i] - f01[i]) * fFracX;
+        out[i] = fBottomRow + (fTopRow - fBottomRow) * fFracY;
+    }
+}
+
+// Interpolates the vertex attributes at a pixel and blends the result into it
+static void ShadePixel(const Triangle& tri, const SoftwareDrawState& state, PDuint32* pixel, float e1, float e2)
+{
+    float fL1 = e1 * tri.invArea;
+    float fL2 = e2 * tri.invArea;
+    if (tri.perspective)
+    {
+        const float fW0 = (1.0f - fL1 - fL2) * tri.v[0].invW;
+        const float fW1 = fL1 * tri.v[1].invW;
+        const float fW2 = fL2 * tri.v[2].invW;
+        const float fInvSum = 1.0f / (fW0 + fW1 + fW2);
+        fL1 = fW1 * fInvSum;
+        fL2 = fW2 * fInvSum;
+    }
+
+    // Relative to the first vertex, so attributes that are the same at every vertex stay exact
+    const SoftwareVertex& v0 = tri.v[0];
+    const SoftwareVertex& v1 = tri.v[1];
+    const SoftwareVertex& v2 = tri.v[2];
+    float fColor[4];
+    for (PDuint i = 0; i < 4; ++i)
+        fColor[i] = v0.color[i] + (v1.color[i] - v0.color[i]) * fL1 + (v2.color[i] - v0.color[i]) * fL2;
+
+    if (state.textured)
+    {
+        const float fU = v0.uv[0] + (v1.uv[0] - v0.uv[0]) * fL1 + (v2.uv[0] - v0.uv[0]) * fL2;
+        const float fV = v0.uv[1] + (v1.uv[1] - v0.uv[1]) * fL1 + (v2.uv[1] - v0.uv[1]) * fL2;
+
+        float fTexel[4];
+        Sample(state.images[v2.slot], fU, fV, fTexel);
+        for (PDuint i = 0; i < 4; ++i)
+            fColor[i] *= fTexel[i];
+    }
+
+    // Same blending as the OpenGL API: source alpha, one minus source alpha, on every channel
+    const float fAlpha = std::min(std::max(fColor[3], 0.0f), 1.0f);
+    if (fAlpha >= 1.0f)
+    {
+        *pixel = PackColor(fColor);
+        return;
+    }
+    if (fAlpha <= 0.0f)
+        return;
+
+    float fDest[4];
+    UnpackColor(*pixel, fDest);
+    for (PDuint i = 0; i < 4; ++i)
+        fColor[i] = fColor[i] * fAlpha + fDest[i] * (1.0f - fAlpha);
+    *pixel = PackColor(fColor);
+}
+
+static inline bool IsInside(float edge, bool topLeft)
+{
+    return edge > 0.0f || (edge == 0.0f && topLeft);
+}
+
+// Clears the bits of the lanes past the end of the row
+static inline PDuint64 MaskRow(PDuint64 coverage, int x0, int x1)
+{
+    const int iCount = x1 - x0 + 1;
+    return (iCount < 64) ? coverage & ((1ull << iCount) - 1) : coverage;
+}
+
+/* Every path evaluates an edge as a * (x + 0.5) + (b * (y + 0.5) + c), never incrementally. The
+   neighbour of a shared edge has the same coefficients negated, so it computes exactly the
+   negated value and the top-left rule gives each pixel to one of the two triangles. */
+static PDuint64 CoverScalar(const Triangle& tri, int y, int x0, int x1, float (*edges)[_EdgeSpan])
+{
+    const float fY = y + 0.5f;
+    float fRow[3];
+    for (PDuint i = 0; i < 3; ++i)
+        fRow[i] = tri.b[i] * fY + tri.c[i];
+
+    PDuint64 uCoverage = 0;
+    for (int x = x0; x <= x1; ++x)
+    {
+        const float fX = x + 0.5f;
+        const float fE0 = tri.a[0] * fX + fRow[0];
+        const float fE1 = tri.a[1] * fX + fRow[1];
+        const float fE2 = tri.a[2] * fX + fRow[2];
+        edges[0][x - x0] = fE1;
+        edges[1][x - x0] = fE2;
+        if (IsInside(fE0, tri.topLeft[0]) && IsInside(fE1, tri.topLeft[1]) && IsInside(fE2, tri.topLeft[2]))
+            uCoverage |= 1ull << (x - x0);
+    }
+    return uCoverage;
+}
+
+#ifdef PD_SOFTWARE_SSE2
+static PDuint64 CoverSSE2(const Triangle& tri, int y, int x0, int x1, float (*edges)[_EdgeSpan])
+{
+    const float fY = y + 0.5f;
+    const __m128 vZero = _mm_setzero_ps();
+    const __m128 vLanes = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+    __m128 vA[3], vRow[3], vTopLeft[3];
+    for (PDuint i = 0; i < 3; ++i)
+    {
+        vA[i] = _mm_set1_ps(tri.a[i]);
+        vRow[i] = _mm_set1_ps(tri.b[i] * fY + tri.c[i]);
+        vTopLeft[i] = _mm_castsi128_ps(_mm_set1_epi32(tri.topLeft[i] ? -1 : 0));
+    }
+
+    PDuint64 uCoverage = 0;
+    for (int x = x0; x <= x1; x += 4)
+    {
+        const __m128 vX = _mm_add_ps(_mm_set1_ps((float) x), vLanes);
+        __m128 vInside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        __m128 vEdge[3];
+        for (PDuint i = 0; i < 3; ++i)
+        {
+            vEdge[i] = _mm_add_ps(_mm_mul_ps(vA[i], vX), vRow[i]);
+            const __m128 vOnEdge = _mm_and_ps(_mm_cmpeq_ps(vEdge[i], vZero), vTopLeft[i]);
+            vInside = _mm_and_ps(vInside, _mm_or_ps(_mm_cmpgt_ps(vEdge[i], vZero), vOnEdge));
+        }
+
+        _mm_storeu_ps(edges[0] + (x - x0), vEdge[1]);
+        _mm_storeu_ps(edges[1] + (x - x0), vEdge[2]);
+        uCoverage |= (PDuint64) _mm_movemask_ps(vInside) << (x - x0);
+    }
+    return MaskRow(uCoverage, x0, x1);
+}
+#endif
+
+#ifdef PD_SOFTWARE_AVX2
+// Returns before any pixel is shaded, so the shading code never runs with the upper halves dirty
+__attribute__((target("avx2")))
+static PDuint64 CoverAVX2(const Triangle& tri, int y, int x0, int x1, float (*edges)[_EdgeSpan])
+{
+    const float fY = y + 0.5f;
+    const __m256 vZero = _mm256_setzero_ps();
+    const __m256 vLanes = _mm256_set_ps(7.5f, 6.5f, 5.5f, 4.5f, 3.5f, 2.5f, 1.5f, 0.5f);
+    __m256 vA[3], vRow[3], vTopLeft[3];
+    for (PDuint i = 0; i < 3; ++i)
+    {
+        vA[i] = _mm256_set1_ps(tri.a[i]);
+        vRow[i] = _mm256_set1_ps(tri.b[i] * fY + tri.c[i]);
+        vTopLeft[i] = _mm256_castsi256_ps(_mm256_set1_epi32(tri.topLeft[i] ? -1 : 0));
+    }
+
+    PDuint64 uCoverage = 0;
+    for (int x = x0; x <= x1; x += 8)
+    {
+        const __m256 vX = _mm256_add_ps(_mm256_set1_ps((float) x), vLanes);
+        __m256 vInside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        __m256 vEdge[3];
+        for (PDuint i = 0; i < 3; ++i)
+        {
+            vEdge[i] = _mm256_add_ps(_mm256_mul_ps(vA[i], vX), vRow[i]);
+            const __m256 vOnEdge = _mm256_and_ps(_mm256_cmp_ps(vEdge[i], vZero, _CMP_EQ_OQ), vTopLeft[i]);
+            vInside = _mm256_and_ps(vInside, _mm256_or_ps(_mm256_cmp_ps(vEdge[i], vZero, _CMP_GT_OQ), vOnEdge));
+        }
+
+        _mm256_storeu_ps(edges[0] + (x - x0), vEdge[1]);
+        _mm256_storeu_ps(edges[1] + (x - x0), vEdge[2]);
+        uCoverage |= (PDuint64) _mm256_movemask_ps(vInside) << (x - x0);
+    }
+    return MaskRow(uCoverage, x0, x1);
+}
+#endif
+
+static CoverageFunction _Cover = nullptr;
+static const char* _InstructionSet = "scalar";
+
+static void SelectCoverageFunction()
+{
+    if (_Cover)
+        return;
+
+    _Cover = CoverScalar;
+#ifdef PD_SOFTWARE_SSE2
+    _Cover = CoverSSE2;
+    _InstructionSet = "SSE2";
+#endif
+#ifdef PD_SOFTWARE_AVX2
+    if (__builtin_cpu_supports("avx2"))
+    {
+        _Cover = CoverAVX2;
+        _InstructionSet = "AVX2";
+    }
+#endif
+}
+
+// Edge from p to q, positive on its left, which is the inside of a counter-clockwise triangle
+static void SetupEdge(Triangle& tri, PDuint edge, const SoftwareVertex& p, const SoftwareVertex& q)
+{
+    tri.a[edge] = p.y - q.y;
+    tri.b[edge] = q.x - p.x;
+    tri.c[edge] = p.x * q.y - p.y * q.x;
+
+    // The edge owns its pixels if the inside is to its right (a left edge) or below it (a top edge)
+    tri.topLeft[edge] = tri.a[edge] > 0.0f || (tri.a[edge] == 0.0f && tri.b[edge] < 0.0f);
+}
+
+SoftwareRasterizer::SoftwareRasterizer(PDuint threadCount)
+    : m_Width(0), m_Height(0), m_TilesX(0), m_TilesY(0), m_NextTile(0), m_Generation(0),
+      m_Busy(0), m_Stop(false)
+{
+    SelectCoverageFunction();
+    for (PDuint i = 1; i < threadCount; ++i)
+        m_Workers.emplace_back(&SoftwareRasterizer::WorkerThread, this);
+}
+
+SoftwareRasterizer::~SoftwareRasterizer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_Wake.notify_all();
+
+    for (std::thread& worker : m_Workers)
+        worker.join();
+}
+
+const char* SoftwareRasterizer::GetInstructionSet()
+{
+    SelectCoverageFunction();
+    return _InstructionSet;
+}
+
+void SoftwareRasterizer::Resize(PDuint width, PDuint height)
+{
+    if (width == m_Width && height == m_Height)
+        return;
+
+    // The bins refer to tiles of the old size
+    Flush();
+
+    m_Width = width;
+    m_Height = height;
+    m_TilesX = (width + TileSize - 1) / TileSize;
+    m_TilesY = (height + TileSize - 1) / TileSize;
+    m_Pixels.assign((PDsizei) width * height, 0);
+    m_Bins.assign((PDsizei) m_TilesX * m_TilesY, {});
+}
+
+void SoftwareRasterizer::Clear(PDuint32 color)
+{
+    Flush();
+    std::fill(m_Pixels.begin(), m_Pixels.end(), color);
+}
+
+void SoftwareRasterizer::SetDrawState(SoftwareDrawState&& state)
+{
+    m_States.push_back(PD_MOVE(state));
+}
+
+void SoftwareRasterizer::AddTriangle(const SoftwareVertex& v0, const SoftwareVertex& v1,
+    const SoftwareVertex& v2)
+{
+    PD_CORE_ASSERT(! m_States.empty(), "Triangle added without a draw state");
+
+    Triangle tri;
+    tri.v[0] = v0;
+    tri.v[1] = v1;
+    tri.v[2] = v2;
+
+    // Both windings are drawn; clockwise triangles are flipped, keeping the last vertex
+    float fArea = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+    if (fArea < 0.0f)
+    {
+        std::swap(tri.v[0], tri.v[1]);
+        fArea = -fArea;
+    }
+
+    // Also rejects NaN
+    if (! (fArea > 0.0f))
+        return;
+
+    const float fMinX = std::min({tri.v[0].x, tri.v[1].x, tri.v[2].x});
+    const float fMinY = std::min({tri.v[0].y, tri.v[1].y, tri.v[2].y});
+    const float fMaxX = std::max({tri.v[0].x, tri.v[1].x, tri.v[2].x});
+    const float fMaxY = std::max({tri.v[0].y, tri.v[1].y, tri.v[2].y});
+    if (fMaxX < 0.0f || fMaxY < 0.0f || fMinX >= (float) m_Width || fMinY >= (float) m_Height)
+        return;
+
+    tri.minX = (int) std::max(std::floor(fMinX), 0.0f);
+    tri.minY = (int) std::max(std::floor(fMinY), 0.0f);
+    tri.maxX = (int) std::min(std::ceil(fMaxX), (float) m_Width - 1);
+    tri.maxY = (int) std::min(std::ceil(fMaxY), (float) m_Height - 1);
+
+    SetupEdge(tri, 0, tri.v[1], tri.v[2]);
+    SetupEdge(tri, 1, tri.v[2], tri.v[0]);
+    SetupEdge(tri, 2, tri.v[0], tri.v[1]);
+    tri.invArea = 1.0f / fArea;
+    tri.perspective = tri.v[0].invW != tri.v[1].invW || tri.v[0].invW != tri.v[2].invW;
+    tri.state = (PDuint32) m_States.size() - 1;
+
+    const PDuint32 uIndex = (PDuint32) m_Triangles.size();
+    m_Triangles.push_back(tri);
+
+    for (PDuint ty = tri.minY / TileSize; ty <= (PDuint) tri.maxY / TileSize; ++ty)
+    {
+        for (PDuint tx = tri.minX / TileSize; tx <= (PDuint) tri.maxX / TileSize; ++tx)
+            m_Bins[ty * m_TilesX + tx].push_back(uIndex);
+    }
+}
+
+void SoftwareRasterizer::Flush()
+{
+    if (m_Triangles.empty())
+    {
+        m_States.clear();
+        return;
+    }
+
+    m_NextTile = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ++m_Generation;
+        m_Busy = (PDuint) m_Workers.size();
+    }
+    m_Wake.notify_all();
+
+    RasterizeTiles();
+
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Done.wait(lock, [this]{return m_Busy == 0;});
+    }
+
+    // The bins keep their capacity for the next frame
+    for (std::vector<PDuint32>& bin : m_Bins)
+        bin.clear();
+    m_Triangles.clear();
+    m_States.clear();
+}
+
+void SoftwareRasterizer::WorkerThread()
+{
+    PDuint64 uSeen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Wake.wait(lock, [&]{return m_Stop || m_Generation != uSeen;});
+            if (m_Stop)
+                return;
+            uSeen = m_Generation;
+        }
+
+        RasterizeTiles();
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            --m_Busy;
+        }
+        m_Done.notify_one();
+    }
+}
+
+void SoftwareRasterizer::RasterizeTiles()
+{
+    const PDuint uCount = m_TilesX * m_TilesY;
+    for (PDuint uTile = m_NextTile++; uTile < uCount; uTile = m_NextTile++)
+        RasterizeTile(uTile);
+}
+
+void SoftwareRasterizer::RasterizeTile(PDuint tile)
+{
+    const std::vector<PDuint32>& bin = m_Bins[tile];
+    if (bin.empty())
+        return;
+
+    const int iTileX = (int) ((tile % m_TilesX) * TileSize);
+    const int iTileY = (int) ((tile / m_TilesX) * TileSize);
+    const int iTileMaxX = std::min(iTileX + (int) TileSize, (int) m_Width) - 1;
+    const int iTileMaxY = std::min(iTileY + (int) TileSize, (int) m_Height) - 1;
+
+    alignas(32) float fEdges[2][_EdgeSpan];
+    for (PDuint32 uIndex : bin)
+    {
+        const Triangle& tri = m_Triangles[uIndex];
+        const SoftwareDrawState& state = m_States[tri.state];
+        const int iMinX = std::max(tri.minX, iTileX);
+        const int iMaxX = std::min(tri.maxX, iTileMaxX);
+        const int iMaxY = std::min(tri.maxY, iTileMaxY);
+
+        for (int y = std::max(tri.minY, iTileY); y <= iMaxY; ++y)
+        {
+            PDuint64 uCoverage = _Cover(tri, y, iMinX, iMaxX, fEdges);
+            PDuint32* uipRow = m_Pixels.data() + (PDsizei) y * m_Width + iMinX;
+            while (uCoverage)
+            {
+                const PDuint uLane = (PDuint) __builtin_ctzll(uCoverage);
+                uCoverage &= uCoverage - 1;
+                ShadePixel(tri, state, uipRow + uLane, fEdges[0][uLane], fEdges[1][uLane]);
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,126 @@
+#ifndef DEWPSI_SOFTWARERASTERIZER_H
+#define DEWPSI_SOFTWARERASTERIZER_H
+
+#include <Dewpsi_Core.h>
+#include <Dewpsi_Memory.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Dewpsi {
+    /// A vertex after the vertex stage, in window coordinates.
+    struct SoftwareVertex {
+        float x, y;         ///< Window coordinates in pixels, origin at the bottom left
+        float invW;         ///< Reciprocal of the clip space w, for perspective-correct interpolation
+        float color[4];     ///< RGBA color, 0 to 1
+        float uv[2];        ///< Texture coordinates
+        PDuint slot;        ///< Texture slot sampled by the triangle; taken from its last vertex
+    };
+
+    /// Pixels of a texture as seen by one draw.
+    struct SoftwareImage {
+        Ref<const std::vector<PDuint32>> pixels; ///< RGBA8 pixels, bottom row first
+        PDuint width;
+        PDuint height;
+        bool bilinear;
+    };
+
+    /// Fragment stage of one draw.
+    struct SoftwareDrawState {
+        static constexpr PDuint MaxSlots = 16;
+
+        std::array<SoftwareImage, MaxSlots> images; ///< Textures bound when the draw was made
+        bool textured;                              ///< Multiply the color by a texture sample
+    };
+
+    /*
+    Tile-based rasterizer behind the software API. Triangles are set up and binned into 64x64 tiles
+    as they are submitted; Flush() rasterizes the tiles in parallel on a pool of worker threads and
+    the calling thread. Every tile draws its triangles in submission order, so blending matches a
+    GPU without any synchronization between tiles.
+
+    Edge functions are evaluated 8 pixels at a time with AVX2 where the CPU has it, 4 at a time with
+    SSE2 otherwise, and one at a time on other architectures. Pixels on an edge shared by two
+    triangles follow the top-left rule and are drawn once.
+
+    The framebuffer is RGBA8 with the red channel in the lowest byte, bottom row first.
+    */
+    class SoftwareRasterizer {
+    public:
+        static constexpr PDuint TileSize = 64;
+
+        explicit SoftwareRasterizer(PDuint threadCount);
+        ~SoftwareRasterizer();
+
+        SoftwareRasterizer(const SoftwareRasterizer&) = delete;
+        SoftwareRasterizer& operator=(const SoftwareRasterizer&) = delete;
+
+        /// Resizes the framebuffer; its contents are undefined until the next Clear().
+        void Resize(PDuint width, PDuint height);
+
+        /// Fills the framebuffer with @a color once the triangles submitted so far are drawn.
+        void Clear(PDuint32 color);
+
+        /// Adds the fragment stage of the following triangles.
+        void SetDrawState(SoftwareDrawState&& state);
+
+        /// Sets up and bins a triangle with the last draw state; zero-area triangles are dropped.
+        void AddTriangle(const SoftwareVertex& v0, const SoftwareVertex& v1, const SoftwareVertex& v2);
+
+        /// Draws every binned triangle and returns once the framebuffer is complete.
+        void Flush();
+
+        PDuint GetWidth() const {return m_Width;}
+        PDuint GetHeight() const {return m_Height;}
+
+        /// Returns the framebuffer; call Flush() first.
+        const PDuint32* GetPixels() const {return m_Pixels.data();}
+
+        /// Returns the number of threads rasterizing, including the one calling Flush().
+        PDuint GetThreadCount() const {return (PDuint) m_Workers.size() + 1;}
+
+        /// Returns the name of the instruction set the edge functions run on.
+        static const char* GetInstructionSet();
+
+        /// A triangle ready for rasterization.
+        struct Triangle {
+            float a[3], b[3], c[3];     // edge i, opposite vertex i, is a*x + b*y + c; positive inside
+            bool topLeft[3];            // edge i owns the pixels exactly on it
+            int minX, minY, maxX, maxY; // bounds, clamped to the framebuffer
+            float invArea;              // normalizes the edge functions into barycentrics
+            bool perspective;           // the vertices have different depths
+            PDuint32 state;
+            SoftwareVertex v[3];
+        };
+
+    private:
+        void WorkerThread();
+        void RasterizeTiles();
+        void RasterizeTile(PDuint tile);
+
+        std::vector<PDuint32> m_Pixels;
+        PDuint m_Width;
+        PDuint m_Height;
+        PDuint m_TilesX;
+        PDuint m_TilesY;
+
+        std::vector<Triangle> m_Triangles;
+        std::vector<SoftwareDrawState> m_States;
+        std::vector<std::vector<PDuint32>> m_Bins;
+
+        // Shared with the workers
+        std::vector<std::thread> m_Workers;
+        std::mutex m_Mutex;
+        std::condition_variable m_Wake;
+        std::condition_variable m_Done;
+        std::atomic<PDuint> m_NextTile;
+        PDuint64 m_Generation;
+        PDuint m_Busy;
+        bool m_Stop;
+    };
+}
+
+#endif /* DEWPSI_SOFTWARERASTERIZER_H */
@@ -0,0 +1,589 @@
+#include "Dewpsi_SoftwareRendererAPI.h"
+#include "Dewpsi_SoftwareRasterizer.h"
+#include "Dewpsi_SoftwareBuffer.h"
+#include "Dewpsi_SoftwareVertexArray.h"
+#include "Dewpsi_SoftwareShader.h"
+#include "Dewpsi_SoftwareTexture.h"
+#include "Dewpsi_SoftwareUniformBuffer.h"
+#include "Dewpsi_Renderer.h"
+#include "Dewpsi_Log.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace Dewpsi {
+
+// Uniform buffer binding points that can be bound
+static constexpr PDuint _MaxBindings = 16;
+
+// Used until the context reports the size of the window
+static constexpr PDuint _DefaultWidth = 1280;
+static constexpr PDuint _DefaultHeight = 720;
+
+static constexpr UniformId _ColorUniform("u_Color");
+static constexpr UniformId _TransformUniform("u_Transform");
+static constexpr UniformId _ViewProjectionUniform("u_ViewProjection");
+static constexpr UniformId _TexturesUniform("u_Textures");
+static constexpr UniformId _TextureUniform("u_Texture");
+
+static const float _Identity[16] = {
+    1.0f, 0.0f, 0.0f, 0.0f,
+    0.0f, 1.0f, 0.0f, 0.0f,
+    0.0f, 0.0f, 1.0f, 0.0f,
+    0.0f, 0.0f, 0.0f, 1.0f
+};
+
+// Attributes read by the built-in shader
+enum BuiltinAttribute {
+    AttribPosition,
+    AttribColor,
+    AttribTexCoord,
+    AttribTexIndex,
+    AttribTiling,
+    AttribTransform,
+    AttribOffset,
+    AttribScale,
+    AttribCount
+};
+
+// Where the vertex stage reads an attribute from
+struct AttributeSource {
+    const PDuchar* data;            // NULL if the layout does not have the attribute
+    PDsizei size;                   // size of the buffer in bytes
+    PDuint32 stride;
+    PDuint32 divisor;
+    const BufferElement* element;
+};
+
+// Everything the vertex stage of one draw needs
+struct VertexStage {
+    AttributeSource attributes[AttribCount];
+    float matrix[16];               // view projection times u_Transform
+    float color[4];                 // u_Color
+    const std::vector<float>* samplers; // u_Textures
+    PDuint textureSlot;             // u_Texture
+    PDuint width;
+    PDuint height;
+    PDuint32 baseInstance;
+};
+
+static Scope<SoftwareRasterizer> _Rasterizer;
+static PDuint _Width = _DefaultWidth;
+static PDuint _Height = _DefaultHeight;
+static PDuint32 _ClearColor = 0xff000000;
+
+static const SoftwareShader* _Shader = nullptr;
+static std::array<const SoftwareTexture2D*, SoftwareDrawState::MaxSlots> _Textures = {};
+static std::array<const SoftwareUniformBuffer*, _MaxBindings> _UniformBuffers = {};
+
+// Each index of a draw is transformed once per instance
+static std::vector<SoftwareVertex> _Vertices;
+static std::vector<PDuint32> _VertexStamps;
+static PDuint32 _Stamp = 0;
+
+static int FindAttribute(const PDstring& name)
+{
+    static const char* const szaNames[] = {"Position", "Color", "TexCoord", "TexIndex", "Tiling", "Transform",
+        "Offset", "Scale"};
+
+    const char* cpName = name.c_str();
+    if (! std::strncmp(cpName, "in_", 3))
+        cpName += 3;
+    else if (! std::strncmp(cpName, "a_", 2))
+        cpName += 2;
+
+    for (int i = 0; i < AttribCount; ++i)
+    {
+        if (! std::strcmp(cpName, szaNames[i]))
+            return i;
+    }
+    if (! std::strcmp(cpName, "TilingFactor"))
+        return AttribTiling;
+    return -1;
+}
+
+// IEEE 754 half precision to single precision, denormals, infinities and NaN included
+static float HalfToFloat(PDuint16 half)
+{
+    const PDuint32 uiSign = (PDuint32) (half & 0x8000) << 16;
+    const PDuint32 uiExponent = (half >> 10) & 0x1f;
+    const PDuint32 uiMantissa = half & 0x3ff;
+
+    if (uiExponent == 0)
+    {
+        const float fValue = (float) uiMantissa * (1.0f / 16777216.0f); // 2^-24
+        return uiSign ? -fValue : fValue;
+    }
+
+    PDuint32 uiBits = uiSign | (uiMantissa << 13);
+    uiBits |= (uiExponent == 0x1f) ? 0x7f800000u : (uiExponent + 112) << 23;
+    float fValue;
+    std::memcpy(&fValue, &uiBits, sizeof(fValue));
+    return fValue;
+}
+
+// Reads element @a index of an attribute as floats, like glVertexAttribPointer; returns the number of components
+static PDuint ReadAttribute(const AttributeSource& source, PDuint32 index, float* out)
+{
+    const BufferElement& element = *source.element;
+    const PDsizei szOffset = (PDsizei) index * source.stride + element.offset;
+    if (szOffset + element.size > source.size)
+        return 0;
+
+    const PDuchar* ucpData = source.data + szOffset;
+    const PDuint uCount = element.GetComponentCount();
+    switch (element.type)
+    {
+        case ShaderDataType::Int:
+        case ShaderDataType::Int2:
+        case ShaderDataType::Int3:
+        case ShaderDataType::Int4:
+            for (PDuint i = 0; i < uCount; ++i)
+            {
+                PDint32 iValue;
+                std::memcpy(&iValue, ucpData + i * sizeof(PDint32), sizeof(PDint32));
+                out[i] = element.normalized ? std::max(iValue / 2147483647.0f, -1.0f) : (float) iValue;
+            }
+            break;
+
+        case ShaderDataType::Bool:
+            out[0] = ucpData[0] ? 1.0f : 0.0f;
+            break;
+
+        case ShaderDataType::UByte4Norm:
+            for (PDuint i = 0; i < 4; ++i)
+                out[i] = ucpData[i] * (1.0f / 255.0f);
+            break;
+
+        case ShaderDataType::Short2Norm:
+            for (PDuint i = 0; i < 2; ++i)
+            {
+                PDint16 iValue;
+                std::memcpy(&iValue, ucpData + i * sizeof(PDint16), sizeof(PDint16));
+                out[i] = std::max(iValue / 32767.0f, -1.0f);
+            }
+            break;
+
+        case ShaderDataType::Half2:
+        case ShaderDataType::Half4:
+            for (PDuint i = 0; i < uCount; ++i)
+            {
+                PDuint16 usValue;
+                std::memcpy(&usValue, ucpData + i * sizeof(PDuint16), sizeof(PDuint16));
+                out[i] = HalfToFloat(usValue);
+            }
+            break;
+
+        case ShaderDataType::UInt10_10_10_2:
+        {
+            PDuint32 uiValue;
+            std::memcpy(&uiValue, ucpData, sizeof(PDuint32));
+            for (PDuint i = 0; i < 3; ++i)
+            {
+                const PDuint32 uiComponent = (uiValue >> (i * 10)) & 0x3ff;
+                out[i] = element.normalized ? uiComponent * (1.0f / 1023.0f) : (float) uiComponent;
+            }
+            out[3] = element.normalized ? (uiValue >> 30) * (1.0f / 3.0f) : (float) (uiValue >> 30);
+            break;
+        }
+
+        default:
+            std::memcpy(out, ucpData, uCount * sizeof(float));
+            break;
+    }
+
+    return uCount;
+}
+
+static PDuint FetchAttribute(const VertexStage& stage, PDuint attribute, PDuint32 index, PDuint32 instance,
+    float* out)
+{
+    const AttributeSource& source = stage.attributes[attribute];
+    if (! source.data)
+        return 0;
+    return ReadAttribute(source, source.divisor ? instance / source.divisor + stage.baseInstance : index, out);
+}
+
+// Column-major, like glm: out = a * b
+static void MultiplyMatrix(const float* a, const float* b, float* out)
+{
+    for (PDuint col = 0; col < 4; ++col)
+    {
+        for (PDuint row = 0; row < 4; ++row)
+        {
+            float fSum = 0.0f;
+            for (PDuint k = 0; k < 4; ++k)
+                fSum += a[k * 4 + row] * b[col * 4 + k];
+            out[col * 4 + row] = fSum;
+        }
+    }
+}
+
+static void TransformVector(const float* m, const float* v, float* out)
+{
+    for (PDuint row = 0; row < 4; ++row)
+        out[row] = m[row] * v[0] + m[4 + row] * v[1] + m[8 + row] * v[2] + m[12 + row] * v[3];
+}
+
+// The built-in vertex shader; see SoftwareShader
+static void RunVertexStage(const VertexStage& stage, PDuint32 index, PDuint32 instance, SoftwareVertex& out)
+{
+    // Large enough for any attribute; missing components default like in GLSL
+    float fPosition[16] = {0.0f, 0.0f, 0.0f, 1.0f};
+    float fColor[16] = {1.0f, 1.0f, 1.0f, 1.0f};
+    float fTexCoord[16] = {};
+    float fTiling[16] = {1.0f};
+    float fTexIndex[16] = {};
+    float fInstance[16];
+    float fOffset[16] = {};
+    float fScale[16] = {1.0f};
+
+    FetchAttribute(stage, AttribPosition, index, instance, fPosition);
+    FetchAttribute(stage, AttribColor, index, instance, fColor);
+    FetchAttribute(stage, AttribTexCoord, index, instance, fTexCoord);
+    FetchAttribute(stage, AttribTiling, index, instance, fTiling);
+
+    // Billboards such as particles: a unit quad scaled and moved per instance
+    const PDuint uScaled = FetchAttribute(stage, AttribScale, index, instance, fScale);
+    if (FetchAttribute(stage, AttribOffset, index, instance, fOffset) || uScaled)
+    {
+        for (PDuint i = 0; i < 3; ++i)
+            fPosition[i] = fPosition[i] * fScale[0] + fOffset[i];
+    }
+
+    float fWorld[4], fClip[4];
+    if (FetchAttribute(stage, AttribTransform, index, instance, fInstance) == 16)
+    {
+        TransformVector(fInstance, fPosition, fWorld);
+        TransformVector(stage.matrix, fWorld, fClip);
+    }
+    else
+        TransformVector(stage.matrix, fPosition, fClip);
+
+    // Nothing is clipped against the near plane; triangles behind the eye are dropped whole
+    if (fClip[3] > 1e-6f)
+    {
+        out.invW = 1.0f / fClip[3];
+        out.x = (fClip[0] * out.invW + 1.0f) * 0.5f * stage.width;
+        out.y = (fClip[1] * out.invW + 1.0f) * 0.5f * stage.height;
+    }
+    else
+        out.invW = out.x = out.y = 0.0f;
+
+    for (PDuint i = 0; i < 4; ++i)
+        out.color[i] = fColor[i] * stage.color[i];
+    out.uv[0] = fTexCoord[0] * fTiling[0];
+    out.uv[1] = fTexCoord[1] * fTiling[0];
+
+    PDuint uSlot = stage.textureSlot;
+    if (FetchAttribute(stage, AttribTexIndex, index, instance, fTexIndex))
+    {
+        const PDuint uIndex = (PDuint) std::max(fTexIndex[0], 0.0f);
+        uSlot = (stage.samplers && uIndex < stage.samplers->size()) ? (PDuint) (*stage.samplers)[uIndex] : uIndex;
+    }
+    out.slot = std::min(uSlot, SoftwareDrawState::MaxSlots - 1);
+}
+
+// Gathers the attributes and uniforms of a draw and hands the fragment state to the rasterizer
+static void SetupDraw(const SoftwareVertexArray* array, PDuint32 baseInstance, VertexStage& stage)
+{
+    stage = {};
+    stage.width = _Rasterizer->GetWidth();
+    stage.height = _Rasterizer->GetHeight();
+    stage.baseInstance = baseInstance;
+
+    // Attributes, by name
+    const std::vector<Ref<VertexBuffer>>& buffers = array->GetVertexBuffers();
+    for (PDsizei i = 0; i < buffers.size(); ++i)
+    {
+        const BufferLayout& layout = buffers[i]->GetLayout();
+        const SoftwareBufferStorage* storage = array->GetStorage()[i];
+        for (const BufferElement& element : layout)
+        {
+            const int iAttribute = FindAttribute(element.name);
+            if (iAttribute >= 0)
+            {
+                stage.attributes[iAttribute] = {storage->GetStorage(), storage->GetStorageSize(),
+                    layout.GetStride(), layout.GetDivisor(), &element};
+            }
+        }
+    }
+
+    // Uniforms; the camera comes from the uniform buffer unless the shader sets its own
+    float fViewProjection[16], fModel[16];
+    std::memcpy(fViewProjection, _Identity, sizeof(_Identity));
+    std::memcpy(fModel, _Identity, sizeof(_Identity));
+
+    const SoftwareUniformBuffer* camera = _UniformBuffers[Renderer::CameraBinding];
+    const std::vector<float>* values = _Shader->GetUniform(_ViewProjectionUniform);
+    if (values && values->size() >= 16)
+        std::memcpy(fViewProjection, values->data(), sizeof(fViewProjection));
+    else if (camera && camera->GetSize() >= sizeof(fViewProjection))
+        std::memcpy(fViewProjection, camera->GetData(), sizeof(fViewProjection));
+
+    values = _Shader->GetUniform(_TransformUniform);
+    if (values && values->size() >= 16)
+        std::memcpy(fModel, values->data(), sizeof(fModel));
+    MultiplyMatrix(fViewProjection, fModel, stage.matrix);
+
+    std::fill(stage.color, stage.color + 4, 1.0f);
+    values = _Shader->GetUniform(_ColorUniform);
+    if (values)
+        std::copy(values->begin(), values->begin() + std::min<PDsizei>(values->size(), 4), stage.color);
+
+    stage.samplers = _Shader->GetUniform(_TexturesUniform);
+    values = _Shader->GetUniform(_TextureUniform);
+    stage.textureSlot = (values && ! values->empty()) ? (PDuint) std::max((*values)[0], 0.0f) : 0;
+
+    // Fragment stage
+    SoftwareDrawState state;
+    state.textured = _Shader->IsTextured();
+    if (state.textured)
+    {
+        for (PDuint i = 0; i < SoftwareDrawState::MaxSlots; ++i)
+        {
+            if (_Textures[i])
+                state.images[i] = _Textures[i]->GetImage();
+        }
+    }
+    _Rasterizer->SetDrawState(PD_MOVE(state));
+}
+
+// Shades the vertices of @a count indices once per instance and rasterizes their triangles
+template<typename T>
+static void DrawTriangles(const VertexStage& stage, const T* indices, PDuint32 count, PDuint32 instanceCount)
+{
+    const PDuint32 uiMaxIndex = *std::max_element(indices, indices + count);
+    if (uiMaxIndex >= _Vertices.size())
+    {
+        _Vertices.resize((PDsizei) uiMaxIndex + 1);
+        _VertexStamps.resize((PDsizei) uiMaxIndex + 1, 0);
+    }
+
+    for (PDuint32 uiInstance = 0; uiInstance < instanceCount; ++uiInstance)
+    {
+        if (++_Stamp == 0)
+        {
+            std::fill(_VertexStamps.begin(), _VertexStamps.end(), 0);
+            _Stamp = 1;
+        }
+
+        for (PDuint32 i = 0; i < count; i += 3)
+        {
+            for (PDuint32 k = i; k < i + 3; ++k)
+            {
+                const PDuint32 uiIndex = indices[k];
+                if (_VertexStamps[uiIndex] != _Stamp)
+                {
+                    RunVertexStage(stage, uiIndex, uiInstance, _Vertices[uiIndex]);
+                    _VertexStamps[uiIndex] = _Stamp;
+                }
+            }
+
+            const SoftwareVertex& v0 = _Vertices[indices[i]];
+            const SoftwareVertex& v1 = _Vertices[indices[i + 1]];
+            const SoftwareVertex& v2 = _Vertices[indices[i + 2]];
+            if (v0.invW > 0.0f && v1.invW > 0.0f && v2.invW > 0.0f)
+                _Rasterizer->AddTriangle(v0, v1, v2);
+        }
+    }
+}
+
+void SoftwareRendererAPI::Init()
+{
+    const PDuint uThreads = std::min(std::max(std::thread::hardware_concurrency(), 1u), 16u);
+    _Rasterizer = CreateScope<SoftwareRasterizer>(uThreads);
+    _Rasterizer->Resize(_Width, _Height);
+    _Rasterizer->Clear(_ClearColor);
+
+    PD_CORE_TRACE("Initialized SoftwareRendererAPI: {0}x{1}, {2} threads, {3} edge functions",
+        _Width, _Height, uThreads, SoftwareRasterizer::GetInstructionSet());
+}
+
+void SoftwareRendererAPI::Shutdown()
+{
+    _Rasterizer.reset();
+    _Shader = nullptr;
+    _Textures.fill(nullptr);
+    _UniformBuffers.fill(nullptr);
+    _Vertices.clear();
+    _VertexStamps.clear();
+}
+
+void SoftwareRendererAPI::BeginFrame()
+{
+}
+
+void SoftwareRendererAPI::SetClearColor(const Color& color)
+{
+    m_ClearColor = color;
+    _ClearColor = (PDuint32) color.red | ((PDuint32) color.green << 8) | ((PDuint32) color.blue << 16)
+        | ((PDuint32) color.alpha << 24);
+}
+
+void SoftwareRendererAPI::Clear()
+{
+    _Rasterizer->Clear(_ClearColor);
+}
+
+void SoftwareRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, PDuint32 indexCount)
+{
+    DrawIndexedInstanced(vertexArray, 1, indexCount, 0);
+}
+
+void SoftwareRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, PDuint32 instanceCount,
+    PDuint32 indexCount, PDuint32 baseInstance)
+{
+    PD_CORE_ASSERT(_Shader, "No shader bound");
+    const SoftwareVertexArray* array = static_cast<const SoftwareVertexArray*>(vertexArray.get());
+    const SoftwareIndexBuffer* indexBuffer = static_cast<const SoftwareIndexBuffer*>(array->GetIndexBuffer().get());
+    if (! _Shader || ! indexBuffer)
+        return;
+
+    PDuint32 uiCount = indexCount ? std::min(indexCount, indexBuffer->GetCount()) : indexBuffer->GetCount();
+    uiCount -= uiCount % 3;
+    if (! uiCount || ! instanceCount)
+        return;
+
+    VertexStage stage;
+    SetupDraw(array, baseInstance, stage);
+
+    if (indexBuffer->GetIndexType() == IndexType::UInt16)
+        DrawTriangles(stage, static_cast<const PDuint16*>(indexBuffer->GetIndices()), uiCount, instanceCount);
+    else
+        DrawTriangles(stage, static_cast<const PDuint32*>(indexBuffer->GetIndices()), uiCount, instanceCount);
+}
+
+void SoftwareRendererAPI::DrawArrays(const Ref<VertexArray>& vertexArray, PDuint32 vertexCount, PrimitiveType type)
+{
+    PD_CORE_ASSERT(_Shader, "No shader bound");
+    if (! _Shader)
+        return;
+
+    const PDuint uPerPrimitive = (type == PrimitiveType::Lines) ? 2 : 3;
+    vertexCount -= vertexCount % uPerPrimitive;
+    if (! vertexCount)
+        return;
+
+    VertexStage stage;
+    SetupDraw(static_cast<const SoftwareVertexArray*>(vertexArray.get()), 0, stage);
+
+    SoftwareVertex vertices[3];
+    for (PDuint32 i = 0; i < vertexCount; i += uPerPrimitive)
+    {
+        for (PDuint k = 0; k < uPerPrimitive; ++k)
+            RunVertexStage(stage, i + k, 0, vertices[k]);
+        if (vertices[0].invW <= 0.0f || vertices[1].invW <= 0.0f)
+            continue;
+
+        if (type == PrimitiveType::Triangles)
+        {
+            if (vertices[2].invW > 0.0f)
+                _Rasterizer->AddTriangle(vertices[0], vertices[1], vertices[2]);
+            continue;
+        }
+
+        // A line is a quad one pixel wide around it
+        const float fDx = vertices[1].x - vertices[0].x, fDy = vertices[1].y - vertices[0].y;
+        const float fLength = std::sqrt(fDx * fDx + fDy * fDy);
+        if (fLength < 1e-6f)
+            continue;
+
+        const float fNx = -fDy / fLength * 0.5f, fNy = fDx / fLength * 0.5f;
+        SoftwareVertex corners[4] = {vertices[0], vertices[0], vertices[1], vertices[1]};
+        corners[0].x += fNx; corners[0].y += fNy;
+        corners[1].x -= fNx; corners[1].y -= fNy;
+        corners[2].x -= fNx; corners[2].y -= fNy;
+        corners[3].x += fNx; corners[3].y += fNy;
+        _Rasterizer->AddTriangle(corners[0], corners[1], corners[2]);
+        _Rasterizer->AddTriangle(corners[0], corners[2], corners[3]);
+    }
+}
+
+// There is no GPU to time; triangles are rasterized long after their pass ends
+void SoftwareRendererAPI::BeginPass(const char* name)
+{
+}
+
+void SoftwareRendererAPI::EndPass()
+{
+}
+
+void SoftwareRendererAPI::GetFrameStats(Statistics& stats)
+{
+}
+
+void SoftwareRendererAPI::SetFramebufferSize(PDuint width, PDuint height)
+{
+    PD_CORE_ASSERT(width && height, "Framebuffer cannot be empty");
+    _Width = width;
+    _Height = height;
+    if (_Rasterizer)
+        _Rasterizer->Resize(width, height);
+}
+
+PDuint SoftwareRendererAPI::GetFramebufferWidth()
+{
+    return _Width;
+}
+
+PDuint SoftwareRendererAPI::GetFramebufferHeight()
+{
+    return _Height;
+}
+
+void SoftwareRendererAPI::Flush()
+{
+    if (_Rasterizer)
+        _Rasterizer->Flush();
+}
+
+void SoftwareRendererAPI::ReadPixels(std::vector<PDuint32>& pixels)
+{
+    if (! _Rasterizer)
+    {
+        pixels.clear();
+        return;
+    }
+
+    _Rasterizer->Flush();
+    const PDuint32* uipPixels = _Rasterizer->GetPixels();
+    pixels.assign(uipPixels, uipPixels + (PDsizei) _Rasterizer->GetWidth() * _Rasterizer->GetHeight());
+}
+
+void SoftwareRendererAPI::BindShader(const SoftwareShader* shader)
+{
+    _Shader = shader;
+}
+
+void SoftwareRendererAPI::BindTexture(PDuint slot, const SoftwareTexture2D* texture)
+{
+    PD_CORE_ASSERT(slot < SoftwareDrawState::MaxSlots, "Texture slot {0} is out of range", slot);
+    if (slot < SoftwareDrawState::MaxSlots)
+        _Textures[slot] = texture;
+}
+
+void SoftwareRendererAPI::BindUniformBuffer(const SoftwareUniformBuffer* buffer)
+{
+    PD_CORE_ASSERT(buffer->GetBinding() < _MaxBindings, "Binding {0} is out of range", buffer->GetBinding());
+    if (buffer->GetBinding() < _MaxBindings)
+        _UniformBuffers[buffer->GetBinding()] = buffer;
+}
+
+void SoftwareRendererAPI::ForgetShader(const SoftwareShader* shader)
+{
+    if (_Shader == shader)
+        _Shader = nullptr;
+}
+
+void SoftwareRendererAPI::ForgetTexture(const SoftwareTexture2D* texture)
+{
+    std::replace(_Textures.begin(), _Textures.end(), texture, (const SoftwareTexture2D*) nullptr);
+}
+
+void SoftwareRendererAPI::ForgetUniformBuffer(const SoftwareUniformBuffer* buffer)
+{
+    std::replace(_UniformBuffers.begin(), _UniformBuffers.end(), buffer, (const SoftwareUniformBuffer*) nullptr);
+}
+
+}
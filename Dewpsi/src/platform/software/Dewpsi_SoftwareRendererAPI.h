@@ -0,0 +1,60 @@
+#ifndef DEWPSI_SOFTWARERENDERERAPI_H
+#define DEWPSI_SOFTWARERENDERERAPI_H
+
+#include <Dewpsi_RendererAPI.h>
+#include <vector>
+
+namespace Dewpsi {
+    class SoftwareShader;
+    class SoftwareTexture2D;
+    class SoftwareUniformBuffer;
+
+    /*
+    Rendering API that draws on the CPU into a framebuffer in system memory, for machines without
+    a GPU. Draw calls run the vertex stage right away, so buffers may be changed as soon as a draw
+    returns; the triangles are rasterized by SoftwareRasterizer when the frame is presented, the
+    framebuffer is read or cleared. See SoftwareShader for what the shaders do.
+
+    The framebuffer takes the size of the window, unless SetFramebufferSize() is called.
+    */
+    class SoftwareRendererAPI : public RendererAPI {
+    public:
+        virtual void Init() override;
+        virtual void Shutdown() override;
+        virtual void BeginFrame() override;
+        virtual void SetClearColor(const Color& color) override;
+        virtual void Clear() override;
+        virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, PDuint32 indexCount) override;
+        virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, PDuint32 instanceCount,
+            PDuint32 indexCount, PDuint32 baseInstance) override;
+        virtual void DrawArrays(const Ref<VertexArray>& vertexArray, PDuint32 vertexCount, PrimitiveType type) override;
+        virtual void BeginPass(const char* name) override;
+        virtual void EndPass() override;
+        virtual void GetFrameStats(Statistics& stats) override;
+
+        /// Resizes the framebuffer; its contents are undefined until it is cleared.
+        static void SetFramebufferSize(PDuint width, PDuint height);
+
+        static PDuint GetFramebufferWidth();
+        static PDuint GetFramebufferHeight();
+
+        /// Rasterizes every triangle drawn so far.
+        static void Flush();
+
+        /** Copies the framebuffer into @a pixels once every triangle drawn so far is rasterized.
+        *   Pixels are RGBA8 with the red channel in the lowest byte, bottom row first, like
+        *   @c glReadPixels with @c GL_RGBA and @c GL_UNSIGNED_BYTE.
+        */
+        static void ReadPixels(std::vector<PDuint32>& pixels);
+
+        // Binding points, set by the software objects
+        static void BindShader(const SoftwareShader* shader);
+        static void BindTexture(PDuint slot, const SoftwareTexture2D* texture);
+        static void BindUniformBuffer(const SoftwareUniformBuffer* buffer);
+        static void ForgetShader(const SoftwareShader* shader);
+        static void ForgetTexture(const SoftwareTexture2D* texture);
+        static void ForgetUniformBuffer(const SoftwareUniformBuffer* buffer);
+    };
+}
+
+#endif /* DEWPSI_SOFTWARERENDERERAPI_H */
@@ -0,0 +1,222 @@
+#include "Dewpsi_SoftwareShader.h"
+#include "Dewpsi_SoftwareRendererAPI.h"
+#include "Dewpsi_Log.h"
+#include <fstream>
+#include <sstream>
+
+namespace Dewpsi {
+
+// IDs only need to be distinct, for sort keys
+static PDuint32 _NextID = 1;
+
+static inline PDuint32 HashName(const PDstring& name)
+{
+    return String::Hash(name.c_str(), name.size());
+}
+
+SoftwareShader::SoftwareShader(const PDstring& vertSrc, const PDstring& fragSrc)
+    : m_ShaderID(_NextID++), m_Textured(false)
+{
+    m_Textured = fragSrc.find("sampler2D") != PDstring::npos;
+}
+
+SoftwareShader::SoftwareShader(const PDstring& file)
+    : m_ShaderID(_NextID++), m_Textured(false)
+{
+    std::ifstream in(file);
+    if (! in)
+    {
+        PD_CORE_ERROR("Could not open '{0}' for reading", file);
+        return;
+    }
+
+    std::stringstream ss;
+    ss << in.rdbuf();
+    m_Textured = ss.str().find("sampler2D") != PDstring::npos;
+}
+
+SoftwareShader::~SoftwareShader()
+{
+    SoftwareRendererAPI::ForgetShader(this);
+}
+
+bool SoftwareShader::Bind() const
+{
+    SoftwareRendererAPI::BindShader(this);
+    return true;
+}
+
+const std::vector<float>* SoftwareShader::GetUniform(UniformId id) const
+{
+    auto found = m_Uniforms.find(id.GetHash());
+    return (found != m_Uniforms.end()) ? &found->second : nullptr;
+}
+
+void SoftwareShader::SetValues(PDuint32 hash, std::initializer_list<float> values)
+{
+    m_Uniforms[hash].assign(values.begin(), values.end());
+}
+
+// ==============================================
+// Setters by name
+// ==============================================
+
+void SoftwareShader::SetInt1(const PDstring& name, PDint v0)
+{
+    SetValues(HashName(name), {(float) v0});
+}
+
+void SoftwareShader::SetInt2(const PDstring& name, PDint v1, PDint v2)
+{
+    SetValues(HashName(name), {(float) v1, (float) v2});
+}
+
+void SoftwareShader::SetInt3(const PDstring& name, PDint v1, PDint v2, PDint v3)
+{
+    SetValues(HashName(name), {(float) v1, (float) v2, (float) v3});
+}
+
+void SoftwareShader::SetInt4(const PDstring& name, PDint v1, PDint v2, PDint v3, PDint v4)
+{
+    SetValues(HashName(name), {(float) v1, (float) v2, (float) v3, (float) v4});
+}
+
+void SoftwareShader::SetIntArray(const PDstring& name, const PDint* value, PDsizei count)
+{
+    std::vector<float>& values = m_Uniforms[HashName(name)];
+    values.assign(value, value + count);
+}
+
+void SoftwareShader::SetUInt1(const PDstring& name, PDuint v0)
+{
+    SetValues(HashName(name), {(float) v0});
+}
+
+void SoftwareShader::SetUInt2(const PDstring& name, PDuint v1, PDuint v2)
+{
+    SetValues(HashName(name), {(float) v1, (float) v2});
+}
+
+void SoftwareShader::SetUInt3(const PDstring& name, PDuint v1, PDuint v2, PDuint v3)
+{
+    SetValues(HashName(name), {(float) v1, (float) v2, (float) v3});
+}
+
+void SoftwareShader::SetUInt4(const PDstring& name, PDuint v1, PDuint v2, PDuint v3, PDuint v4)
+{
+    SetValues(HashName(name), {(float) v1, (float) v2, (float) v3, (float) v4});
+}
+
+void SoftwareShader::SetFloat1(const PDstring& name, PDfloat v0)
+{
+    SetValues(HashName(name), {v0});
+}
+
+void SoftwareShader::SetFloat2(const PDstring& name, PDfloat v0, PDfloat v1)
+{
+    SetValues(HashName(name), {v0, v1});
+}
+
+void SoftwareShader::SetFloat3(const PDstring& name, PDfloat v0, PDfloat v1, PDfloat v2)
+{
+    SetValues(HashName(name), {v0, v1, v2});
+}
+
+void SoftwareShader::SetFloat4(const PDstring& name, PDfloat v0, PDfloat v1, PDfloat v2, PDfloat v3)
+{
+    SetValues(HashName(name), {v0, v1, v2, v3});
+}
+
+void SoftwareShader::SetMat4(const PDstring& name, PDsizei count, const glm::mat4* value, bool transpose)
+{
+    SetMat4(UniformId(name.c_str(), name.size()), count, value, transpose);
+}
+
+// ==============================================
+// Setters by ID
+// ==============================================
+
+void SoftwareShader::SetInt1(UniformId id, PDint v0)
+{
+    SetValues(id.GetHash(), {(float) v0});
+}
+
+void SoftwareShader::SetInt2(UniformId id, PDint v1, PDint v2)
+{
+    SetValues(id.GetHash(), {(float) v1, (float) v2});
+}
+
+void SoftwareShader::SetInt3(UniformId id, PDint v1, PDint v2, PDint v3)
+{
+    SetValues(id.GetHash(), {(float) v1, (float) v2, (float) v3});
+}
+
+void SoftwareShader::SetInt4(UniformId id, PDint v1, PDint v2, PDint v3, PDint v4)
+{
+    SetValues(id.GetHash(), {(float) v1, (float) v2, (float) v3, (float) v4});
+}
+
+void SoftwareShader::SetIntArray(UniformId id, const PDint* value, PDsizei count)
+{
+    std::vector<float>& values = m_Uniforms[id.GetHash()];
+    values.assign(value, value + count);
+}
+
+void SoftwareShader::SetUInt1(UniformId id, PDuint v0)
+{
+    SetValues(id.GetHash(), {(float) v0});
+}
+
+void SoftwareShader::SetUInt2(UniformId id, PDuint v1, PDuint v2)
+{
+    SetValues(id.GetHash(), {(float) v1, (float) v2});
+}
+
+void SoftwareShader::SetUInt3(UniformId id, PDuint v1, PDuint v2, PDuint v3)
+{
+    SetValues(id.GetHash(), {(float) v1, (float) v2, (float) v3});
+}
+
+void SoftwareShader::SetUInt4(UniformId id, PDuint v1, PDuint v2, PDuint v3, PDuint v4)
+{
+    SetValues(id.GetHash(), {(float) v1, (float) v2, (float) v3, (float) v4});
+}
+
+void SoftwareShader::SetFloat1(UniformId id, PDfloat v0)
+{
+    SetValues(id.GetHash(), {v0});
+}
+
+void SoftwareShader::SetFloat2(UniformId id, PDfloat v0, PDfloat v1)
+{
+    SetValues(id.GetHash(), {v0, v1});
+}
+
+void SoftwareShader::SetFloat3(UniformId id, PDfloat v0, PDfloat v1, PDfloat v2)
+{
+    SetValues(id.GetHash(), {v0, v1, v2});
+}
+
+void SoftwareShader::SetFloat4(UniformId id, PDfloat v0, PDfloat v1, PDfloat v2, PDfloat v3)
+{
+    SetValues(id.GetHash(), {v0, v1, v2, v3});
+}
+
+void SoftwareShader::SetMat4(UniformId id, PDsizei count, const glm::mat4* value, bool transpose)
+{
+    // Stored column-major, like glm
+    std::vector<float>& values = m_Uniforms[id.GetHash()];
+    values.resize(count * 16);
+    for (PDsizei i = 0; i < count; ++i)
+    {
+        for (PDuint col = 0; col < 4; ++col)
+        {
+            for (PDuint row = 0; row < 4; ++row)
+            {
+                values[i * 16 + col * 4 + row] = transpose ? value[i][row][col] : value[i][col][row];
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,88 @@
+#ifndef DEWPSI_SOFTWARESHADER_H
+#define DEWPSI_SOFTWARESHADER_H
+
+#include "Dewpsi_Core.h"
+#include "Dewpsi_Shader.h"
+#include <unordered_map>
+#include <vector>
+
+namespace Dewpsi {
+    /*
+    Shader of the software API. GLSL is not interpreted: every shader runs the same built-in
+    program, which covers the flat color, vertex color and textured shaders of the engine and the
+    sandbox. What it does depends on the attributes of the vertex layout and the uniforms set:
+
+        color    = u_Color * in_Color * texture(slot, in_TexCoord * in_Tiling)
+        position = u_ViewProjection * u_Transform * in_Transform * (in_Position * in_Scale + in_Offset)
+
+    Attributes may be prefixed with "in_" or "a_"; missing attributes and uniforms drop out of the
+    products. The texture is only sampled if the sources declare a sampler2D. The slot is
+    u_Textures[in_TexIndex] if the layout has in_TexIndex, and u_Texture otherwise. Without a
+    u_ViewProjection uniform, the matrix is read from the uniform buffer at binding 0, where the
+    renderer keeps its camera.
+    */
+    class SoftwareShader : public Shader {
+    public:
+        SoftwareShader(const PDstring& vertSrc, const PDstring& fragSrc);
+        explicit SoftwareShader(const PDstring& file);
+        virtual ~SoftwareShader();
+
+        virtual bool Bind() const override;
+        virtual void UnBind() const override {}
+        virtual bool IsReady() const override {return true;}
+        virtual PDuint GetRendererID() const override {return m_ShaderID;}
+
+        virtual void SetInt1(const PDstring& name, PDint v0) override;
+        virtual void SetInt2(const PDstring& name, PDint v1, PDint v2) override;
+        virtual void SetInt3(const PDstring& name, PDint v1, PDint v2, PDint v3) override;
+        virtual void SetInt4(const PDstring& name, PDint v1, PDint v2, PDint v3, PDint v4) override;
+        virtual void SetIntArray(const PDstring& name, const PDint* value, PDsizei count) override;
+
+        virtual void SetUInt1(const PDstring& name, PDuint v0) override;
+        virtual void SetUInt2(const PDstring& name, PDuint v1, PDuint v2) override;
+        virtual void SetUInt3(const PDstring& name, PDuint v1, PDuint v2, PDuint v3) override;
+        virtual void SetUInt4(const PDstring& name, PDuint v1, PDuint v2, PDuint v3, PDuint v4) override;
+
+        virtual void SetFloat1(const PDstring& name, PDfloat v0) override;
+        virtual void SetFloat2(const PDstring& name, PDfloat v0, PDfloat v1) override;
+        virtual void SetFloat3(const PDstring& name, PDfloat v0, PDfloat v1, PDfloat v2) override;
+        virtual void SetFloat4(const PDstring& name, PDfloat v0, PDfloat v1, PDfloat v2, PDfloat v3) override;
+
+        virtual void SetMat4(const PDstring& name, PDsizei count, const glm::mat4* value,
+            bool transpose = false) override;
+
+        virtual void SetInt1(UniformId id, PDint v0) override;
+        virtual void SetInt2(UniformId id, PDint v1, PDint v2) override;
+        virtual void SetInt3(UniformId id, PDint v1, PDint v2, PDint v3) override;
+        virtual void SetInt4(UniformId id, PDint v1, PDint v2, PDint v3, PDint v4) override;
+        virtual void SetIntArray(UniformId id, const PDint* value, PDsizei count) override;
+
+        virtual void SetUInt1(UniformId id, PDuint v0) override;
+        virtual void SetUInt2(UniformId id, PDuint v1, PDuint v2) override;
+        virtual void SetUInt3(UniformId id, PDuint v1, PDuint v2, PDuint v3) override;
+        virtual void SetUInt4(UniformId id, PDuint v1, PDuint v2, PDuint v3, PDuint v4) override;
+
+        virtual void SetFloat1(UniformId id, PDfloat v0) override;
+        virtual void SetFloat2(UniformId id, PDfloat v0, PDfloat v1) override;
+        virtual void SetFloat3(UniformId id, PDfloat v0, PDfloat v1, PDfloat v2) override;
+        virtual void SetFloat4(UniformId id, PDfloat v0, PDfloat v1, PDfloat v2, PDfloat v3) override;
+
+        virtual void SetMat4(UniformId id, PDsizei count, const glm::mat4* value,
+            bool transpose = false) override;
+
+        /// Returns the values of a uniform, or NULL if it was never set.
+        const std::vector<float>* GetUniform(UniformId id) const;
+
+        /// Returns true if the sources sample a texture.
+        bool IsTextured() const {return m_Textured;}
+
+    private:
+        void SetValues(PDuint32 hash, std::initializer_list<float> values);
+
+        std::unordered_map<PDuint32, std::vector<float>> m_Uniforms;
+        PDuint32 m_ShaderID;
+        bool m_Textured;
+    };
+}
+
+#endif /* DEWPSI_SOFTWARESHADER_H */
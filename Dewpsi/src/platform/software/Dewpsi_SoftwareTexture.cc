@@ -0,0 +1,94 @@
+#include "Dewpsi_SoftwareTexture.h"
+#include "Dewpsi_SoftwareRendererAPI.h"
+#include "Dewpsi_Log.h"
+#include <algorithm>
+#include <cstring>
+
+#define RESET_ERROR() m_IsError = false;
+
+namespace Dewpsi {
+
+// IDs only need to be distinct, for sort keys
+static PDuint32 _NextID = 1;
+
+SoftwareTexture2D::SoftwareTexture2D(const PDstring& file, const TextureProperties& props)
+    : m_Pixels(CreateRef<std::vector<PDuint32>>()), m_TextureID(_NextID++), m_Width(0), m_Height(0),
+      m_Properties(props)
+{
+    RESET_ERROR();
+
+    // Bottom row first, like the OpenGL API; RGB files are expanded to RGBA
+    int iWidth, iHeight, iChannels;
+    stbi_set_flip_vertically_on_load(1);
+    PDuchar* ucpBuffer = stbi_load(file.c_str(), &iWidth, &iHeight, &iChannels, 4);
+    if (! ucpBuffer)
+    {
+        SetError("Failed to read %s", file.c_str());
+        m_IsError = true;
+        return;
+    }
+
+    m_Width = (PDuint) iWidth;
+    m_Height = (PDuint) iHeight;
+    m_Pixels->resize((PDsizei) m_Width * m_Height);
+    std::memcpy(m_Pixels->data(), ucpBuffer, m_Pixels->size() * 4);
+    stbi_image_free(ucpBuffer);
+}
+
+SoftwareTexture2D::SoftwareTexture2D(PDuint width, PDuint height, const TextureProperties& props)
+    : m_Pixels(CreateRef<std::vector<PDuint32>>((PDsizei) width * height)), m_TextureID(_NextID++),
+      m_Width(width), m_Height(height), m_Properties(props)
+{
+    RESET_ERROR();
+}
+
+SoftwareTexture2D::~SoftwareTexture2D()
+{
+    SoftwareRendererAPI::ForgetTexture(this);
+}
+
+void SoftwareTexture2D::Bind(PDuint slot) const
+{
+    SoftwareRendererAPI::BindTexture(slot, this);
+}
+
+const PDuchar* SoftwareTexture2D::GetData() const
+{
+    return reinterpret_cast<const PDuchar*>(m_Pixels->data());
+}
+
+std::vector<PDuint32>& SoftwareTexture2D::GetWritablePixels()
+{
+    // Draws that are not rasterized yet keep the old pixels
+    if (m_Pixels.use_count() > 1)
+        m_Pixels = CreateRef<std::vector<PDuint32>>(*m_Pixels);
+    return *m_Pixels;
+}
+
+void SoftwareTexture2D::SetData(const void* data, PDsizei size)
+{
+    PD_CORE_ASSERT(size == m_Width * m_Height * 4, "Data must cover the entire texture");
+    if (m_Pixels.use_count() > 1)
+        m_Pixels = CreateRef<std::vector<PDuint32>>((PDsizei) m_Width * m_Height);
+    std::memcpy(m_Pixels->data(), data, std::min(size, m_Pixels->size() * 4));
+}
+
+void SoftwareTexture2D::SetSubData(const void* data, PDuint x, PDuint y, PDuint width, PDuint height)
+{
+    PD_CORE_ASSERT(x + width <= m_Width && y + height <= m_Height, "Rectangle is outside the texture");
+
+    std::vector<PDuint32>& pixels = GetWritablePixels();
+    const PDuint32* uipSource = static_cast<const PDuint32*>(data);
+    for (PDuint row = 0; row < height; ++row)
+    {
+        std::memcpy(pixels.data() + (PDsizei) (y + row) * m_Width + x, uipSource + (PDsizei) row * width,
+            width * sizeof(PDuint32));
+    }
+}
+
+SoftwareImage SoftwareTexture2D::GetImage() const
+{
+    return {m_Pixels, m_Width, m_Height, m_Properties.magFilter != TextureFilter::Nearest};
+}
+
+}
@@ -0,0 +1,50 @@
+#ifndef DEWPSI_SOFTWARETEXTURE_H
+#define DEWPSI_SOFTWARETEXTURE_H
+
+#include "Dewpsi_Core.h"
+#include "Dewpsi_Texture.h"
+#include "Dewpsi_SoftwareRasterizer.h"
+
+namespace Dewpsi {
+    /*
+    Texture of the software API, kept as RGBA8 pixels in system memory. Only the base level exists
+    and is sampled with the magnification filter, repeating at the edges. Draws keep a reference to
+    the pixels they sample, so changing a texture that queued triangles still read copies the
+    pixels instead of waiting for the rasterizer.
+    */
+    class SoftwareTexture2D : public Texture2D {
+    public:
+        SoftwareTexture2D() = delete;
+        explicit SoftwareTexture2D(const PDstring& file, const TextureProperties& props = {});
+        SoftwareTexture2D(PDuint width, PDuint height, const TextureProperties& props = {});
+        virtual ~SoftwareTexture2D();
+
+        virtual void Bind(PDuint slot) const override;
+        virtual void UnBind() const override {}
+        virtual PDuint GetWidth() const override {return m_Width;}
+        virtual PDuint GetHeight() const override {return m_Height;}
+        virtual const PDuchar* GetData() const override;
+        virtual void SetData(const void* data, PDsizei size) override;
+        virtual void SetSubData(const void* data, PDuint x, PDuint y, PDuint width, PDuint height) override;
+        virtual void GenerateMipmaps() override {}
+        virtual PDuint GetMipLevelCount() const override {return 1;}
+        virtual const TextureProperties& GetProperties() const override {return m_Properties;}
+        virtual PDsizei GetMemorySize() const override {return (PDsizei) m_Width * m_Height * 4;}
+        virtual PDuint GetRendererID() const override {return m_TextureID;}
+        virtual bool IsLoaded() const override {return true;}
+
+        /// Returns the pixels as the rasterizer samples them.
+        SoftwareImage GetImage() const;
+
+    private:
+        std::vector<PDuint32>& GetWritablePixels();
+
+        Ref<std::vector<PDuint32>> m_Pixels;
+        PDuint32 m_TextureID;
+        PDuint m_Width;
+        PDuint m_Height;
+        TextureProperties m_Properties;
+    };
+}
+
+#endif /* DEWPSI_SOFTWARETEXTURE_H */
@@ -0,0 +1,30 @@
+#include "Dewpsi_SoftwareUniformBuffer.h"
+#include "Dewpsi_SoftwareRendererAPI.h"
+#include "Dewpsi_Log.h"
+#include <cstring>
+
+namespace Dewpsi {
+
+SoftwareUniformBuffer::SoftwareUniformBuffer(PDsizei size, PDuint binding)
+    : m_Data(size), m_Binding(binding)
+{
+}
+
+SoftwareUniformBuffer::~SoftwareUniformBuffer()
+{
+    SoftwareRendererAPI::ForgetUniformBuffer(this);
+}
+
+void SoftwareUniformBuffer::Bind() const
+{
+    SoftwareRendererAPI::BindUniformBuffer(this);
+}
+
+void SoftwareUniformBuffer::SetData(const void* data, PDsizei size, PDsizei offset)
+{
+    PD_CORE_ASSERT(offset + size <= m_Data.size(), "Write goes past the end of the uniform buffer");
+    if (offset + size <= m_Data.size())
+        std::memcpy(m_Data.data() + offset, data, size);
+}
+
+}
@@ -0,0 +1,26 @@
+#ifndef DEWPSI_SOFTWAREUNIFORMBUFFER_H
+#define DEWPSI_SOFTWAREUNIFORMBUFFER_H
+
+#include <Dewpsi_UniformBuffer.h>
+#include <vector>
+
+namespace Dewpsi {
+    class SoftwareUniformBuffer : public UniformBuffer {
+    public:
+        SoftwareUniformBuffer(PDsizei size, PDuint binding);
+        virtual ~SoftwareUniformBuffer();
+
+        virtual void Bind() const override;
+        virtual void SetData(const void* data, PDsizei size, PDsizei offset = 0) override;
+        virtual PDuint GetBinding() const override {return m_Binding;}
+
+        const PDuchar* GetData() const {return m_Data.data();}
+        PDsizei GetSize() const {return m_Data.size();}
+
+    private:
+        std::vector<PDuchar> m_Data;
+        PDuint m_Binding;
+    };
+}
+
+#endif /* DEWPSI_SOFTWAREUNIFORMBUFFER_H */
@@ -0,0 +1,31 @@
+#include "Dewpsi_SoftwareVertexArray.h"
+#include "Dewpsi_Log.h"
+
+namespace Dewpsi {
+
+// IDs only need to be distinct, for sort keys
+static PDuint32 _NextID = 1;
+
+SoftwareVertexArray::SoftwareVertexArray() : m_ArrayID(_NextID++)
+{
+}
+
+void SoftwareVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
+{
+    PD_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "No layout defined");
+
+    const SoftwareBufferStorage* storage = dynamic_cast<const SoftwareBufferStorage*>(vertexBuffer.get());
+    PD_CORE_ASSERT(storage, "Vertex buffer was not created by the software API");
+    if (! storage)
+        return;
+
+    m_VertexBuffers.push_back(vertexBuffer);
+    m_Storage.push_back(storage);
+}
+
+void SoftwareVertexArray::SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer)
+{
+    m_IndexBuffer = indexBuffer;
+}
+
+}
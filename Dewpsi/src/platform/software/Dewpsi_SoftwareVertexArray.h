@@ -0,0 +1,41 @@
+#ifndef DEWPSI_SOFTWAREVERTEXARRAY_H
+#define DEWPSI_SOFTWAREVERTEXARRAY_H
+
+#include <Dewpsi_VertexArray.h>
+#include <Dewpsi_SoftwareBuffer.h>
+
+namespace Dewpsi {
+    class SoftwareVertexArray : public VertexArray {
+    public:
+        SoftwareVertexArray();
+        virtual ~SoftwareVertexArray() = default;
+
+        virtual void Bind() const override {}
+        virtual void UnBind() const override {}
+        virtual void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) override;
+        virtual void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) override;
+        virtual const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const override
+        {
+            return m_VertexBuffers;
+        }
+        virtual const Ref<IndexBuffer>& GetIndexBuffer() const override
+        {
+            return m_IndexBuffer;
+        }
+        virtual PDuint GetRendererID() const override
+        {
+            return m_ArrayID;
+        }
+
+        /// Returns the storage of every vertex buffer, in the order of GetVertexBuffers().
+        const std::vector<const SoftwareBufferStorage*>& GetStorage() const {return m_Storage;}
+
+    private:
+        PDuint32 m_ArrayID;
+        std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+        std::vector<const SoftwareBufferStorage*> m_Storage;
+        Ref<IndexBuffer> m_IndexBuffer;
+    };
+}
+
+#endif /* DEWPSI_SOFTWAREVERTEXARRAY_H */
@@ -1,7 +1,9 @@
 #type vertex
 #version 430 core
 layout(location = 0) in vec2 in_Position;
-uniform mat4 u_ViewProjection;
+layout(std140, binding = 0) uniform Camera {
+    mat4 u_ViewProjection;
+};
 uniform mat4 u_Transform;
 
 void main() {
@@ -2,7 +2,9 @@
 #version 430 core
 layout(location = 0) in vec2 in_Position;
 layout(location = 1) in vec2 in_TexCoord;
-uniform mat4 u_ViewProjection;
+layout(std140, binding = 0) uniform Camera {
+    mat4 u_ViewProjection;
+};
 uniform mat4 u_Transform;
 out vec2 v_TexCoord;
 
@@ -16,7 +16,9 @@ static const char* VertexShaderOpenGL[2] = {
     R"(
         #version 430 core
         layout(location = 0) in vec2 in_Position;
-        uniform mat4 u_ViewProjection;
+        layout(std140, binding = 0) uniform Camera {
+            mat4 u_ViewProjection;
+        };
         uniform mat4 u_Transform;
 
         void main() {
@@ -27,7 +29,9 @@ static const char* VertexShaderOpenGL[2] = {
         #version 430 core
         layout(location = 0) in vec2 in_Position;
         layout(location = 1) in vec2 in_TexCoord;
-        uniform mat4 u_ViewProjection;
+        layout(std140, binding = 0) uniform Camera {
+            mat4 u_ViewProjection;
+        };
         uniform mat4 u_Transform;
         out vec2 v_TexCoord;
 
@@ -210,15 +214,11 @@ void SandboxLayer::OnUpdate(Dewpsi::Timestep delta)
     // Draw solid-color square
     Renderer::Submit(m_ColorShader, m_ColoredQuad->vao, m_ColoredQuad->Transform());
 
-    // Bind texture and draw it
-    m_Texture1->Bind(0);
-    m_TextureShader->SetInt1("u_Texture", 0);
-    Renderer::Submit(m_TextureShader, m_TexturedQuad->vao, m_TexturedQuad->Transform());
+    // Draw textured square
+    Renderer::Submit(m_TextureShader, m_TexturedQuad->vao, m_Texture1, 0, m_TexturedQuad->Transform());
 
-    // Bind other texture and draw it
-    m_Texture2->Bind(1);
-    m_TextureShader->SetInt1("u_Texture", 1);
-    Renderer::Submit(m_TextureShader, m_TexturedQuad->vao,
+    // Draw other textured square
+    Renderer::Submit(m_TextureShader, m_TexturedQuad->vao, m_Texture2, 1,
         m_TexturedQuad->Transform(glm::vec3(0.5f, -0.5f, 0.0f)));
 
     Renderer::EndScene();
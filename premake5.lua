@@ -121,6 +121,8 @@ project "dewpsi"
         (srcdir .. "/ImGui/imguibuild.cpp"),
         (srcdir .. "/Renderer/*.cc"),
         (srcdir .. "/os/*.cc"),
+        (srcdir .. "/platform/null/*.cc"),
+        (srcdir .. "/platform/software/*.cc"),
 
         (srcdir .. "/*.h"),
         (srcdir .. "/debug/*.h"),
@@ -129,6 +131,8 @@ project "dewpsi"
         (srcdir .. "/matrices/*.h"),
         (srcdir .. "/Renderer/*.h"),
         (srcdir .. "/os/*.h"),
+        (srcdir .. "/platform/null/*.h"),
+        (srcdir .. "/platform/software/*.h"),
     }
     pchheader "pdpch.h"
     pchsource "Dewpsi/src/pdpch.cpp"
@@ -150,6 +154,8 @@ project "dewpsi"
         (srcdir .. "/events"),
         (srcdir .. "/ImGui"),
         (srcdir .. "/os"),
+        (srcdir .. "/platform/null"),
+        (srcdir .. "/platform/software"),
         (srcdir .. "/Renderer"),
         (srcdir .. "/Utility")
     }
@@ -170,6 +176,8 @@ project "dewpsi"
         ("{COPY} " .. srcdir .. "/events/*.h ../Sandbox/src/dewpsi-include"),
         ("{COPY} " .. srcdir .. "/ImGui/*.h  ../Sandbox/src/dewpsi-include"),
         ("{COPY} " .. srcdir .. "/os/*.h  ../Sandbox/src/dewpsi-include"),
+        ("{COPY} " .. srcdir .. "/platform/null/*.h  ../Sandbox/src/dewpsi-include"),
+        ("{COPY} " .. srcdir .. "/platform/software/*.h  ../Sandbox/src/dewpsi-include"),
         ("{COPY} " .. srcdir .. "/bits/*  ../Sandbox/src/dewpsi-include/bits"),
         ("{COPY} " .. srcdir .. "/Renderer/Dewpsi_RenderContext.h ../Sandbox/src/dewpsi-include"),
 
@@ -0,0 +1,70 @@
+#include <Dewpsi_ParticleSystem.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+// Simulates a full emitter at 60 updates per second and reports how many particles are updated per millisecond
+
+typedef std::chrono::steady_clock Clock;
+
+static double ElapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main(int argc, const char* argv[])
+{
+    const PDuint32 uiParticles = (argc > 1) ? (PDuint32) std::atoi(argv[1]) : 100000;
+    const int iFrames = (argc > 2) ? std::atoi(argv[2]) : 1000;
+    const float fStep = 1.0f / 60.0f;
+    if (! uiParticles || iFrames < 1)
+    {
+        std::cerr << "usage: " << argv[0] << " [particles > 0] [frames > 0]" << std::endl;
+        return 1;
+    }
+
+    Dewpsi::ParticleProps props;
+    props.velocity = {0.0f, 1.0f};
+    props.velocityVariation = {2.0f, 2.0f};
+    props.colorBegin = {1.0f, 0.5f, 0.0f, 1.0f};
+    props.sizeBegin = 0.2f;
+    props.sizeVariation = 0.1f;
+    props.lifeTime = 2.0f;
+
+    Dewpsi::ParticleSystem particles(uiParticles);
+    particles.SetGravity({0.0f, -9.8f});
+    std::vector<Dewpsi::ParticleSystem::Instance> instances(uiParticles);
+
+    // Spread the births over one life time, so particles die and get replaced every frame
+    const PDuint32 uiPerFrame = (PDuint32) (uiParticles * fStep / props.lifeTime) + 1;
+    for (int i = 0; i < (int) (props.lifeTime / fStep); ++i)
+    {
+        particles.Emit(props, uiPerFrame);
+        particles.OnUpdate(fStep);
+    }
+
+    double dUpdateMs = 0.0, dWriteMs = 0.0;
+    PDuint64 ulUpdated = 0;
+    for (int i = 0; i < iFrames; ++i)
+    {
+        particles.Emit(props, uiPerFrame);
+        ulUpdated += particles.GetCount();
+
+        Clock::time_point start = Clock::now();
+        particles.OnUpdate(fStep);
+        dUpdateMs += ElapsedMs(start);
+
+        start = Clock::now();
+        particles.WriteInstances(instances.data());
+        dWriteMs += ElapsedMs(start);
+    }
+
+    std::cout << "particle system benchmark (" << Dewpsi::ParticleSystem::GetInstructionSet() << ")\n"
+        << "  average live particles:  " << ulUpdated / iFrames << '\n'
+        << "  update:                  " << ulUpdated / std::max(dUpdateMs, 1e-6) << " particles/ms\n"
+        << "  instance write:          " << ulUpdated / std::max(dWriteMs, 1e-6) << " particles/ms\n"
+        << "  update + write per frame: " << (dUpdateMs + dWriteMs) / iFrames << " ms" << std::endl;
+
+    return 0;
+}
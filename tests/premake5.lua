@@ -70,3 +70,25 @@ filter "configurations:Debug"
 filter "configurations:Release"
     optimize "On"
     runtime "Release"
+
+project "particlebench"
+    kind "ConsoleApp"
+    language "C++"
+    files {
+        "particlebench_*.cc"
+    }
+    includedirs {
+        "%{IncludeDir.dewpsiroot}/Renderer",
+        "%{IncludeDir.dewpsiroot}/Utility",
+        "../Dewpsi/vendor/glm"
+    }
+    defines {
+        "PD_PLATFORM_LINUX"
+    }
+    links {
+        "dewpsi",
+        "spdlog"
+    }
+    cppdialect "C++17"
+    flags "MultiProcessorCompile"
+    optimize "On"